@@ -0,0 +1,128 @@
+// -*-c++-*-
+
+/*!
+  \file color_table.cpp
+  \brief shared color name table Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "color_table.h"
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ColorTable::ColorTable()
+{
+    M_names.push_back( std::string() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ColorTable &
+ColorTable::instance()
+{
+    static ColorTable s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ColorTable::ID
+ColorTable::intern( const char * name )
+{
+    if ( ! name
+         || *name == '\0' )
+    {
+        return NONE;
+    }
+
+    return intern( std::string( name ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ColorTable::ID
+ColorTable::intern( const std::string & name )
+{
+    if ( name.empty() )
+    {
+        return NONE;
+    }
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    std::unordered_map< std::string, ID >::const_iterator it = M_ids.find( name );
+    if ( it != M_ids.end() )
+    {
+        return it->second;
+    }
+
+    const ID id = static_cast< ID >( M_names.size() );
+    M_names.push_back( name );
+    M_ids.insert( std::make_pair( name, id ) );
+
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::string
+ColorTable::name( const ID id ) const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    if ( id >= M_names.size() )
+    {
+        return std::string();
+    }
+
+    return M_names[id];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+ColorTable::size() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    return M_names.size();
+}
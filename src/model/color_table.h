@@ -0,0 +1,96 @@
+// -*-c++-*-
+
+/*!
+  \file color_table.h
+  \brief shared color name table Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_COLOR_TABLE_H
+#define SOCCERWINDOW2_MODEL_COLOR_TABLE_H
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+  \class ColorTable
+  \brief interning table of the color strings in the debug logs and the draw data.
+
+  The parsers register each color string once and keep only its id.
+  The painters map the id to a pen and a brush resolved on the first use,
+  so the same color name is never converted twice. The id 0 is reserved
+  for the empty string. Registered names are never removed.
+*/
+class ColorTable {
+public:
+
+    typedef std::uint32_t ID;
+
+    //! id of the empty string
+    static constexpr ID NONE = 0;
+
+private:
+
+    mutable std::mutex M_mutex;
+
+    std::unordered_map< std::string, ID > M_ids;
+    std::deque< std::string > M_names; //!< indexed by the id
+
+    //! private for singleton
+    ColorTable();
+
+    // not used
+    ColorTable( const ColorTable & ) = delete;
+    ColorTable & operator=( const ColorTable & ) = delete;
+
+public:
+
+    static
+    ColorTable & instance();
+
+    /*!
+      \brief get the id of the color string. thread safe.
+      \param name color name or "#rrggbb" style string
+      \return registered id. NONE if the string is empty.
+     */
+    ID intern( const char * name );
+    ID intern( const std::string & name );
+
+    /*!
+      \brief get the color string of the id. thread safe.
+      \return the registered string. empty string if the id is not registered.
+     */
+    std::string name( const ID id ) const;
+
+    //! the number of registered ids including NONE. thread safe.
+    std::size_t size() const;
+};
+
+#endif
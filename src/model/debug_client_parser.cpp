@@ -37,6 +37,8 @@
 #include "view_holder.h"
 
 #include <iostream>
+#include <map>
+#include <string>
 #include <cstring>
 #include <cctype>
 #include <climits>
@@ -92,6 +94,7 @@ DebugClientParser::parse( const char * msg,
     M_side = 'n';
     M_unum = 0;
     M_time.assign( -1, 0 );
+    M_string_pool = &holder.debugStringPool();
 
     int	version = 0;
     int	n_read = 0;
@@ -129,6 +132,8 @@ DebugClientParser::parse( const char * msg,
         holder.addDebugView( M_time, M_side, M_unum, ptr );
     }
 
+    M_string_pool = nullptr;
+
     return result;
 }
 
@@ -470,10 +475,7 @@ DebugClientParser::parseBall( const char * tok,
                       static_cast< float >( vy ) );
     }
 
-    if ( comment[0] != '\0' )
-    {
-        ball->comment_.assign( comment );
-    }
+    ball->comment_ = M_string_pool->intern( comment );
 
     debug_view->setBall( ball );
 
@@ -603,7 +605,7 @@ DebugClientParser::parseSelf( const char * tok,
                                                                             static_cast< float >( vy ),
                                                                             static_cast< float >( body ),
                                                                             static_cast< float >( neck ),
-                                                                            comment ) );
+                                                                            M_string_pool->intern( comment ) ) );
     debug_view->setSelf( self );
     return tok - start;
 }
@@ -715,7 +717,7 @@ DebugClientParser::parsePlayer( const char * tok,
                                                                                   static_cast< float >( y ),
                                                                                   body,
                                                                                   pointto,
-                                                                                  comment ) );
+                                                                                  M_string_pool->intern( comment ) ) );
 
     switch ( recog_type ) {
     case DebugViewData::TEAMMATE:
@@ -1057,7 +1059,7 @@ DebugClientParser::parseMessage( const char * tok,
     std::cerr << __FILE__ << ": (parseMessage) message = ["
               << message << "]" << std::endl;
 #endif
-    debug_view->setMessage( message );
+    debug_view->setMessage( M_string_pool->intern( message ) );
 
     //     if ( std::strstr( message, "Say[" ) != NULL )
     //     {
@@ -1091,7 +1093,7 @@ DebugClientParser::parseSayMessage( const char * tok,
         return 0;
     }
 
-    debug_view->setSayMessage( message );
+    debug_view->setSayMessage( M_string_pool->intern( message ) );
 
     return n_read;
 }
@@ -1111,6 +1113,8 @@ DebugClientParser::parseHearMessage( const char * tok,
     while ( *tok != '\0' && *tok == ' ' ) ++tok;
     while ( *tok != '\0' && *tok != ' ' && *tok != ')' ) ++tok;  // skip 'hear'
 
+    std::map< int, std::string > messages;
+
     while ( *tok != '\0' )
     {
         if ( *tok == ')' )
@@ -1133,12 +1137,19 @@ DebugClientParser::parseHearMessage( const char * tok,
         }
         tok += n_read;
 
-        debug_view->addHearMessage( unum, msg );
+        std::string & str = messages[unum];
+        str += ' ';
+        str += msg;
 
         while ( *tok != '\0' && *tok == ' ' ) ++tok;
     }
 
     while ( *tok != '\0' && *tok == ' ' ) ++tok;
 
+    for ( std::map< int, std::string >::const_reference v : messages )
+    {
+        debug_view->setHearMessage( v.first, M_string_pool->intern( v.second ) );
+    }
+
     return tok - start;
 }
@@ -36,6 +36,7 @@
 
 #include <rcsc/game_time.h>
 
+class StringPool;
 class ViewHolder;
 
 /*!
@@ -48,11 +49,14 @@ private:
     int M_unum; //!< sender's unum
     rcsc::GameTime M_time; //!< cycle of sent data
 
+    StringPool * M_string_pool; //!< comment/message interning table of the target holder
+
 public:
     DebugClientParser()
         : M_side( 'n' ),
           M_unum( 0 ),
-          M_time( -1, 0 )
+          M_time( -1, 0 ),
+          M_string_pool( nullptr )
       { }
 
     bool parse( const char * msg,
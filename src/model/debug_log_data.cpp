@@ -132,7 +132,7 @@ DebugLogData::addPoint( const std::int32_t level,
 
     if ( std::strlen( buf ) > 0 )
     {
-        point.color_ = buf;
+        point.color_ = ColorTable::instance().intern( buf );
     }
 
     point.level_ = level;
@@ -166,7 +166,7 @@ DebugLogData::addLine( const std::int32_t level,
 
     if ( std::strlen( buf ) > 0 )
     {
-        line.color_ = buf;
+        line.color_ = ColorTable::instance().intern( buf );
     }
 
     line.level_ = level;
@@ -201,7 +201,7 @@ DebugLogData::addArc( const std::int32_t level,
 
     if ( std::strlen( buf ) > 0 )
     {
-        arc.color_ = buf;
+        arc.color_ = ColorTable::instance().intern( buf );
     }
 
     arc.level_ = level;
@@ -235,7 +235,7 @@ DebugLogData::addCircle( const std::int32_t level,
 
     if ( std::strlen( buf ) > 0 )
     {
-        c.color_ = buf;
+        c.color_ = ColorTable::instance().intern( buf );
     }
 
     c.level_ = level;
@@ -278,7 +278,7 @@ DebugLogData::addTriangle( const std::int32_t level,
 
     if ( std::strlen( buf ) > 0 )
     {
-        t.color_ = buf;
+        t.color_ = ColorTable::instance().intern( buf );
     }
 
     t.level_ = level;
@@ -320,7 +320,7 @@ DebugLogData::addRect( const std::int32_t level,
 
     if ( std::strlen( buf ) > 0 )
     {
-        r.color_ = buf;
+        r.color_ = ColorTable::instance().intern( buf );
     }
 
     r.level_ = level;
@@ -362,7 +362,7 @@ DebugLogData::addSector( const std::int32_t level,
 
     if ( std::strlen( buf ) > 0 )
     {
-        sector.color_ = buf;
+        sector.color_ = ColorTable::instance().intern( buf );
     }
 
     sector.level_ = level;
@@ -412,7 +412,7 @@ DebugLogData::addMessage( const std::int32_t level,
             return false;
         }
 
-        mes.color_ = col;
+        mes.color_ = ColorTable::instance().intern( col );
 
         buf += 3 + n_read;
     }
@@ -32,6 +32,8 @@
 #ifndef SOCCERWINDOW2_DEBUG_LOG_DATA_H
 #define SOCCERWINDOW2_DEBUG_LOG_DATA_H
 
+#include "color_table.h"
+
 #include <rcsc/game_time.h>
 
 #include <string>
@@ -57,11 +59,12 @@ public:
         std::int32_t level_;
         double x_;
         double y_;
-        std::string color_;
+        ColorTable::ID color_;
         PointT()
             : level_( 0 ),
               x_( 0.0 ),
-              y_( 0.0 )
+              y_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
     struct LineT {
@@ -70,13 +73,14 @@ public:
         double y1_;
         double x2_;
         double y2_;
-        std::string color_;
+        ColorTable::ID color_;
         LineT()
             : level_( 0 ),
               x1_( 0.0 ),
               y1_( 0.0 ),
               x2_( 0.0 ),
-              y2_( 0.0 )
+              y2_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
     struct ArcT {
@@ -86,14 +90,15 @@ public:
         double r_;
         double start_angle_;
         double span_angle_;
-        std::string color_;
+        ColorTable::ID color_;
         ArcT()
             : level_( 0 ),
               x_( 0.0 ),
               y_( 0.0 ),
               r_( 0.0 ),
               start_angle_( 0.0 ),
-              span_angle_( 0.0 )
+              span_angle_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
     struct CircleT {
@@ -101,12 +106,13 @@ public:
         double x_;
         double y_;
         double r_;
-        std::string color_;
+        ColorTable::ID color_;
         CircleT()
             : level_( 0 ),
               x_( 0.0 ),
               y_( 0.0 ),
-              r_( 0.0 )
+              r_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
     struct TriangleT {
@@ -117,7 +123,7 @@ public:
         double y2_;
         double x3_;
         double y3_;
-        std::string color_;
+        ColorTable::ID color_;
         TriangleT()
             : level_( 0 ),
               x1_( 0.0 ),
@@ -125,7 +131,8 @@ public:
               x2_( 0.0 ),
               y2_( 0.0 ),
               x3_( 0.0 ),
-              y3_( 0.0 )
+              y3_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
     struct RectT {
@@ -134,13 +141,14 @@ public:
         double top_;
         double width_;
         double height_;
-        std::string color_;
+        ColorTable::ID color_;
         RectT()
             : level_( 0 ),
               left_( 0.0 ),
               top_( 0.0 ),
               width_( 0.0 ),
-              height_( 0.0 )
+              height_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
    struct SectorT {
@@ -151,7 +159,7 @@ public:
         double max_r_;
         double start_angle_;
         double span_angle_;
-        std::string color_;
+        ColorTable::ID color_;
         SectorT()
             : level_( 0 ),
               x_( 0.0 ),
@@ -159,7 +167,8 @@ public:
               min_r_( 0.0 ),
               max_r_( 0.0 ),
               start_angle_( 0.0 ),
-              span_angle_( 0.0 )
+              span_angle_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
     struct MessageT {
@@ -167,11 +176,12 @@ public:
         double x_;
         double y_;
         std::string message_;
-        std::string color_;
+        ColorTable::ID color_;
         MessageT()
             : level_( 0 ),
               x_( 0.0 ),
-              y_( 0.0 )
+              y_( 0.0 ),
+              color_( ColorTable::NONE )
           { }
     };
 
@@ -52,8 +52,9 @@ DebugViewData::clear()
     M_lines.clear();
     M_target_teammate = 0;
     M_target_point.reset();
-    M_message.erase();
-    M_say_message.erase();
+    M_message = PooledString();
+    M_say_message = PooledString();
+    M_hear_messages.clear();
 }
 
 /*-------------------------------------------------------------------*/
@@ -183,7 +184,7 @@ DebugViewData::print( std::ostream & os,
     if ( ! M_hear_messages.empty() )
     {
         os << " (hear";
-        for ( std::map< int, std::string >::const_reference v : M_hear_messages )
+        for ( std::map< int, PooledString >::const_reference v : M_hear_messages )
         {
             os << " (" << v.first << " \"" << v.second << "\")";
         }
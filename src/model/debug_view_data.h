@@ -32,6 +32,8 @@
 #ifndef SOCCERWINDOW2_DEBUG_VIEW_DATA_H
 #define SOCCERWINDOW2_DEBUG_VIEW_DATA_H
 
+#include "string_pool.h"
+
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/rcg/types.h>
 #include <rcsc/game_time.h>
@@ -67,7 +69,7 @@ public:
         rcsc::rcg::Int32 y_;
         rcsc::rcg::Int32 vx_;
         rcsc::rcg::Int32 vy_;
-        std::string comment_;
+        PooledString comment_;
 
         BallT( const float & x,
                const float & y )
@@ -99,7 +101,7 @@ public:
         rcsc::rcg::Int32 vy_;
         rcsc::rcg::Int16 body_;
         rcsc::rcg::Int16 neck_;
-        std::string comment_;
+        PooledString comment_;
 
         /*!
           \brief created by coach
@@ -129,7 +131,7 @@ public:
                const float vy,
                const float b,
                const float n,
-               const char * comment )
+               const PooledString & comment )
             : side_( side ),
               unum_( unum ),
               ptype_( ptype ),
@@ -157,7 +159,7 @@ public:
         rcsc::rcg::Int32 y_;
         rcsc::rcg::Int16 body_;
         rcsc::rcg::Int16 pointto_;
-        std::string comment_;
+        PooledString comment_;
 
         PlayerT( const rcsc::rcg::Int16 unum,
                  const rcsc::rcg::Int16 ptype,
@@ -165,7 +167,7 @@ public:
                  const float y,
                  const float body,
                  const float pointto,
-                 const char * comment )
+                 const PooledString & comment )
             : unum_( unum ),
               ptype_( ptype ),
               x_( static_cast< rcsc::rcg::Int32 >( rint( x * rcsc::rcg::SHOWINFO_SCALE2 ) ) ),
@@ -293,10 +295,10 @@ private:
 
     int M_target_teammate;
     std::shared_ptr< rcsc::Vector2D > M_target_point;
-    std::string M_message;
+    PooledString M_message;
 
-    std::string M_say_message;
-    std::map< int, std::string > M_hear_messages;
+    PooledString M_say_message;
+    std::map< int, PooledString > M_hear_messages;
 public:
     //! construct from rcg v3 data (this is only for rcg v3)
     DebugViewData()
@@ -375,20 +377,18 @@ public:
       {
           M_target_point = std::shared_ptr< rcsc::Vector2D >( new rcsc::Vector2D( x, y ) );
       }
-    void setMessage( const char * message )
+    void setMessage( const PooledString & message )
       {
-          M_message.assign( message );
+          M_message = message;
       }
-    void setSayMessage( const char * message )
+    void setSayMessage( const PooledString & message )
       {
-          M_say_message.assign( message );
+          M_say_message = message;
       }
-    void addHearMessage( const int unum,
-                         const char * message )
+    void setHearMessage( const int unum,
+                         const PooledString & message )
       {
-          std::string & msg = M_hear_messages[unum];
-          msg += ' ';
-          msg += message;
+          M_hear_messages[unum] = message;
       }
 
     const std::shared_ptr< BallT > & ball() const
@@ -445,15 +445,15 @@ public:
       {
           return M_target_point;
       }
-    const std::string & message() const
+    const PooledString & message() const
       {
           return M_message;
       }
-    const std::string & sayMessage() const
+    const PooledString & sayMessage() const
       {
           return M_say_message;
       }
-    const std::map< int, std::string > & hearMessages() const
+    const std::map< int, PooledString > & hearMessages() const
       {
           return M_hear_messages;
       }
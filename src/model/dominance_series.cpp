@@ -0,0 +1,330 @@
+// -*-c++-*-
+
+/*!
+  \file dominance_series.cpp
+  \brief dominated area time series Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "dominance_series.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
+namespace {
+
+//! the minimum number of view data analyzed by one thread
+const std::size_t MIN_CHUNK_SIZE = 256;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief clip the convex polygon by the half plane that is closer to site than to other.
+*/
+void
+clip_polygon( const std::vector< rcsc::Vector2D > & polygon,
+              const rcsc::Vector2D & site,
+              const rcsc::Vector2D & other,
+              std::vector< rcsc::Vector2D > & result )
+{
+    result.clear();
+
+    const rcsc::Vector2D normal = other - site;
+    const rcsc::Vector2D mid = ( site + other ) * 0.5;
+
+    const std::size_t n = polygon.size();
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const rcsc::Vector2D & p = polygon[i];
+        const rcsc::Vector2D & q = polygon[( i + 1 ) % n];
+
+        // negative value means the point is inside
+        const double dp = ( p - mid ).innerProduct( normal );
+        const double dq = ( q - mid ).innerProduct( normal );
+
+        if ( dp <= 0.0 )
+        {
+            result.push_back( p );
+        }
+
+        if ( ( dp < 0.0 && dq > 0.0 )
+             || ( dp > 0.0 && dq < 0.0 ) )
+        {
+            result.push_back( p + ( q - p ) * ( dp / ( dp - dq ) ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+polygon_area( const std::vector< rcsc::Vector2D > & polygon )
+{
+    double area = 0.0;
+
+    const std::size_t n = polygon.size();
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const rcsc::Vector2D & p = polygon[i];
+        const rcsc::Vector2D & q = polygon[( i + 1 ) % n];
+        area += p.x * q.y - q.x * p.y;
+    }
+
+    return std::fabs( area ) * 0.5;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DominanceSeries::DominanceSeries()
+    : M_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DominanceSeries::clear()
+{
+    M_front.reset();
+    M_size = 0;
+    M_areas.clear();
+    M_left_areas.clear();
+    M_right_areas.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DominanceSeries::update( const MonitorViewData::Cont & vc )
+{
+    if ( vc.empty() )
+    {
+        if ( M_size == 0 )
+        {
+            return false;
+        }
+        clear();
+        return true;
+    }
+
+    if ( M_front != vc.front()
+         || M_size > vc.size() )
+    {
+        clear();
+        M_front = vc.front();
+    }
+    else if ( M_size > 0 )
+    {
+        // the last view data may have been replaced in live mode.
+        --M_size;
+    }
+
+    const std::size_t first = M_size;
+    const std::size_t size = vc.size();
+
+    M_areas.resize( size * PLAYER_SIZE );
+    M_left_areas.resize( size );
+    M_right_areas.resize( size );
+
+    const std::size_t count = size - first;
+    const std::size_t thread_count = std::max( std::size_t( 1 ),
+                                               std::min( std::size_t( std::thread::hardware_concurrency() ),
+                                                         count / MIN_CHUNK_SIZE ) );
+    if ( thread_count <= 1 )
+    {
+        analyze( vc, first, size );
+    }
+    else
+    {
+        const std::size_t chunk = ( count + thread_count - 1 ) / thread_count;
+
+        std::vector< std::thread > threads;
+        threads.reserve( thread_count );
+
+        for ( std::size_t begin = first; begin < size; begin += chunk )
+        {
+            threads.emplace_back( &DominanceSeries::analyze, this,
+                                  std::cref( vc ), begin, std::min( begin + chunk, size ) );
+        }
+
+        for ( std::thread & t : threads )
+        {
+            t.join();
+        }
+    }
+
+    M_size = size;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  each thread writes only its own range [first, last).
+*/
+void
+DominanceSeries::analyze( const MonitorViewData::Cont & vc,
+                          const std::size_t first,
+                          const std::size_t last )
+{
+    for ( std::size_t i = first; i < last; ++i )
+    {
+        float * areas = &M_areas[i * PLAYER_SIZE];
+        compute_areas( *vc[i], areas );
+
+        const std::vector< rcsc::rcg::PlayerT > & players = vc[i]->players();
+
+        float left = 0.0f;
+        float right = 0.0f;
+        for ( std::size_t p = 0; p < PLAYER_SIZE && p < players.size(); ++p )
+        {
+            if ( players[p].side() == rcsc::LEFT ) left += areas[p];
+            else if ( players[p].side() == rcsc::RIGHT ) right += areas[p];
+        }
+
+        M_left_areas[i] = left;
+        M_right_areas[i] = right;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DominanceSeries::compute_areas( const MonitorViewData & view,
+                                float * areas )
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    const double half_length = SP.pitchHalfLength();
+    const double half_width = SP.pitchHalfWidth();
+
+    std::fill( areas, areas + PLAYER_SIZE, 0.0f );
+
+    const std::vector< rcsc::rcg::PlayerT > & players = view.players();
+    const std::size_t size = std::min( PLAYER_SIZE, players.size() );
+
+    rcsc::Vector2D sites[PLAYER_SIZE];
+    bool alive[PLAYER_SIZE];
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        alive[i] = players[i].isAlive();
+        sites[i].assign( players[i].x(), players[i].y() );
+    }
+
+    std::vector< rcsc::Vector2D > cell;
+    std::vector< rcsc::Vector2D > buf;
+    cell.reserve( 32 );
+    buf.reserve( 32 );
+
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        if ( ! alive[i] )
+        {
+            continue;
+        }
+
+        cell.clear();
+        cell.emplace_back( -half_length, -half_width );
+        cell.emplace_back( +half_length, -half_width );
+        cell.emplace_back( +half_length, +half_width );
+        cell.emplace_back( -half_length, +half_width );
+
+        for ( std::size_t j = 0; j < size && cell.size() >= 3; ++j )
+        {
+            if ( j == i
+                 || ! alive[j] )
+            {
+                continue;
+            }
+
+            if ( sites[i].equalsWeakly( sites[j] ) )
+            {
+                // the cell of the overlapped players is given to the first one.
+                if ( j < i )
+                {
+                    cell.clear();
+                }
+                continue;
+            }
+
+            clip_polygon( cell, sites[i], sites[j], buf );
+            cell.swap( buf );
+        }
+
+        if ( cell.size() >= 3 )
+        {
+            areas[i] = static_cast< float >( polygon_area( cell ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+DominanceSeries::printCSV( std::ostream & os,
+                           const MonitorViewData::Cont & vc ) const
+{
+    os << "cycle,stopped,left,right";
+    for ( std::size_t p = 0; p < PLAYER_SIZE; ++p )
+    {
+        os << ( p < PLAYER_SIZE / 2 ? ",l" : ",r" ) << ( p % ( PLAYER_SIZE / 2 ) ) + 1;
+    }
+    os << '\n';
+
+    const std::size_t size = std::min( M_size, vc.size() );
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        os << vc[i]->time().cycle() << ',' << vc[i]->time().stopped()
+           << ',' << M_left_areas[i] << ',' << M_right_areas[i];
+        for ( std::size_t p = 0; p < PLAYER_SIZE; ++p )
+        {
+            os << ',' << M_areas[i * PLAYER_SIZE + p];
+        }
+        os << '\n';
+    }
+
+    return os;
+}
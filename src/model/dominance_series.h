@@ -0,0 +1,135 @@
+// -*-c++-*-
+
+/*!
+  \file dominance_series.h
+  \brief dominated area time series Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_DOMINANCE_SERIES_H
+#define SOCCERWINDOW2_MODEL_DOMINANCE_SERIES_H
+
+#include "monitor_view_data.h"
+
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+/*!
+  \class DominanceSeries
+  \brief the area of the Voronoi cell of each player in all view data.
+
+  The cells are generated from all alive players of both teams and are
+  clipped by the pitch, so the sum of a team's areas is the area dominated
+  by the team. The areas are stored as float values in one flat array.
+  The new view data are analyzed by several threads, and the series is
+  extended incrementally while the live log grows.
+*/
+class DominanceSeries {
+public:
+
+    //! the number of areas stored for each view data
+    static constexpr std::size_t PLAYER_SIZE = 22;
+
+private:
+
+    //! the first view data when the series was built. used to detect the data replacement.
+    MonitorViewData::ConstPtr M_front;
+
+    //! the number of analyzed view data
+    std::size_t M_size;
+
+    //! area of each player. [view index * PLAYER_SIZE + player index]
+    std::vector< float > M_areas;
+
+    //! the sum of the left team's areas in each view data
+    std::vector< float > M_left_areas;
+
+    //! the sum of the right team's areas in each view data
+    std::vector< float > M_right_areas;
+
+    // not used
+    DominanceSeries( const DominanceSeries & ) = delete;
+    DominanceSeries & operator=( const DominanceSeries & ) = delete;
+
+public:
+
+    DominanceSeries();
+
+    void clear();
+
+    /*!
+      \brief analyze the view data that are not analyzed yet.
+      \param vc view data container
+      \return true if the series is changed.
+     */
+    bool update( const MonitorViewData::Cont & vc );
+
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    float playerArea( const std::size_t index,
+                      const std::size_t player ) const
+      {
+          return M_areas[index * PLAYER_SIZE + player];
+      }
+
+    float leftArea( const std::size_t index ) const
+      {
+          return M_left_areas[index];
+      }
+
+    float rightArea( const std::size_t index ) const
+      {
+          return M_right_areas[index];
+      }
+
+    /*!
+      \brief write the series as CSV. one line for each view data.
+      \param vc view data container used in the last update()
+     */
+    std::ostream & printCSV( std::ostream & os,
+                             const MonitorViewData::Cont & vc ) const;
+
+    /*!
+      \brief compute the area of each player's cell clipped by the pitch.
+      \param view view data
+      \param areas output array. the size must be PLAYER_SIZE.
+     */
+    static
+    void compute_areas( const MonitorViewData & view,
+                        float * areas );
+
+private:
+
+    void analyze( const MonitorViewData::Cont & vc,
+                  const std::size_t first,
+                  const std::size_t last );
+};
+
+#endif
@@ -147,7 +147,7 @@ DrawDataParser::parseText( const char * buf )
         return 0;
     }
 
-    M_handler.handleText( DrawText( x, y, color, text ) );
+    M_handler.handleText( DrawText( x, y, ColorTable::instance().intern( color ), text ) );
     return n_read;
 }
 
@@ -166,7 +166,7 @@ DrawDataParser::parsePoint( const char * buf )
         return false;
     }
 
-    M_handler.handlePoint( DrawPoint( x, y, color ) );
+    M_handler.handlePoint( DrawPoint( x, y, ColorTable::instance().intern( color ) ) );
 
     return n_read;
 }
@@ -185,7 +185,7 @@ DrawDataParser::parseLine( const char * buf )
         return 0;
     }
 
-    M_handler.handleLine( DrawLine( x1, y1, x2, y2, color ) );
+    M_handler.handleLine( DrawLine( x1, y1, x2, y2, ColorTable::instance().intern( color ) ) );
 
     return n_read;
 }
@@ -205,7 +205,9 @@ DrawDataParser::parseRect( const char * buf )
         return 0;
     }
 
-    M_handler.handleRect( DrawRect( top, left, width, height, line_color, "" ) );
+    M_handler.handleRect( DrawRect( top, left, width, height,
+                                    ColorTable::instance().intern( line_color ),
+                                    ColorTable::NONE ) );
 
     return n_read;
 }
@@ -227,7 +229,9 @@ DrawDataParser::parseFilledRect( const char * buf )
         return 0;
     }
 
-    M_handler.handleRect( DrawRect( top, left, width, height, line_color, fill_color ) );
+    M_handler.handleRect( DrawRect( top, left, width, height,
+                                    ColorTable::instance().intern( line_color ),
+                                    ColorTable::instance().intern( fill_color ) ) );
 
     return n_read;
 }
@@ -246,7 +250,9 @@ DrawDataParser::parseCircle( const char * buf )
         std::cerr << "(DrawDataParser::parseCircle) illegal data [" << buf << "]" << std::endl;
     }
 
-    M_handler.handleCircle( DrawCircle( x, y, r, line_color, "" ) );
+    M_handler.handleCircle( DrawCircle( x, y, r,
+                                        ColorTable::instance().intern( line_color ),
+                                        ColorTable::NONE ) );
 
     return n_read;
 }
@@ -267,7 +273,9 @@ DrawDataParser::parseFilledCircle( const char * buf )
         return 0;
     }
 
-    M_handler.handleCircle( DrawCircle( x, y, r, line_color, fill_color ) );
+    M_handler.handleCircle( DrawCircle( x, y, r,
+                                        ColorTable::instance().intern( line_color ),
+                                        ColorTable::instance().intern( fill_color ) ) );
 
     return n_read;
 }
@@ -32,18 +32,20 @@
 #ifndef SOCCERWINDOW2_DRAW_TYPES_H
 #define SOCCERWINDOW2_DRAW_TYPES_H
 
+#include "color_table.h"
+
 #include <string>
 #include <list>
 
 struct DrawText {
     double x_;
     double y_;
-    std::string color_;
+    ColorTable::ID color_;
     std::string msg_;
 
     DrawText( const double x,
               const double y,
-              const std::string & color,
+              const ColorTable::ID color,
               const std::string & msg )
         : x_( x ),
           y_( y ),
@@ -55,11 +57,11 @@ struct DrawText {
 struct DrawPoint {
     double x_;
     double y_;
-    std::string color_;
+    ColorTable::ID color_;
 
     DrawPoint( const double x,
                const double y,
-               const std::string & color )
+               const ColorTable::ID color )
         : x_( x ),
           y_( y ),
           color_( color )
@@ -71,13 +73,13 @@ struct DrawLine {
     double y1_;
     double x2_;
     double y2_;
-    std::string color_;
+    ColorTable::ID color_;
 
     DrawLine( const double x1,
               const double y1,
               const double x2,
               const double y2,
-              const std::string & color )
+              const ColorTable::ID color )
         : x1_( x1 ),
           y1_( y1 ),
           x2_( x2 ),
@@ -92,15 +94,15 @@ struct DrawRect {
     double top_;
     double width_;
     double height_;
-    std::string line_color_;
-    std::string fill_color_;
+    ColorTable::ID line_color_;
+    ColorTable::ID fill_color_;
 
     DrawRect( const double left,
               const double top,
               const double width,
               const double height,
-              const std::string & line_color,
-              const std::string & fill_color )
+              const ColorTable::ID line_color,
+              const ColorTable::ID fill_color )
         : left_( left ),
           top_( top ),
           width_( width ),
@@ -114,14 +116,14 @@ struct DrawCircle {
     double x_;
     double y_;
     double r_;
-    std::string line_color_;
-    std::string fill_color_;
+    ColorTable::ID line_color_;
+    ColorTable::ID fill_color_;
 
     DrawCircle( const double x,
                 const double y,
                 const double r,
-                const std::string & line_color,
-                const std::string & fill_color )
+                const ColorTable::ID line_color,
+                const ColorTable::ID fill_color )
         : x_( x ),
           y_( y ),
           r_( r ),
@@ -86,40 +86,40 @@ Features::printLog( std::ostream & os ) const
     {
         for ( const DrawText & t : drawData()->texts_ )
         {
-            os << " (t " << t.x_ << ' ' << t.y_ << ' ' << std::quoted( t.msg_ ) << ' ' << std::quoted( t.color_ ) << ')';
+            os << " (t " << t.x_ << ' ' << t.y_ << ' ' << std::quoted( t.msg_ ) << ' ' << std::quoted( ColorTable::instance().name( t.color_ ) ) << ')';
         }
 
         for ( const DrawPoint & t : drawData()->points_ )
         {
-            os << " (p " << t.x_ << ' ' << t.y_ << ' ' << std::quoted( t.color_ ) << ')';
+            os << " (p " << t.x_ << ' ' << t.y_ << ' ' << std::quoted( ColorTable::instance().name( t.color_ ) ) << ')';
         }
 
         for ( const DrawLine & t : drawData()->lines_ )
         {
-            os << " (l " << t.x1_ << ' ' << t.y1_ << ' ' << t.x2_ << ' ' << t.y2_ << ' ' << std::quoted( t.color_ ) << ')';
+            os << " (l " << t.x1_ << ' ' << t.y1_ << ' ' << t.x2_ << ' ' << t.y2_ << ' ' << std::quoted( ColorTable::instance().name( t.color_ ) ) << ')';
         }
 
         for ( const DrawRect & t : drawData()->rects_ )
         {
-            if ( t.fill_color_.empty() )
+            if ( t.fill_color_ == ColorTable::NONE )
             {
-                os << " (r " << t.left_ << ' ' << t.top_ << ' ' << t.width_ << ' ' << t.height_ << ' ' << std::quoted( t.line_color_ ) << ')';
+                os << " (r " << t.left_ << ' ' << t.top_ << ' ' << t.width_ << ' ' << t.height_ << ' ' << std::quoted( ColorTable::instance().name( t.line_color_ ) ) << ')';
             }
             else
             {
-                os << " (R " << t.left_ << ' ' << t.top_ << ' ' << t.width_ << ' ' << t.height_ << ' ' << std::quoted( t.line_color_ ) << ' ' << std::quoted( t.fill_color_ ) << ')';
+                os << " (R " << t.left_ << ' ' << t.top_ << ' ' << t.width_ << ' ' << t.height_ << ' ' << std::quoted( ColorTable::instance().name( t.line_color_ ) ) << ' ' << std::quoted( ColorTable::instance().name( t.fill_color_ ) ) << ')';
             }
         }
 
         for ( const DrawCircle & t : drawData()->circles_ )
         {
-            if ( t.fill_color_.empty() )
+            if ( t.fill_color_ == ColorTable::NONE )
             {
-                os << " (c " << t.x_ << ' ' << t.y_ << ' ' << t.r_ << ' ' << std::quoted( t.line_color_ ) << ')';
+                os << " (c " << t.x_ << ' ' << t.y_ << ' ' << t.r_ << ' ' << std::quoted( ColorTable::instance().name( t.line_color_ ) ) << ')';
             }
             else
             {
-                os << " (C " << t.x_ << ' ' << t.y_ << ' ' << t.r_ << ' ' << std::quoted( t.line_color_ ) << ' ' << std::quoted( t.fill_color_ ) << ')';
+                os << " (C " << t.x_ << ' ' << t.y_ << ' ' << t.r_ << ' ' << std::quoted( ColorTable::instance().name( t.line_color_ ) ) << ' ' << std::quoted( ColorTable::instance().name( t.fill_color_ ) ) << ')';
             }
         }
     }
@@ -0,0 +1,311 @@
+// -*-c++-*-
+
+/*!
+  \file latency_monitor.cpp
+  \brief live monitor latency statistics Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "latency_monitor.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+LatencyHistogram::LatencyHistogram( const std::size_t window )
+    : M_samples(),
+      M_next( 0 ),
+      M_count( 0 ),
+      M_max( 0.0 ),
+      M_sum( 0.0 )
+{
+    M_samples.reserve( std::max( static_cast< std::size_t >( 1 ), window ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyHistogram::clear()
+{
+    M_samples.clear();
+    M_next = 0;
+    M_count = 0;
+    M_max = 0.0;
+    M_sum = 0.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyHistogram::add( const double usec )
+{
+    if ( M_samples.size() < M_samples.capacity() )
+    {
+        M_samples.push_back( usec );
+    }
+    else
+    {
+        M_samples[M_next] = usec;
+        M_next = ( M_next + 1 ) % M_samples.size();
+    }
+
+    ++M_count;
+    M_sum += usec;
+    M_max = std::max( M_max, usec );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+LatencyHistogram::percentile( const double ratio ) const
+{
+    if ( M_samples.empty() )
+    {
+        return 0.0;
+    }
+
+    std::vector< double > values = M_samples;
+    const std::size_t n = std::min( values.size() - 1,
+                                    static_cast< std::size_t >( std::max( 0.0, ratio ) * values.size() ) );
+    std::nth_element( values.begin(), values.begin() + n, values.end() );
+    return values[n];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+LatencyMonitor::LatencyMonitor()
+    : M_enabled( false ),
+      M_receive_pending( false ),
+      M_parse_pending( false ),
+      M_show_pending( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  singleton interface
+*/
+LatencyMonitor &
+LatencyMonitor::instance()
+{
+    static LatencyMonitor s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+LatencyMonitor::stage_name( const Stage stage )
+{
+    switch ( stage ) {
+    case RECEIVE_TO_PARSE:
+        return "receive-parse";
+    case PARSE_TO_SHOW:
+        return "parse-show";
+    case SHOW_TO_PAINT:
+        return "show-paint";
+    case RECEIVE_TO_PAINT:
+        return "receive-paint";
+    default:
+        break;
+    }
+    return "unknown";
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyMonitor::clear()
+{
+    M_receive_pending = false;
+    M_parse_pending = false;
+    M_show_pending = false;
+
+    for ( LatencyHistogram & h : M_histograms )
+    {
+        h.clear();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyMonitor::stampReceive( const Clock::time_point & t )
+{
+    if ( ! M_enabled )
+    {
+        return;
+    }
+
+    M_receive_time = t;
+    M_receive_pending = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyMonitor::stampParse()
+{
+    if ( ! M_enabled
+         || ! M_receive_pending )
+    {
+        return;
+    }
+
+    M_parse_time = Clock::now();
+    M_histograms[RECEIVE_TO_PARSE].add( elapsed_usec( M_receive_time, M_parse_time ) );
+
+    M_receive_pending = false;
+    M_parse_pending = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyMonitor::stampShow()
+{
+    if ( ! M_enabled
+         || ! M_parse_pending )
+    {
+        return;
+    }
+
+    M_show_time = Clock::now();
+    M_shown_receive_time = M_receive_time;
+    M_histograms[PARSE_TO_SHOW].add( elapsed_usec( M_parse_time, M_show_time ) );
+
+    M_parse_pending = false;
+    M_show_pending = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LatencyMonitor::stampPaint()
+{
+    if ( ! M_enabled
+         || ! M_show_pending )
+    {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    M_histograms[SHOW_TO_PAINT].add( elapsed_usec( M_show_time, now ) );
+    M_histograms[RECEIVE_TO_PAINT].add( elapsed_usec( M_shown_receive_time, now ) );
+
+    M_show_pending = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::string
+LatencyMonitor::summary() const
+{
+    const LatencyHistogram & h = M_histograms[RECEIVE_TO_PAINT];
+
+    std::ostringstream ostr;
+    ostr << std::fixed << std::setprecision( 1 )
+         << "latency p50=" << h.percentile( 0.5 ) * 0.001
+         << " p99=" << h.percentile( 0.99 ) * 0.001
+         << " [ms]";
+    return ostr.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+LatencyMonitor::print( std::ostream & os ) const
+{
+    os << "# stage count mean[ms] p50[ms] p99[ms] max[ms]\n";
+    os << std::fixed << std::setprecision( 3 );
+    for ( int i = 0; i < MAX_STAGE; ++i )
+    {
+        const LatencyHistogram & h = M_histograms[i];
+        os << stage_name( static_cast< Stage >( i ) )
+           << ' ' << h.count()
+           << ' ' << h.mean() * 0.001
+           << ' ' << h.percentile( 0.5 ) * 0.001
+           << ' ' << h.percentile( 0.99 ) * 0.001
+           << ' ' << h.max() * 0.001
+           << '\n';
+    }
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+LatencyMonitor::dump( const std::string & filepath ) const
+{
+    std::ofstream fout( filepath.c_str() );
+    if ( ! fout )
+    {
+        std::cerr << "Failed to open the latency log file [" << filepath << "]"
+                  << std::endl;
+        return false;
+    }
+
+    print( fout );
+    fout.flush();
+    return true;
+}
@@ -0,0 +1,180 @@
+// -*-c++-*-
+
+/*!
+  \file latency_monitor.h
+  \brief live monitor latency statistics Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_LATENCY_MONITOR_H
+#define SOCCERWINDOW2_MODEL_LATENCY_MONITOR_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*!
+  \class LatencyHistogram
+  \brief rolling window of latency samples in microseconds.
+*/
+class LatencyHistogram {
+private:
+    std::vector< double > M_samples; //!< ring buffer
+    std::size_t M_next; //!< next write position
+
+    long M_count; //!< total number of samples
+    double M_max; //!< max value in all samples
+    double M_sum; //!< sum of all samples
+
+public:
+
+    explicit
+    LatencyHistogram( const std::size_t window = 1024 );
+
+    void clear();
+
+    void add( const double usec );
+
+    long count() const
+      {
+          return M_count;
+      }
+
+    double max() const
+      {
+          return M_max;
+      }
+
+    double mean() const
+      {
+          return M_count > 0 ? M_sum / M_count : 0.0;
+      }
+
+    /*!
+      \brief get the percentile value in the current window.
+      \param ratio percentile rate [0,1]
+      \return latency [usec]. 0 if no sample.
+     */
+    double percentile( const double ratio ) const;
+};
+
+/*!
+  \class LatencyMonitor
+  \brief measures how old the live picture is.
+
+  The stages are stamped in this order for the newest received frame:
+  datagram receive, parse completion, LogPlayer::showLive and the end of
+  FieldCanvas::paintEvent. All methods must be called in the GUI thread.
+  The receive time taken in the network thread is carried by MonitorFrame.
+*/
+class LatencyMonitor {
+public:
+
+    typedef std::chrono::steady_clock Clock;
+
+    enum Stage {
+        RECEIVE_TO_PARSE,
+        PARSE_TO_SHOW,
+        SHOW_TO_PAINT,
+        RECEIVE_TO_PAINT,
+        MAX_STAGE,
+    };
+
+private:
+
+    bool M_enabled;
+
+    Clock::time_point M_receive_time; //!< receive time of the newest frame
+    Clock::time_point M_parse_time;
+    Clock::time_point M_show_time;
+    Clock::time_point M_shown_receive_time; //!< receive time of the frame passed to showLive
+
+    bool M_receive_pending;
+    bool M_parse_pending;
+    bool M_show_pending;
+
+    LatencyHistogram M_histograms[MAX_STAGE];
+
+    //! private for singleton
+    LatencyMonitor();
+
+    // not used
+    LatencyMonitor( const LatencyMonitor & ) = delete;
+    LatencyMonitor & operator=( const LatencyMonitor & ) = delete;
+
+public:
+
+    static
+    LatencyMonitor & instance();
+
+    static
+    const char * stage_name( const Stage stage );
+
+    void setEnabled( const bool on )
+      {
+          M_enabled = on;
+      }
+
+    bool isEnabled() const
+      {
+          return M_enabled;
+      }
+
+    void clear();
+
+    void stampReceive( const Clock::time_point & t );
+    void stampReceive()
+      {
+          if ( M_enabled ) stampReceive( Clock::now() );
+      }
+    void stampParse();
+    void stampShow();
+    void stampPaint();
+
+    const LatencyHistogram & histogram( const Stage stage ) const
+      {
+          return M_histograms[stage];
+      }
+
+    //! one line summary for the status bar
+    std::string summary() const;
+
+    std::ostream & print( std::ostream & os ) const;
+
+    bool dump( const std::string & filepath ) const;
+
+private:
+
+    static
+    double elapsed_usec( const Clock::time_point & from,
+                         const Clock::time_point & to )
+      {
+          return std::chrono::duration< double, std::micro >( to - from ).count();
+      }
+};
+
+#endif
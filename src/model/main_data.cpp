@@ -41,6 +41,7 @@
 #include "options.h"
 #include "view_holder.h"
 #include "features_log_parser.h"
+#include "latency_monitor.h"
 
 //#include <rcsc/rcg/parser_v5.h>
 #include <rcsc/rcg/parser_v4.h>
@@ -58,6 +59,7 @@
 #include <string>
 #include <cassert>
 #include <cmath>
+#include <ctime>
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -193,6 +195,56 @@ MainData::saveRCG( const std::string & file_path ) const
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MainData::startAutoRecording( const std::string & tag )
+{
+    const Options & opt = Options::instance();
+
+    if ( ! opt.autoRecord() )
+    {
+        return false;
+    }
+
+    char stamp[32];
+    const std::time_t now = std::time( 0 );
+    std::strftime( stamp, sizeof( stamp ), "%Y%m%d%H%M%S", std::localtime( &now ) );
+
+    std::string file_path = opt.autoRecordDir();
+    if ( file_path[file_path.length() - 1] != '/' )
+    {
+        file_path += '/';
+    }
+    file_path += stamp;
+    if ( ! tag.empty() )
+    {
+        file_path += '-';
+        file_path += tag;
+    }
+    file_path += ".rcg";
+#ifdef HAVE_LIBZ
+    if ( opt.autoRecordGZip() )
+    {
+        file_path += ".gz";
+    }
+#endif
+
+    return M_rcg_recorder.start( file_path, opt.autoRecordQueueSize() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MainData::stopAutoRecording()
+{
+    M_rcg_recorder.stop();
+}
+
 /*-------------------------------------------------------------------*/
 bool
 MainData::openFeaturesLog( const std::string & filepath )
@@ -244,13 +296,19 @@ MainData::receiveMonitorPacket( const char * message,
     //     return p.parseLine( 0, message, M_view_holder );
     // }
 
+    const std::size_t evicted = M_view_holder.evictedCount();
+    bool result = false;
+
     if ( client_version >= 3 )
     {
         rcsc::rcg::ParserV4 p;
-        return p.parseLine( 0, message, M_view_holder );
+        result = p.parseLine( 0, message, M_view_holder );
     }
 
-    return false;
+    followEviction( evicted );
+    M_rcg_recorder.record( M_view_holder );
+    LatencyMonitor::instance().stampParse();
+    return result;
 }
 
 /*-------------------------------------------------------------------*/
@@ -260,7 +318,12 @@ MainData::receiveMonitorPacket( const char * message,
 bool
 MainData::receiveMonitorPacket( const rcsc::rcg::dispinfo_t2 & disp2 )
 {
-    return M_view_holder.handleDispInfo2( disp2 );
+    const std::size_t evicted = M_view_holder.evictedCount();
+    const bool result = M_view_holder.handleDispInfo2( disp2 );
+    followEviction( evicted );
+    M_rcg_recorder.record( M_view_holder );
+    LatencyMonitor::instance().stampParse();
+    return result;
 }
 
 /*-------------------------------------------------------------------*/
@@ -270,7 +333,48 @@ MainData::receiveMonitorPacket( const rcsc::rcg::dispinfo_t2 & disp2 )
 bool
 MainData::receiveMonitorPacket( const rcsc::rcg::dispinfo_t & disp1 )
 {
-    return M_view_holder.handleDispInfo( disp1 );
+    const std::size_t evicted = M_view_holder.evictedCount();
+    const bool result = M_view_holder.handleDispInfo( disp1 );
+    followEviction( evicted );
+    M_rcg_recorder.record( M_view_holder );
+    LatencyMonitor::instance().stampParse();
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MainData::receiveMonitorFrame( const MonitorFrame & frame )
+{
+    LatencyMonitor::instance().stampReceive( frame.receiveTime() );
+
+    const std::size_t evicted = M_view_holder.evictedCount();
+    const bool result = frame.replay( M_view_holder );
+    followEviction( evicted );
+    M_rcg_recorder.record( M_view_holder );
+    LatencyMonitor::instance().stampParse();
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  keep the view index pointing at the same view data after the view
+  holder dropped the oldest data.
+*/
+void
+MainData::followEviction( const std::size_t evicted_before )
+{
+    const std::size_t diff = M_view_holder.evictedCount() - evicted_before;
+    if ( diff == 0 )
+    {
+        return;
+    }
+
+    M_view_index = ( M_view_index > diff
+                     ? M_view_index - diff
+                     : 0 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -41,6 +41,8 @@
 #include "draw_data_holder.h"
 #include "formation_edit_data.h"
 #include "features_log.h"
+#include "monitor_frame.h"
+#include "rcg_recorder.h"
 
 class MainData {
 private:
@@ -53,6 +55,9 @@ private:
     //! current view data index in M_view_holder
     std::size_t M_view_index;
 
+    //! background game log writer for the live game
+    RCGRecorder M_rcg_recorder;
+
     DebugLogHolder M_debug_log_holder;
 
     int M_action_sequence_id;
@@ -82,6 +87,19 @@ public:
     bool openRCG( const std::string & file_path );
     bool saveRCG( const std::string & file_path ) const;
 
+    /*!
+      \brief start recording the live game if the auto record option is enabled.
+      \param tag string appended to the file name to identify the server
+      \return true if the recording is started.
+     */
+    bool startAutoRecording( const std::string & tag );
+    void stopAutoRecording();
+
+    const RCGRecorder & rcgRecorder() const
+      {
+          return M_rcg_recorder;
+      }
+
     void openDebugView( const std::string & dir_path )
       {
           M_view_holder.openDebugView( dir_path );
@@ -100,9 +118,16 @@ public:
                                const int client_version );
     bool receiveMonitorPacket( const rcsc::rcg::dispinfo_t2 & disp2 );
     bool receiveMonitorPacket( const rcsc::rcg::dispinfo_t & disp1 );
+    bool receiveMonitorFrame( const MonitorFrame & frame );
 
     void receiveDebugClientPacket( const char * message );
 
+private:
+
+    void followEviction( const std::size_t evicted_before );
+
+public:
+
 
     TrainerData & getTrainerData()
       {
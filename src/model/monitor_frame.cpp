@@ -0,0 +1,277 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_frame.cpp
+  \brief recorded monitor packet Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "monitor_frame.h"
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrame::replay( rcsc::rcg::Handler & handler ) const
+{
+    bool result = true;
+
+    for ( const Event & e : M_events )
+    {
+        switch ( e.type_ ) {
+        case SHOW:
+            result &= handler.handleShow( M_shows[e.index_] );
+            break;
+        case MSG:
+            result &= handler.handleMsg( e.time_, e.value_, M_strings[e.index_] );
+            break;
+        case DRAW:
+            result &= handler.handleDraw( e.time_, M_draws[e.index_] );
+            break;
+        case PLAYMODE:
+            result &= handler.handlePlayMode( e.time_, static_cast< rcsc::PlayMode >( e.value_ ) );
+            break;
+        case TEAM:
+            result &= handler.handleTeam( e.time_,
+                                          M_teams[e.index_].first,
+                                          M_teams[e.index_].second );
+            break;
+        case SERVER_PARAM:
+            result &= handler.handleServerParam( M_strings[e.index_] );
+            break;
+        case PLAYER_PARAM:
+            result &= handler.handlePlayerParam( M_strings[e.index_] );
+            break;
+        case PLAYER_TYPE:
+            result &= handler.handlePlayerType( M_strings[e.index_] );
+            break;
+        default:
+            break;
+        }
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrame::hasState() const
+{
+    for ( const Event & e : M_events )
+    {
+        switch ( e.type_ ) {
+        case PLAYMODE:
+        case TEAM:
+        case SERVER_PARAM:
+        case PLAYER_PARAM:
+        case PLAYER_TYPE:
+            return true;
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorFrameBuilder::MonitorFrameBuilder()
+    : M_frame( new MonitorFrame() )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorFrame::ConstPtr
+MonitorFrameBuilder::take()
+{
+    if ( M_frame->empty() )
+    {
+        return MonitorFrame::ConstPtr();
+    }
+
+    MonitorFrame::ConstPtr frame = M_frame;
+    M_frame = MonitorFrame::Ptr( new MonitorFrame() );
+    return frame;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorFrameBuilder::carryState( const MonitorFrame & frame )
+{
+    for ( const MonitorFrame::Event & e : frame.M_events )
+    {
+        switch ( e.type_ ) {
+        case MonitorFrame::PLAYMODE:
+            handlePlayMode( e.time_, static_cast< rcsc::PlayMode >( e.value_ ) );
+            break;
+        case MonitorFrame::TEAM:
+            handleTeam( e.time_,
+                        frame.M_teams[e.index_].first,
+                        frame.M_teams[e.index_].second );
+            break;
+        case MonitorFrame::SERVER_PARAM:
+            handleServerParam( frame.M_strings[e.index_] );
+            break;
+        case MonitorFrame::PLAYER_PARAM:
+            handlePlayerParam( frame.M_strings[e.index_] );
+            break;
+        case MonitorFrame::PLAYER_TYPE:
+            handlePlayerType( frame.M_strings[e.index_] );
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handleEOF()
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handleShow( const rcsc::rcg::ShowInfoT & show )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::SHOW, 0, 0, M_frame->M_shows.size() );
+    M_frame->M_shows.push_back( show );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handleMsg( const int time,
+                                const int board,
+                                const std::string & msg )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::MSG, time, board, M_frame->M_strings.size() );
+    M_frame->M_strings.push_back( msg );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handleDraw( const int time,
+                                 const rcsc::rcg::drawinfo_t & draw )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::DRAW, time, 0, M_frame->M_draws.size() );
+    M_frame->M_draws.push_back( draw );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handlePlayMode( const int time,
+                                     const rcsc::PlayMode pm )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::PLAYMODE, time, static_cast< int >( pm ), 0 );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handleTeam( const int time,
+                                 const rcsc::rcg::TeamT & team_l,
+                                 const rcsc::rcg::TeamT & team_r )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::TEAM, time, 0, M_frame->M_teams.size() );
+    M_frame->M_teams.push_back( std::make_pair( team_l, team_r ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handlePlayerType( const std::string & msg )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::PLAYER_TYPE, 0, 0, M_frame->M_strings.size() );
+    M_frame->M_strings.push_back( msg );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handleServerParam( const std::string & msg )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::SERVER_PARAM, 0, 0, M_frame->M_strings.size() );
+    M_frame->M_strings.push_back( msg );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorFrameBuilder::handlePlayerParam( const std::string & msg )
+{
+    M_frame->M_events.emplace_back( MonitorFrame::PLAYER_PARAM, 0, 0, M_frame->M_strings.size() );
+    M_frame->M_strings.push_back( msg );
+    return true;
+}
@@ -0,0 +1,194 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_frame.h
+  \brief recorded monitor packet Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_MONITOR_FRAME_H
+#define SOCCERWINDOW2_MODEL_MONITOR_FRAME_H
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/types.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+  \class MonitorFrame
+  \brief an immutable sequence of rcg handler events decoded from one monitor packet.
+
+  A frame is built by MonitorFrameBuilder in the network thread, and is
+  replayed to the ViewHolder in the GUI thread. Because the replay only
+  calls the handler interface, ViewHolder and the global parameter
+  instances are never touched by the network thread.
+*/
+class MonitorFrame {
+public:
+
+    typedef std::shared_ptr< MonitorFrame > Ptr;
+    typedef std::shared_ptr< const MonitorFrame > ConstPtr;
+
+    enum EventType {
+        SHOW,
+        MSG,
+        DRAW,
+        PLAYMODE,
+        TEAM,
+        SERVER_PARAM,
+        PLAYER_PARAM,
+        PLAYER_TYPE,
+    };
+
+private:
+
+    struct Event {
+        EventType type_;
+        int time_;
+        int value_; //!< msg board or playmode
+        std::size_t index_; //!< index of the show/team/draw/string container
+
+        Event( const EventType type,
+               const int time,
+               const int value,
+               const std::size_t index )
+            : type_( type ),
+              time_( time ),
+              value_( value ),
+              index_( index )
+          { }
+    };
+
+    std::vector< Event > M_events;
+
+    std::vector< rcsc::rcg::ShowInfoT > M_shows;
+    std::vector< std::pair< rcsc::rcg::TeamT, rcsc::rcg::TeamT > > M_teams;
+    std::vector< rcsc::rcg::drawinfo_t > M_draws;
+    std::vector< std::string > M_strings;
+
+    //! the time when the source datagram was received
+    std::chrono::steady_clock::time_point M_receive_time;
+
+    friend class MonitorFrameBuilder;
+
+public:
+
+    bool empty() const
+      {
+          return M_events.empty();
+      }
+
+    std::size_t showCount() const
+      {
+          return M_shows.size();
+      }
+
+    const std::chrono::steady_clock::time_point & receiveTime() const
+      {
+          return M_receive_time;
+      }
+
+    /*!
+      \brief check if the frame contains any event that changes the persistent state.
+      playmode, team, parameters and player types are not sent again by the server.
+     */
+    bool hasState() const;
+
+    /*!
+      \brief call the handler methods in the recorded order.
+      \param handler the destination handler
+      \return false if any handler method failed.
+     */
+    bool replay( rcsc::rcg::Handler & handler ) const;
+};
+
+/*!
+  \class MonitorFrameBuilder
+  \brief rcg handler that records the received events into MonitorFrame.
+*/
+class MonitorFrameBuilder
+    : public rcsc::rcg::Handler {
+private:
+
+    MonitorFrame::Ptr M_frame;
+
+public:
+
+    MonitorFrameBuilder();
+
+    //! set the receive time of the frame being recorded.
+    void setReceiveTime( const std::chrono::steady_clock::time_point & t )
+      {
+          M_frame->M_receive_time = t;
+      }
+
+    /*!
+      \brief get the recorded frame and start a new one.
+      \return recorded frame. null if no event is recorded.
+     */
+    MonitorFrame::ConstPtr take();
+
+    /*!
+      \brief record the state events of the dropped frame into the current frame.
+      \param frame dropped frame
+
+      The shows, messages and draws are discarded. The state events are
+      replayed to the consumer before the events of the next datagram.
+     */
+    void carryState( const MonitorFrame & frame );
+
+    virtual
+    bool handleEOF();
+
+    virtual
+    bool handleShow( const rcsc::rcg::ShowInfoT & show );
+    virtual
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg );
+    virtual
+    bool handleDraw( const int time,
+                     const rcsc::rcg::drawinfo_t & draw );
+    virtual
+    bool handlePlayMode( const int time,
+                         const rcsc::PlayMode pm );
+    virtual
+    bool handleTeam( const int time,
+                     const rcsc::rcg::TeamT & team_l,
+                     const rcsc::rcg::TeamT & team_r );
+
+    virtual
+    bool handlePlayerType( const std::string & msg );
+    virtual
+    bool handleServerParam( const std::string & msg );
+    virtual
+    bool handlePlayerParam( const std::string & msg );
+};
+
+#endif
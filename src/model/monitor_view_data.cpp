@@ -155,6 +155,31 @@ MonitorViewData::MonitorViewData( const rcsc::rcg::showinfo_t & show )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \param show monitor v1 view data
+*/
+void
+MonitorViewData::convertTo( rcsc::rcg::showinfo_t & show ) const
+{
+    show.pmode = static_cast< char >( playmode() );
+
+    rcsc::rcg::convert( M_teams[0], show.team[0] );
+    rcsc::rcg::convert( M_teams[1], show.team[1] );
+
+    rcsc::rcg::convert( M_ball, show.pos[0] );
+
+    // In old format, players' index is started from '1'.
+    int i = 1;
+    for ( const rcsc::rcg::PlayerT & p : players() )
+    {
+        rcsc::rcg::convert( p, show.pos[i] );
+        ++i;
+    }
+
+    show.time = rcsc::rcg::hitons( M_time.cycle() );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -81,6 +81,7 @@ public:
     MonitorViewData( const rcsc::rcg::showinfo_t & show );
 
 
+    void convertTo( rcsc::rcg::showinfo_t & show ) const;
     void convertTo( rcsc::rcg::showinfo_t2 & show2 ) const;
     void convertTo( rcsc::rcg::DispInfoT & disp ) const;
 
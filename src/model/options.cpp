@@ -92,10 +92,33 @@ Options::Options()
       M_server_pid( 0 ),
       M_server_path( "rcssserver" ),
       M_time_shift_replay( true ),
+      M_time_shift_window_cycles( 0 ),
+      M_time_shift_window_games( 0 ),
+      M_monitor_thread( true ),
+      M_latency_monitor( false ),
+      M_latency_log_file( "" ),
+      M_monitor_servers(),
+      M_multi_monitor_layout( MULTI_MONITOR_TILE ),
+      M_unfocused_fps( 5 ),
+      M_relay_port( 0 ),
+      M_relay_max_clients( 32 ),
+      M_auto_record( false ),
+      M_auto_record_dir( "." ),
+      M_auto_record_gzip( false ),
+      M_auto_record_queue_size( 1024 ),
+      // replay server options
+      M_replay_server_file( "" ),
+      M_replay_server_port( 6000 ),
+      M_replay_server_rate( 1.0 ),
+      M_replay_server_loss( 0.0 ),
+      M_replay_server_reorder( 0.0 ),
+      M_replay_server_seed( 0 ),
       // logplayer options
       M_game_log_filepath( "" ),
       M_auto_loop_mode( false ),
       M_timer_interval( DEFAULT_TIMER_INTERVAL ),
+      M_adaptive_quality( true ),
+      M_no_frame_skip( false ),
       // window options
       M_pos_x( -1 ),
       M_pos_y( -1 ),
@@ -127,6 +150,7 @@ Options::Options()
       M_keepaway_mode( false ),
       M_anti_aliasing( true ),
       M_gradient( false ),
+      M_quality_level( 0 ),
       M_cursor_hide( false ),
       M_reverse_side( false ),
       M_player_reverse_draw( false ),
@@ -153,6 +177,8 @@ Options::Options()
       M_show_kick_accel_area( false ),
       M_show_offside_line( false ),
       M_show_card( true ),
+      M_show_profile_hud( false ),
+      M_show_dominance_strip( false ),
       M_enlarge_mode( true ),
       M_ball_size( 0.35 ),
       M_player_size( 0.0 ),
@@ -175,6 +201,9 @@ Options::Options()
       // debug server options
       M_debug_server_mode( false ),
       M_debug_server_port( 6000 + 32 ),
+      M_debug_server_transport( DEBUG_SERVER_UDP ),
+      M_debug_server_socket( "/tmp/soccerwindow2-debug" ),
+      M_debug_server_max_frame_size( 16 * 1024 * 1024 ),
       M_debug_log_dir( "/tmp" ),
       // debug view options
       M_show_debug_view( true ),
@@ -203,6 +232,16 @@ Options::Options()
       M_image_save_dir( "" ),
       M_image_name_prefix( "image-" ),
       M_image_save_format( "PNG" ),
+      M_batch_render( false ),
+      M_batch_cycles( "" ),
+      M_batch_step( 1 ),
+      M_batch_debug_log_player( "" ),
+      M_benchmark_render( false ),
+      M_benchmark_output( "render_benchmark.json" ),
+      M_benchmark_frames( 300 ),
+      M_benchmark_sizes( "640x480,1024x768,1920x1080" ),
+      M_benchmark_presets( "default,plain,full" ),
+      M_dominance_output( "" ),
       // files
       M_intercept_decision_file( "intercept_decision.csv" ),
       M_intercept_evaluate_file( "intercept_evaluate.csv" ),
@@ -253,6 +292,7 @@ Options::parseCmdLine( int argc,
     rcsc::ParamMap logplayer_options( "Log Player Options" );
     rcsc::ParamMap window_options( "Window Options" );
     rcsc::ParamMap view_options( "View Options" );
+    rcsc::ParamMap replay_server_options( "Replay Server Options" );
     rcsc::ParamMap debug_server_options( "Debug Server Options" );
     rcsc::ParamMap debug_view_options( "Debug View Options" );
     // rcsc::ParamMap evaluator_options( "Evaluator Options" );
@@ -266,6 +306,9 @@ Options::parseCmdLine( int argc,
     std::string canvas_size;
     std::string field_grass_type;
     std::string paint_style;
+    std::string debug_server_transport;
+    std::string monitor_servers;
+    std::string multi_monitor_layout;
 
     system_options.add()
         ( "help", "h",
@@ -307,6 +350,48 @@ Options::parseCmdLine( int argc,
         ( "time-shift-replay", "",
           &M_time_shift_replay,
           "enable time shift replay mode." )
+        ( "time-shift-window-cycles", "",
+          &M_time_shift_window_cycles,
+          "set the number of cycles kept for the time shift replay. 0 means unlimited." )
+        ( "time-shift-window-games", "",
+          &M_time_shift_window_games,
+          "set the number of games kept for the time shift replay. 0 means unlimited." )
+        ( "monitor-thread", "",
+          &M_monitor_thread,
+          "receive and decode monitor packets in a dedicated network thread." )
+        ( "latency-monitor", "",
+          rcsc::BoolSwitch( &M_latency_monitor ),
+          "measure the live latency from packet receive to repaint." )
+        ( "latency-log", "",
+          &M_latency_log_file,
+          "set a file path to which latency statistics are written on exit." )
+        ( "monitor-servers", "",
+          &monitor_servers,
+          "set comma separated host[:port] list to monitor several servers in one window." )
+        ( "multi-monitor-layout", "",
+          &multi_monitor_layout,
+          "set the multi monitor layout. [tile,tab]" )
+        ( "unfocused-fps", "",
+          &M_unfocused_fps,
+          "set the repaint rate of unfocused multi monitor tiles." )
+        ( "relay-port", "",
+          &M_relay_port,
+          "set a port number to re-broadcast the live monitor data to other monitors. 0 means no relay." )
+        ( "relay-max-clients", "",
+          &M_relay_max_clients,
+          "set the maximum number of downstream monitors." )
+        ( "auto-record", "",
+          rcsc::BoolSwitch( &M_auto_record ),
+          "record the live game to a game log file while connected." )
+        ( "auto-record-dir", "",
+          &M_auto_record_dir,
+          "set the directory of automatically recorded game log files." )
+        ( "auto-record-gzip", "",
+          rcsc::BoolSwitch( &M_auto_record_gzip ),
+          "compress automatically recorded game log files." )
+        ( "auto-record-queue-size", "",
+          &M_auto_record_queue_size,
+          "set the maximum number of cycles waiting to be written." )
         ;
 
     logplayer_options.add()
@@ -319,6 +404,12 @@ Options::parseCmdLine( int argc,
         ( "timer-interval", "",
           &M_timer_interval,
           "set the logplayer timer interval [msec]." )
+        ( "adaptive-quality", "",
+          &M_adaptive_quality,
+          "lower the render quality temporarily if the playback cannot keep the timer interval." )
+        ( "no-frame-skip", "",
+          rcsc::BoolSwitch( &M_no_frame_skip ),
+          "step one cycle per timer event even if the drawing cannot keep the timer interval." )
         ;
 
     window_options.add()
@@ -457,6 +548,12 @@ Options::parseCmdLine( int argc,
         ( "hide-card", "",
           rcsc::NegateSwitch( &M_show_card ),
           "hide player\'s card status." )
+        ( "show-profile-hud", "",
+          rcsc::BoolSwitch( &M_show_profile_hud ),
+          "show the drawing time of each painter on the field." )
+        ( "show-dominance-strip", "",
+          rcsc::BoolSwitch( &M_show_dominance_strip ),
+          "show the area dominated by each team under the cycle slider." )
         ( "enlarge-mode", "",
           rcsc::BoolSwitch( &M_enlarge_mode ),
           "show enlarged objects." )
@@ -478,6 +575,15 @@ Options::parseCmdLine( int argc,
         ( "debug-server-port", "",
           &M_debug_server_port,
           "set port number for the debug server." )
+        ( "debug-server-transport", "",
+          &debug_server_transport,
+          "set the debug server transport {udp,tcp,unix}. tcp and unix accept length-prefixed stream frames." )
+        ( "debug-server-socket", "",
+          &M_debug_server_socket,
+          "set the socket name used by the unix transport." )
+        ( "debug-server-max-frame-size", "",
+          &M_debug_server_max_frame_size,
+          "set the maximum size of a stream frame [byte]." )
         ( "debug-log-dir", "",
           &M_debug_log_dir,
           "set the default log file location." )
@@ -573,6 +679,27 @@ Options::parseCmdLine( int argc,
         //   "set the evaluator grid size." )
         // ;
 
+    replay_server_options.add()
+        ( "replay-server", "",
+          &M_replay_server_file,
+          "start the built-in server that streams the given game log to monitor clients." )
+        ( "replay-server-port", "",
+          &M_replay_server_port,
+          "set the port number of the replay server." )
+        ( "replay-server-rate", "",
+          &M_replay_server_rate,
+          "set the replay speed relative to the real time." )
+        ( "replay-server-loss", "",
+          &M_replay_server_loss,
+          "set the probability to drop a datagram. [0.0, 1.0]" )
+        ( "replay-server-reorder", "",
+          &M_replay_server_reorder,
+          "set the probability to swap a datagram with the next one. [0.0, 1.0]" )
+        ( "replay-server-seed", "",
+          &M_replay_server_seed,
+          "set the random seed for the packet loss and reorder." )
+        ;
+
     image_options.add()
         ( "auto-image-save", "",
           rcsc::BoolSwitch( &M_auto_image_save ),
@@ -586,6 +713,36 @@ Options::parseCmdLine( int argc,
         ( "image-save-format", "",
           &M_image_save_format,
           "set a default image format type." )
+        ( "batch-render", "",
+          rcsc::BoolSwitch( &M_batch_render ),
+          "render the game log to image files without any window and quit." )
+        ( "batch-cycles", "",
+          &M_batch_cycles,
+          "set comma separated cycles or ranges rendered in the batch mode. e.g. 1,100-200" )
+        ( "batch-step", "",
+          &M_batch_step,
+          "render every N-th cycle in the batch mode." )
+        ( "batch-debug-log-player", "",
+          &M_batch_debug_log_player,
+          "draw the debug log of the player in the batch mode. e.g. l10 (requires --debug-log-dir)" )
+        ( "benchmark-render", "",
+          rcsc::BoolSwitch( &M_benchmark_render ),
+          "measure the drawing time of each painter without any window and quit." )
+        ( "benchmark-output", "",
+          &M_benchmark_output,
+          "set the JSON file of the benchmark result. \"-\" means the standard output." )
+        ( "benchmark-frames", "",
+          &M_benchmark_frames,
+          "set the maximum number of frames drawn in each benchmark run." )
+        ( "benchmark-sizes", "",
+          &M_benchmark_sizes,
+          "set comma separated canvas sizes used in the benchmark. e.g. 640x480,1024x768" )
+        ( "benchmark-presets", "",
+          &M_benchmark_presets,
+          "set comma separated option presets used in the benchmark. [default, plain, full]" )
+        ( "dominance-output", "",
+          &M_dominance_output,
+          "write the area dominated by each player in all cycles to the CSV file without any window and quit. \"-\" means the standard output." )
         ;
 
     editor_options.add()
@@ -623,6 +780,7 @@ Options::parseCmdLine( int argc,
     parser.parse( logplayer_options );
     parser.parse( window_options );
     parser.parse( view_options );
+    parser.parse( replay_server_options );
     parser.parse( debug_server_options );
     parser.parse( debug_view_options );
     // parser.parse( evaluator_options );
@@ -649,6 +807,7 @@ Options::parseCmdLine( int argc,
         logplayer_options.printHelp( std::cout );
         window_options.printHelp( std::cout );
         view_options.printHelp( std::cout );
+        replay_server_options.printHelp( std::cout );
         debug_server_options.printHelp( std::cout );
         debug_view_options.printHelp( std::cout );
         // evaluator_options.printHelp( std::cout );
@@ -839,6 +998,106 @@ Options::parseCmdLine( int argc,
         }
     }
 
+    if ( ! M_latency_log_file.empty() )
+    {
+        M_latency_monitor = true;
+    }
+
+    if ( ! debug_server_transport.empty() )
+    {
+        if ( debug_server_transport == "udp" )
+        {
+            M_debug_server_transport = DEBUG_SERVER_UDP;
+        }
+        else if ( debug_server_transport == "tcp" )
+        {
+            M_debug_server_transport = DEBUG_SERVER_TCP;
+        }
+        else if ( debug_server_transport == "unix" )
+        {
+            M_debug_server_transport = DEBUG_SERVER_UNIX;
+        }
+        else
+        {
+            std::cerr << "Unsupported debug server transport ["
+                      << debug_server_transport << "]"
+                      << std::endl;
+        }
+    }
+
+    if ( ! monitor_servers.empty() )
+    {
+        std::string::size_type pos = 0;
+        while ( pos != std::string::npos )
+        {
+            const std::string::size_type next = monitor_servers.find( ',', pos );
+            const std::string entry = monitor_servers.substr( pos, ( next == std::string::npos
+                                                                     ? std::string::npos
+                                                                     : next - pos ) );
+            pos = ( next == std::string::npos ? next : next + 1 );
+
+            if ( entry.empty() )
+            {
+                continue;
+            }
+
+            const std::string::size_type colon = entry.rfind( ':' );
+            if ( colon == std::string::npos )
+            {
+                M_monitor_servers.push_back( std::make_pair( entry, M_port ) );
+                continue;
+            }
+
+            const int port = std::atoi( entry.c_str() + colon + 1 );
+            if ( port <= 0 )
+            {
+                std::cerr << "Illegal monitor server [" << entry << "]" << std::endl;
+                continue;
+            }
+
+            M_monitor_servers.push_back( std::make_pair( colon == 0
+                                                         ? M_host
+                                                         : entry.substr( 0, colon ),
+                                                         port ) );
+        }
+    }
+
+    if ( ! multi_monitor_layout.empty() )
+    {
+        if ( multi_monitor_layout == "tile" )
+        {
+            M_multi_monitor_layout = MULTI_MONITOR_TILE;
+        }
+        else if ( multi_monitor_layout == "tab" )
+        {
+            M_multi_monitor_layout = MULTI_MONITOR_TAB;
+        }
+        else
+        {
+            std::cerr << "Unsupported multi monitor layout ["
+                      << multi_monitor_layout << "]"
+                      << std::endl;
+        }
+    }
+
+    if ( M_time_shift_window_cycles < 0 ) M_time_shift_window_cycles = 0;
+    if ( M_time_shift_window_games < 0 ) M_time_shift_window_games = 0;
+
+    if ( M_unfocused_fps < 1 ) M_unfocused_fps = 1;
+
+    if ( M_relay_port < 0 || 65535 < M_relay_port ) M_relay_port = 0;
+
+    if ( M_replay_server_rate < 0.01 ) M_replay_server_rate = 0.01;
+    M_replay_server_loss = rcsc::bound( 0.0, M_replay_server_loss, 1.0 );
+    M_replay_server_reorder = rcsc::bound( 0.0, M_replay_server_reorder, 1.0 );
+    if ( M_relay_max_clients < 1 ) M_relay_max_clients = 1;
+    if ( M_auto_record_dir.empty() ) M_auto_record_dir = ".";
+    if ( M_auto_record_queue_size < 1 ) M_auto_record_queue_size = 1;
+    if ( M_batch_step < 1 ) M_batch_step = 1;
+    if ( M_benchmark_frames < 1 ) M_benchmark_frames = 1;
+
+    if ( M_debug_server_max_frame_size < 8192 ) M_debug_server_max_frame_size = 8192;
+
     if ( M_ball_size <= 0.001 ) M_ball_size = 0.001;
 
     if ( M_player_size < 0.0 ) M_player_size = 0.0;
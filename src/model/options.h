@@ -34,11 +34,13 @@
 
 #include "point.h"
 #include "agent_id.h"
+#include "screen_transform.h"
 
 #include <rcsc/types.h>
 #include <rcsc/geom/vector_2d.h>
 
 #include <string>
+#include <vector>
 #include <utility>
 
 /*!
@@ -75,6 +77,17 @@ public:
         FOCUS_POINT, // include center
     };
 
+    enum DebugServerTransport {
+        DEBUG_SERVER_UDP,
+        DEBUG_SERVER_TCP, //!< length-prefixed stream on localhost
+        DEBUG_SERVER_UNIX, //!< length-prefixed stream on a local domain socket
+    };
+
+    enum MultiMonitorLayout {
+        MULTI_MONITOR_TILE,
+        MULTI_MONITOR_TAB,
+    };
+
     enum MouseMeasureMode {
         MEASURE_NO_MODE,
         MEASURE_BALL_MOVE,
@@ -109,6 +122,30 @@ private:
     int M_server_pid;
     std::string M_server_path; //!< rcssserver command line path
     bool M_time_shift_replay;
+    int M_time_shift_window_cycles; //!< number of stored cycles in the time shift mode. 0 means unlimited.
+    int M_time_shift_window_games; //!< number of stored games in the time shift mode. 0 means unlimited.
+    bool M_monitor_thread; //!< receive and decode monitor packets in the network thread
+    bool M_latency_monitor; //!< measure the live latency and show it in the status bar
+    std::string M_latency_log_file; //!< file to which latency statistics are written on exit
+    std::vector< std::pair< std::string, int > > M_monitor_servers; //!< (host, port) list for the multi monitor mode
+    MultiMonitorLayout M_multi_monitor_layout;
+    int M_unfocused_fps; //!< repaint rate of unfocused multi monitor tiles
+    int M_relay_port; //!< port number for downstream monitors. 0 means no relay.
+    int M_relay_max_clients;
+    bool M_auto_record; //!< record the live game in the background
+    std::string M_auto_record_dir; //!< output directory of the auto record
+    bool M_auto_record_gzip;
+    int M_auto_record_queue_size; //!< maximum number of chunks waiting for the writer thread
+
+    //
+    // replay server options
+    //
+    std::string M_replay_server_file; //!< game log streamed by the built-in replay server
+    int M_replay_server_port;
+    double M_replay_server_rate; //!< playback speed relative to the real time
+    double M_replay_server_loss; //!< probability to drop a datagram
+    double M_replay_server_reorder; //!< probability to swap a datagram with the next one
+    int M_replay_server_seed;
 
     //
     // logplayer options
@@ -116,6 +153,8 @@ private:
     std::string M_game_log_filepath;
     bool M_auto_loop_mode;
     int M_timer_interval; //!< logplayer's timer interval. default 100[ms]
+    bool M_adaptive_quality; //!< lower the render quality when the playback is too fast
+    bool M_no_frame_skip; //!< step one cycle per timer event even if the drawing is late
 
     //
     // window options
@@ -164,6 +203,7 @@ private:
 
     bool M_anti_aliasing;
     bool M_gradient;
+    int M_quality_level; //!< lowered render quality level set by QualityGovernor. no cmd line option
     bool M_cursor_hide;
 
     bool M_reverse_side;
@@ -193,6 +233,8 @@ private:
     bool M_show_kick_accel_area; // no cmd line option
     bool M_show_offside_line; // no cmd line option
     bool M_show_card;
+    bool M_show_profile_hud; //!< draw the painter timing on the canvas
+    bool M_show_dominance_strip; //!< draw the dominated area series under the cycle slider
 
     // object size
 
@@ -232,6 +274,9 @@ private:
     //
     bool M_debug_server_mode;
     int M_debug_server_port;
+    DebugServerTransport M_debug_server_transport;
+    std::string M_debug_server_socket; //!< socket name for the local domain transport
+    int M_debug_server_max_frame_size; //!< upper limit of a stream frame [byte]
     std::string M_debug_log_dir; //!< default dir to search debug log
 
     //
@@ -277,6 +322,16 @@ private:
     std::string M_image_save_dir;
     std::string M_image_name_prefix;
     std::string M_image_save_format;
+    bool M_batch_render; //!< render images without any window and quit
+    std::string M_batch_cycles; //!< comma separated cycles or ranges. empty means all cycles.
+    int M_batch_step;
+    std::string M_batch_debug_log_player; //!< player whose debug log is drawn. e.g. "l10"
+    bool M_benchmark_render; //!< measure the rendering time of each painter and quit
+    std::string M_benchmark_output; //!< JSON result file. "-" means the standard output.
+    int M_benchmark_frames;
+    std::string M_benchmark_sizes; //!< comma separated canvas sizes. e.g. 640x480,1024x768
+    std::string M_benchmark_presets; //!< comma separated option presets. default, plain or full
+    std::string M_dominance_output; //!< CSV file of the dominated area series. "-" means the standard output.
 
     //
     // files
@@ -371,6 +426,30 @@ public:
     bool killServer() const { return M_kill_server; }
     int serverPID() const { return M_server_pid; }
     const std::string & serverPath() const { return M_server_path; }
+    bool monitorThread() const { return M_monitor_thread; }
+    bool latencyMonitor() const { return M_latency_monitor; }
+    const std::string & latencyLogFile() const { return M_latency_log_file; }
+    const std::vector< std::pair< std::string, int > > & monitorServers() const { return M_monitor_servers; }
+    bool multiMonitorMode() const { return ! M_monitor_servers.empty(); }
+    MultiMonitorLayout multiMonitorLayout() const { return M_multi_monitor_layout; }
+    int unfocusedFPS() const { return M_unfocused_fps; }
+    int relayPort() const { return M_relay_port; }
+    int relayMaxClients() const { return M_relay_max_clients; }
+    bool autoRecord() const { return M_auto_record; }
+    const std::string & autoRecordDir() const { return M_auto_record_dir; }
+    bool autoRecordGZip() const { return M_auto_record_gzip; }
+    int autoRecordQueueSize() const { return M_auto_record_queue_size; }
+
+    //
+    // replay server options
+    //
+
+    const std::string & replayServerFile() const { return M_replay_server_file; }
+    int replayServerPort() const { return M_replay_server_port; }
+    double replayServerRate() const { return M_replay_server_rate; }
+    double replayServerLoss() const { return M_replay_server_loss; }
+    double replayServerReorder() const { return M_replay_server_reorder; }
+    int replayServerSeed() const { return M_replay_server_seed; }
 
     bool monitorClientMode() const { return M_monitor_client_mode; }
 
@@ -380,6 +459,9 @@ public:
 
     bool debugServerMode() const { return M_debug_server_mode; }
     int debugServerPort() const { return M_debug_server_port; }
+    DebugServerTransport debugServerTransport() const { return M_debug_server_transport; }
+    const std::string & debugServerSocket() const { return M_debug_server_socket; }
+    int debugServerMaxFrameSize() const { return M_debug_server_max_frame_size; }
     const std::string & debugLogDir() const { return M_debug_log_dir; }
 
     //
@@ -388,8 +470,13 @@ public:
 
     const std::string & gameLogFilePath() const { return M_game_log_filepath; }
     bool timeShiftReplay() const { return M_time_shift_replay; }
+    int timeShiftWindowCycles() const { return M_time_shift_window_cycles; }
+    int timeShiftWindowGames() const { return M_time_shift_window_games; }
     bool autoLoopMode() const { return M_auto_loop_mode; }
     int timerInterval() const { return M_timer_interval; }
+    bool adaptiveQuality() const { return M_adaptive_quality; }
+    void toggleNoFrameSkip() { M_no_frame_skip = ! M_no_frame_skip; }
+    bool noFrameSkip() const { return M_no_frame_skip; }
 
     //
     // window options
@@ -501,6 +588,16 @@ public:
     void toggleGradient() { M_gradient = ! M_gradient; }
     bool gradient() const { return M_gradient; }
 
+    /*!
+      \brief set the render quality level. 0 means the full quality.
+      the user settings are kept. the render*() accessors give the effective values.
+     */
+    void setQualityLevel( const int level ) { M_quality_level = level; }
+    int qualityLevel() const { return M_quality_level; }
+    bool renderAntiAliasing() const { return M_anti_aliasing && M_quality_level < 1; }
+    bool renderGradient() const { return M_gradient && M_quality_level < 1; }
+    bool renderOverlays() const { return M_quality_level < 2; }
+
     void toggleCursorHide() { M_cursor_hide = ! M_cursor_hide; }
     bool cursorHide() const { return M_cursor_hide; }
 
@@ -563,6 +660,12 @@ public:
     void toggleShowCard() { M_show_card = ! M_show_card; }
     bool showCard() const { return M_show_card; }
 
+    void toggleShowProfileHUD() { M_show_profile_hud = ! M_show_profile_hud; }
+    bool showProfileHUD() const { return M_show_profile_hud; }
+
+    void toggleShowDominanceStrip() { M_show_dominance_strip = ! M_show_dominance_strip; }
+    bool showDominanceStrip() const { return M_show_dominance_strip; }
+
     void toggleShowBodyShadow() { M_show_body_shadow = ! M_show_body_shadow; }
     bool showBodyShadow() const { return M_show_body_shadow; }
 
@@ -737,6 +840,16 @@ public:
     const std::string & imageNamePrefix() const { return M_image_name_prefix; }
     const std::string & imageSaveFormat() const { return M_image_save_format; }
     bool autoImageSave() const { return M_auto_image_save; }
+    bool batchRender() const { return M_batch_render; }
+    const std::string & batchCycles() const { return M_batch_cycles; }
+    int batchStep() const { return M_batch_step; }
+    const std::string & batchDebugLogPlayer() const { return M_batch_debug_log_player; }
+    bool benchmarkRender() const { return M_benchmark_render; }
+    const std::string & benchmarkOutput() const { return M_benchmark_output; }
+    int benchmarkFrames() const { return M_benchmark_frames; }
+    const std::string & benchmarkSizes() const { return M_benchmark_sizes; }
+    const std::string & benchmarkPresets() const { return M_benchmark_presets; }
+    const std::string & dominanceOutput() const { return M_dominance_output; }
 
     //
     // files
@@ -877,6 +990,16 @@ public:
                    : fieldCenter().y + scale( y ) );
       }
 
+    /*!
+      \brief get the snapshot of the current field to screen transform.
+      \return transform object that does not refer to this instance.
+     */
+    ScreenTransform screenTransform() const
+      {
+          return ScreenTransform( fieldCenter().x, fieldCenter().y,
+                                  fieldScale(), M_reverse_side );
+      }
+
     /*!
       \brief convert 'x' of screen to field coordinate x
       \param x screen point value
@@ -0,0 +1,224 @@
+// -*-c++-*-
+
+/*!
+  \file quality_governor.cpp
+  \brief adaptive render quality control for the log playback Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "quality_governor.h"
+
+#include "options.h"
+
+#include <algorithm>
+#include <cmath>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+QualityGovernor::QualityGovernor()
+    : M_active( false ),
+      M_budget_usec( 0.0 ),
+      M_level( FULL ),
+      M_cycle_step( 1 ),
+      M_frame_count( 0 ),
+      M_frame_sum( 0.0 )
+{
+    resetCosts();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  singleton interface
+*/
+QualityGovernor &
+QualityGovernor::instance()
+{
+    static QualityGovernor s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+QualityGovernor::start( const int interval_msec )
+{
+    if ( ! Options::instance().adaptiveQuality() )
+    {
+        stop();
+        return;
+    }
+
+    M_active = true;
+    M_budget_usec = interval_msec * 1000.0 * RAISE_RATE;
+    resetCosts();
+    setLevel( FULL );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  A slower interval always restores the full quality, because the measured
+  costs are no longer comparable with the new budget.
+*/
+void
+QualityGovernor::setInterval( const int interval_msec )
+{
+    if ( ! M_active )
+    {
+        return;
+    }
+
+    const double budget = interval_msec * 1000.0 * RAISE_RATE;
+    if ( budget > M_budget_usec )
+    {
+        M_budget_usec = budget;
+        resetCosts();
+        setLevel( FULL );
+        return;
+    }
+
+    // keep the current level. the costs measured at the higher levels may
+    // still fit in the smaller budget.
+    M_budget_usec = budget;
+    M_frame_count = 0;
+    M_frame_sum = 0.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+QualityGovernor::stop()
+{
+    M_active = false;
+    resetCosts();
+    setLevel( FULL );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+QualityGovernor::addFrameTime( const double usec )
+{
+    if ( ! M_active )
+    {
+        return;
+    }
+
+    ++M_frame_count;
+    M_frame_sum += usec;
+
+    if ( M_frame_count < SETTLE_FRAMES )
+    {
+        return;
+    }
+
+    const double mean = M_frame_sum / M_frame_count;
+    M_level_cost[M_level] = mean;
+
+    if ( M_level == SKIP_CYCLES )
+    {
+        // the frame time does not depend on the step.
+        // the step is adjusted so that the cycle rate keeps the timer interval.
+        const int step = static_cast< int >( std::ceil( mean / M_budget_usec ) );
+        if ( step <= 1
+             || Options::instance().noFrameSkip() )
+        {
+            setLevel( NO_OVERLAYS );
+        }
+        else
+        {
+            M_cycle_step = std::min( step, MAX_CYCLE_STEP );
+            M_frame_count = 0;
+            M_frame_sum = 0.0;
+        }
+        return;
+    }
+
+    if ( mean > M_budget_usec )
+    {
+        // the cycles must not be skipped in the no frame skip mode.
+        if ( M_level + 1 < SKIP_CYCLES
+             || ! Options::instance().noFrameSkip() )
+        {
+            setLevel( static_cast< Level >( M_level + 1 ) );
+            return;
+        }
+    }
+
+    if ( M_level != FULL
+         && mean < M_budget_usec * ( LOWER_RATE / RAISE_RATE ) )
+    {
+        // do not go back to the level that is known to be too heavy.
+        // the cost is decayed so that the level is tried again after the
+        // scene becomes lighter.
+        const double lower_cost = M_level_cost[M_level - 1];
+        if ( lower_cost <= M_budget_usec )
+        {
+            setLevel( static_cast< Level >( M_level - 1 ) );
+            return;
+        }
+        M_level_cost[M_level - 1] = lower_cost * COST_DECAY;
+    }
+
+    M_frame_count = 0;
+    M_frame_sum = 0.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+QualityGovernor::setLevel( const Level level )
+{
+    M_level = level;
+    M_cycle_step = 1;
+    M_frame_count = 0;
+    M_frame_sum = 0.0;
+
+    Options::instance().setQualityLevel( static_cast< int >( level ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+QualityGovernor::resetCosts()
+{
+    std::fill( M_level_cost, M_level_cost + MAX_LEVEL, 0.0 );
+}
@@ -0,0 +1,145 @@
+// -*-c++-*-
+
+/*!
+  \file quality_governor.h
+  \brief adaptive render quality control for the log playback Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_QUALITY_GOVERNOR_H
+#define SOCCERWINDOW2_MODEL_QUALITY_GOVERNOR_H
+
+/*!
+  \class QualityGovernor
+  \brief lowers the render quality while the log playback cannot keep its timer interval.
+
+  The frame time measured in FieldCanvas::paintEvent is compared with the
+  LogPlayer timer interval. If the mean frame time of the current level
+  exceeds the budget, the level is raised one by one: no anti-aliasing and
+  gradient, no overlays, and finally several cycles per timer tick. The
+  level is lowered again when the frame time has enough headroom. The full
+  quality is restored as soon as the playback stops or slows down.
+
+  The cycles are never skipped if Options::noFrameSkip() is set.
+  The effective level is written to Options::setQualityLevel(). All methods
+  must be called in the GUI thread.
+*/
+class QualityGovernor {
+public:
+
+    enum Level {
+        FULL, //!< the user settings
+        NO_SMOOTHING, //!< no anti-aliasing and gradient
+        NO_OVERLAYS, //!< no player overlays, voronoi diagram and trace markers
+        SKIP_CYCLES, //!< several cycles are stepped per timer tick
+        MAX_LEVEL,
+    };
+
+    //! the number of frames measured before the level is changed
+    static constexpr int SETTLE_FRAMES = 8;
+    //! the rate of the timer interval over which the level is raised
+    static constexpr double RAISE_RATE = 0.8;
+    //! the rate of the timer interval under which the level is lowered
+    static constexpr double LOWER_RATE = 0.4;
+    //! the decay rate of the cost of the heavier level per measurement
+    static constexpr double COST_DECAY = 0.9;
+    //! the maximum number of cycles stepped per timer tick
+    static constexpr int MAX_CYCLE_STEP = 8;
+
+private:
+
+    bool M_active; //!< true while the playback timer is running
+    double M_budget_usec; //!< frame time allowed by the timer interval
+
+    Level M_level;
+    int M_cycle_step;
+
+    int M_frame_count; //!< the number of frames since the last level change
+    double M_frame_sum; //!< sum of the frame time since the last level change
+
+    //! the last mean frame time at each level. 0 if not measured.
+    double M_level_cost[MAX_LEVEL];
+
+    //! private for singleton
+    QualityGovernor();
+
+    // not used
+    QualityGovernor( const QualityGovernor & ) = delete;
+    QualityGovernor & operator=( const QualityGovernor & ) = delete;
+
+public:
+
+    static
+    QualityGovernor & instance();
+
+    /*!
+      \brief start to govern the playback.
+      \param interval_msec timer interval of the playback
+     */
+    void start( const int interval_msec );
+
+    /*!
+      \brief change the timer interval while playing.
+      \param interval_msec new timer interval
+     */
+    void setInterval( const int interval_msec );
+
+    /*!
+      \brief stop to govern and restore the full quality.
+     */
+    void stop();
+
+    bool isActive() const
+      {
+          return M_active;
+      }
+
+    Level level() const
+      {
+          return M_level;
+      }
+
+    /*!
+      \brief get the number of cycles stepped by one timer tick.
+     */
+    int cycleStep() const
+      {
+          return M_cycle_step;
+      }
+
+    /*!
+      \brief record the drawing time of one frame.
+      \param usec elapsed time of the paint event
+     */
+    void addFrameTime( const double usec );
+
+private:
+
+    void setLevel( const Level level );
+    void resetCosts();
+};
+
+#endif
@@ -0,0 +1,321 @@
+// -*-c++-*-
+
+/*!
+  \file rcg_recorder.cpp
+  \brief streaming game log recorder Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "rcg_recorder.h"
+
+#include "view_holder.h"
+
+#include <rcsc/common/player_param.h>
+#include <rcsc/common/server_param.h>
+
+#ifdef HAVE_LIBZ
+#include <rcsc/gz/gzfstream.h>
+#endif
+
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+
+namespace {
+
+//! the file is flushed at least at this interval while data are written.
+const std::chrono::milliseconds FLUSH_INTERVAL( 1000 );
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RCGRecorder::RCGRecorder()
+    : M_player_type_count( 0 ),
+      M_max_queue_size( 0 ),
+      M_stop_request( false ),
+      M_flush_request( false ),
+      M_recorded_count( 0 ),
+      M_dropped_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RCGRecorder::~RCGRecorder()
+{
+    stop();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+RCGRecorder::start( const std::string & file_path,
+                    const std::size_t max_queue_size )
+{
+    stop();
+
+    if ( file_path.empty() )
+    {
+        std::cerr << __FILE__ << ": (start) Empty file path!" << std::endl;
+        return false;
+    }
+
+#ifdef HAVE_LIBZ
+    if ( file_path.length() > 3
+         && file_path.compare( file_path.length() - 3, 3, ".gz" ) == 0 )
+    {
+        M_fout = std::unique_ptr< std::ostream >( new rcsc::gzofstream( file_path.c_str() ) );
+    }
+    else
+#endif
+    {
+        M_fout = std::unique_ptr< std::ostream >( new std::ofstream( file_path.c_str(),
+                                                                     std::ios_base::out
+                                                                     | std::ios_base::binary ) );
+    }
+
+    if ( ! *M_fout )
+    {
+        std::cerr << __FILE__ << ": ***ERROR*** (start)"
+                  << " Failed to open the file [" << file_path << "]"
+                  << std::endl;
+        M_fout.reset();
+        return false;
+    }
+
+    M_file_path = file_path;
+    M_serializer.reset();
+    M_last_view.reset();
+    M_player_type_count = 0;
+    M_max_queue_size = std::max( static_cast< std::size_t >( 1 ), max_queue_size );
+    M_stop_request = false;
+    M_flush_request = false;
+    M_recorded_count = 0;
+    M_dropped_count = 0;
+
+    M_writer = std::thread( &RCGRecorder::run, this );
+
+    std::cerr << "Start recording to [" << M_file_path << "]" << std::endl;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RCGRecorder::stop()
+{
+    if ( ! M_writer.joinable() )
+    {
+        return;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_stop_request = true;
+    }
+    M_cond.notify_one();
+
+    M_writer.join();
+    M_fout.reset();
+
+    std::cerr << "Stop recording [" << M_file_path << "]"
+              << " recorded=" << M_recorded_count
+              << " dropped=" << M_dropped_count
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RCGRecorder::record( const ViewHolder & holder )
+{
+    if ( ! M_writer.joinable() )
+    {
+        return;
+    }
+
+    const MonitorViewData::ConstPtr view = holder.lastMonitorView();
+    if ( ! view
+         || view == M_last_view )
+    {
+        return;
+    }
+
+    std::ostringstream os;
+    bool has_param = false;
+
+    if ( ! M_serializer )
+    {
+        M_serializer = rcsc::rcg::Serializer::create( holder.logVersion() );
+        if ( ! M_serializer )
+        {
+            std::cerr << __FILE__ << ": (record) Failed to create the RCG serializer version "
+                      << holder.logVersion() << std::endl;
+            stop();
+            return;
+        }
+
+        M_serializer->serializeHeader( os );
+        M_serializer->serializeParam( os, rcsc::ServerParam::i().toServerString() );
+        M_serializer->serializeParam( os, rcsc::PlayerParam::i().toServerString() );
+        has_param = true;
+    }
+
+    // the player types are usually received before the first show.
+    // if more types arrive later, all types are written again and overwrite the old ones.
+    if ( holder.playerTypeCont().size() != M_player_type_count )
+    {
+        for ( std::map< int, rcsc::PlayerType >::const_reference v : holder.playerTypeCont() )
+        {
+            M_serializer->serializeParam( os, v.second.toServerString() );
+        }
+        M_player_type_count = holder.playerTypeCont().size();
+        has_param = true;
+    }
+
+    // the serializer writes playmode and team only when they are changed.
+    rcsc::rcg::DispInfoT disp;
+    view->convertTo( disp );
+    M_serializer->serialize( os, disp );
+
+    M_last_view = view;
+
+    // make the file complete as soon as the game is over.
+    const bool time_over = ( view->playmode() == rcsc::PM_TimeOver );
+    if ( ! push( os.str(), time_over, has_param || time_over ) )
+    {
+        // the dropped chunk may contain the changed playmode or team.
+        // a new serializer writes them again with the next show.
+        M_serializer = rcsc::rcg::Serializer::create( holder.logVersion() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \param force if true, the chunk is queued even if the queue is full.
+  \return false if the chunk is dropped.
+*/
+bool
+RCGRecorder::push( std::string && chunk,
+                   const bool flush,
+                   const bool force )
+{
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        if ( ! force
+             && M_queue.size() >= M_max_queue_size )
+        {
+            if ( M_dropped_count == 0 )
+            {
+                std::cerr << __FILE__ << ": (push) The record queue is full."
+                          << " Data are dropped." << std::endl;
+            }
+            ++M_dropped_count;
+            return false;
+        }
+
+        M_queue.push_back( std::move( chunk ) );
+        M_flush_request = M_flush_request || flush;
+        ++M_recorded_count;
+    }
+    M_cond.notify_one();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  writer thread main loop.
+*/
+void
+RCGRecorder::run()
+{
+    std::deque< std::string > chunks;
+    std::chrono::steady_clock::time_point last_flush = std::chrono::steady_clock::now();
+    bool dirty = false;
+
+    while ( true )
+    {
+        bool stop_request = false;
+        bool flush_request = false;
+        {
+            std::unique_lock< std::mutex > lock( M_mutex );
+            M_cond.wait_for( lock, FLUSH_INTERVAL,
+                             [this]() { return M_stop_request || ! M_queue.empty(); } );
+            chunks.swap( M_queue );
+            stop_request = M_stop_request;
+            flush_request = M_flush_request;
+            M_flush_request = false;
+        }
+
+        for ( const std::string & c : chunks )
+        {
+            M_fout->write( c.data(), c.length() );
+        }
+        dirty = dirty || ! chunks.empty();
+        chunks.clear();
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if ( dirty
+             && ( stop_request
+                  || flush_request
+                  || now - last_flush >= FLUSH_INTERVAL ) )
+        {
+            M_fout->flush();
+            last_flush = now;
+            dirty = false;
+        }
+
+        if ( stop_request )
+        {
+            break;
+        }
+    }
+
+    if ( ! *M_fout )
+    {
+        std::cerr << __FILE__ << ": ***ERROR*** (run)"
+                  << " Failed to write the file [" << M_file_path << "]"
+                  << std::endl;
+    }
+}
@@ -0,0 +1,141 @@
+// -*-c++-*-
+
+/*!
+  \file rcg_recorder.h
+  \brief streaming game log recorder Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_RCG_RECORDER_H
+#define SOCCERWINDOW2_MODEL_RCG_RECORDER_H
+
+#include "monitor_view_data.h"
+
+#include <rcsc/rcg/serializer.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+class ViewHolder;
+
+/*!
+  \class RCGRecorder
+  \brief appends the live view data to a game log file from a writer thread.
+
+  The data are serialized in the caller's thread and the serialized chunks
+  are passed to the writer thread through a bounded queue. The file is
+  flushed periodically, so the record survives a crash up to the last flush.
+  If the queue is full, the show data are dropped so that the caller never
+  waits for the disk. The header, the parameters and the player types are
+  always queued, and the playmode and team are written again after a drop,
+  so the file remains a complete game log.
+*/
+class RCGRecorder {
+private:
+
+    std::string M_file_path;
+
+    //! serializer used in the caller's thread
+    rcsc::rcg::Serializer::Ptr M_serializer;
+
+    //! the last recorded view data
+    MonitorViewData::ConstPtr M_last_view;
+
+    //! the number of recorded player types
+    std::size_t M_player_type_count;
+
+    std::size_t M_max_queue_size;
+
+    std::mutex M_mutex;
+    std::condition_variable M_cond;
+    std::deque< std::string > M_queue; //!< serialized chunks. guarded by M_mutex
+    bool M_stop_request; //!< guarded by M_mutex
+    bool M_flush_request; //!< guarded by M_mutex
+
+    std::unique_ptr< std::ostream > M_fout; //!< used only in the writer thread
+    std::thread M_writer;
+
+    std::size_t M_recorded_count;
+    std::size_t M_dropped_count;
+
+    // not used
+    RCGRecorder( const RCGRecorder & ) = delete;
+    RCGRecorder & operator=( const RCGRecorder & ) = delete;
+
+public:
+
+    RCGRecorder();
+    ~RCGRecorder();
+
+    /*!
+      \brief open the output file and start the writer thread.
+      \param file_path output file path. gzip is used if the path ends with ".gz".
+      \param max_queue_size the maximum number of chunks waiting to be written.
+      \return true if the file is opened.
+     */
+    bool start( const std::string & file_path,
+                const std::size_t max_queue_size );
+
+    /*!
+      \brief write all queued data, close the file and stop the writer thread.
+     */
+    void stop();
+
+    bool isRecording() const
+      {
+          return M_writer.joinable();
+      }
+
+    const std::string & filePath() const
+      {
+          return M_file_path;
+      }
+
+    /*!
+      \brief serialize the data newly received by the view holder.
+      \param holder view holder that has just handled a monitor packet.
+
+      The header and the parameters are written when the first view data
+      arrive, because the log version is determined by the server.
+     */
+    void record( const ViewHolder & holder );
+
+private:
+
+    bool push( std::string && chunk,
+               const bool flush,
+               const bool force );
+
+    void run();
+};
+
+#endif
@@ -0,0 +1,402 @@
+// -*-c++-*-
+
+/*!
+  \file replay_log.cpp
+  \brief game log holder for the replay server Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "replay_log.h"
+
+#include "monitor_view_data.h"
+
+#include <rcsc/rcg/parser.h>
+#include <rcsc/rcg/serializer.h>
+#include <rcsc/rcg/util.h>
+
+#ifdef HAVE_LIBZ
+#include <rcsc/gz/gzfstream.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstring>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the show and message datagrams of one step.
+  DispInfo is dispinfo_t (monitor v1) or dispinfo_t2 (monitor v2).
+*/
+template < typename DispInfo >
+void
+append_binary_datagrams( const MonitorViewData & view,
+                         const std::vector< std::pair< int, std::string > > & msgs,
+                         ReplayLog::Datagrams & datagrams )
+{
+    DispInfo disp;
+
+    std::memset( &disp, 0, sizeof( disp ) );
+    disp.mode = rcsc::rcg::hitons( rcsc::rcg::SHOW_MODE );
+    view.convertTo( disp.body.show );
+    datagrams.push_back( std::string( reinterpret_cast< const char * >( &disp ), sizeof( disp ) ) );
+
+    for ( const std::pair< int, std::string > & m : msgs )
+    {
+        std::memset( &disp, 0, sizeof( disp ) );
+        disp.mode = rcsc::rcg::hitons( rcsc::rcg::MSG_MODE );
+        disp.body.msg.board = rcsc::rcg::hitons( m.first );
+        std::strncpy( disp.body.msg.message, m.second.c_str(), sizeof( disp.body.msg.message ) - 1 );
+        datagrams.push_back( std::string( reinterpret_cast< const char * >( &disp ), sizeof( disp ) ) );
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ReplayLog::ReplayLog()
+    : M_playmode( rcsc::PM_BeforeKickOff )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::open( const std::string & file_path )
+{
+#ifdef HAVE_LIBZ
+    rcsc::gzifstream fin( file_path.c_str() );
+#else
+    std::ifstream fin( file_path.c_str(),
+                       std::ios_base::in | std::ios_base::binary );
+#endif
+    if ( ! fin )
+    {
+        std::cerr << "Failed to open rcg file. [" << file_path << "]" << std::endl;
+        return false;
+    }
+
+    rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
+
+    if ( ! parser
+         || ! parser->parse( fin, *this ) )
+    {
+        std::cerr << __FILE__ << ": Failed to parse [" << file_path << "]." << std::endl;
+        return false;
+    }
+
+    return ! M_steps.empty();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::createStream( const int version,
+                         Stream & stream ) const
+{
+    stream.header_.clear();
+    stream.steps_.clear();
+
+    if ( version < 1
+         || 5 < version )
+    {
+        std::cerr << "(ReplayLog) Unsupported protocol version " << version << std::endl;
+        return false;
+    }
+
+    if ( version >= 3 )
+    {
+        createTextStream( version, stream );
+    }
+    else
+    {
+        createBinaryStream( version, stream );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  A new serializer always writes the playmode and team lines before the
+  first show line, so they are taken from its output.
+*/
+bool
+ReplayLog::createStateDatagrams( const int version,
+                                 const std::size_t step,
+                                 Datagrams & datagrams ) const
+{
+    datagrams.clear();
+
+    if ( version < 3
+         || M_steps.empty() )
+    {
+        return false;
+    }
+
+    rcsc::rcg::Serializer::Ptr serializer = rcsc::rcg::Serializer::create( version >= 4 ? 5 : 4 );
+    if ( ! serializer )
+    {
+        return false;
+    }
+
+    std::ostringstream os;
+    serializer->serialize( os, M_steps[std::min( step, M_steps.size() - 1 )].disp_ );
+
+    std::istringstream is( os.str() );
+    std::string line;
+    while ( std::getline( is, line ) )
+    {
+        if ( ! line.compare( 0, 9, "(playmode" )
+             || ! line.compare( 0, 5, "(team" ) )
+        {
+            datagrams.push_back( line );
+        }
+    }
+
+    return ! datagrams.empty();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReplayLog::createTextStream( const int version,
+                             Stream & stream ) const
+{
+    // monitor protocol v3 uses the rcg v4 format, and v4 or later uses the rcg v5 format.
+    rcsc::rcg::Serializer::Ptr serializer = rcsc::rcg::Serializer::create( version >= 4 ? 5 : 4 );
+    if ( ! serializer )
+    {
+        std::cerr << "(ReplayLog) Failed to create the serializer for the protocol version "
+                  << version << std::endl;
+        return;
+    }
+
+    if ( ! M_server_param.empty() ) stream.header_.push_back( M_server_param );
+    if ( ! M_player_param.empty() ) stream.header_.push_back( M_player_param );
+    stream.header_.insert( stream.header_.end(), M_player_types.begin(), M_player_types.end() );
+
+    stream.steps_.reserve( M_steps.size() );
+
+    std::ostringstream os;
+    std::string line;
+
+    for ( const Step & step : M_steps )
+    {
+        stream.steps_.push_back( Datagrams() );
+        Datagrams & datagrams = stream.steps_.back();
+
+        // the serializer may put the playmode and team lines before the show line.
+        os.str( std::string() );
+        serializer->serialize( os, step.disp_ );
+
+        std::istringstream is( os.str() );
+        while ( std::getline( is, line ) )
+        {
+            if ( ! line.empty() )
+            {
+                datagrams.push_back( line );
+            }
+        }
+
+        for ( const std::pair< int, std::string > & m : step.msgs_ )
+        {
+            std::ostringstream msg;
+            msg << "(msg " << step.disp_.show_.time_ << ' ' << m.first << " \"" << m.second << "\")";
+            datagrams.push_back( msg.str() );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  rcssserver sends no parameter datagrams in the protocol v1.
+  The v2 parameter structures are not generated either, so v2 clients use their defaults.
+*/
+void
+ReplayLog::createBinaryStream( const int version,
+                               Stream & stream ) const
+{
+    stream.steps_.reserve( M_steps.size() );
+
+    for ( const Step & step : M_steps )
+    {
+        stream.steps_.push_back( Datagrams() );
+        Datagrams & datagrams = stream.steps_.back();
+
+        const MonitorViewData view( step.disp_.show_,
+                                    step.disp_.pmode_,
+                                    step.disp_.team_[0],
+                                    step.disp_.team_[1] );
+
+        if ( version == 2 )
+        {
+            append_binary_datagrams< rcsc::rcg::dispinfo_t2 >( view, step.msgs_, datagrams );
+        }
+        else
+        {
+            append_binary_datagrams< rcsc::rcg::dispinfo_t >( view, step.msgs_, datagrams );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handleEOF()
+{
+    if ( ! M_pending_msgs.empty()
+         && ! M_steps.empty() )
+    {
+        M_steps.back().msgs_.insert( M_steps.back().msgs_.end(),
+                                     M_pending_msgs.begin(), M_pending_msgs.end() );
+        M_pending_msgs.clear();
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handleShow( const rcsc::rcg::ShowInfoT & show )
+{
+    M_steps.push_back( Step() );
+
+    Step & step = M_steps.back();
+    step.disp_.pmode_ = M_playmode;
+    step.disp_.team_[0] = M_teams[0];
+    step.disp_.team_[1] = M_teams[1];
+    step.disp_.show_ = show;
+    step.msgs_.swap( M_pending_msgs );
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handleMsg( const int,
+                      const int board,
+                      const std::string & msg )
+{
+    M_pending_msgs.push_back( std::make_pair( board, msg ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handleDraw( const int,
+                       const rcsc::rcg::drawinfo_t & )
+{
+    // rcssserver no longer sends draw data.
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handlePlayMode( const int,
+                           const rcsc::PlayMode pm )
+{
+    M_playmode = pm;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handleTeam( const int,
+                       const rcsc::rcg::TeamT & team_l,
+                       const rcsc::rcg::TeamT & team_r )
+{
+    M_teams[0] = team_l;
+    M_teams[1] = team_r;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handlePlayerType( const std::string & msg )
+{
+    M_player_types.push_back( msg );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handleServerParam( const std::string & msg )
+{
+    M_server_param = msg;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::handlePlayerParam( const std::string & msg )
+{
+    M_player_param = msg;
+    return true;
+}
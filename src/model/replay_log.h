@@ -0,0 +1,154 @@
+// -*-c++-*-
+
+/*!
+  \file replay_log.h
+  \brief game log holder for the replay server Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_REPLAY_LOG_H
+#define SOCCERWINDOW2_MODEL_REPLAY_LOG_H
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/types.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+  \class ReplayLog
+  \brief game log loaded by the replay server.
+
+  The log is kept as protocol independent data, and is converted to the
+  datagrams of each monitor protocol version on demand.
+*/
+class ReplayLog
+    : public rcsc::rcg::Handler {
+public:
+
+    //! datagrams in the sending order
+    typedef std::vector< std::string > Datagrams;
+
+    //! datagrams of one protocol version
+    struct Stream {
+        Datagrams header_; //!< sent to a new client before the current step
+        std::vector< Datagrams > steps_; //!< datagrams of each simulation step
+    };
+
+private:
+
+    struct Step {
+        rcsc::rcg::DispInfoT disp_;
+        std::vector< std::pair< int, std::string > > msgs_; //!< (board, message)
+    };
+
+    std::string M_server_param;
+    std::string M_player_param;
+    std::vector< std::string > M_player_types;
+
+    std::vector< Step > M_steps;
+
+    // current state while parsing
+    rcsc::PlayMode M_playmode;
+    rcsc::rcg::TeamT M_teams[2];
+    std::vector< std::pair< int, std::string > > M_pending_msgs;
+
+public:
+
+    ReplayLog();
+
+    /*!
+      \brief load the game log.
+      \param file_path RCG file path. gzipped file is also accepted.
+      \return true if at least one show data is loaded.
+     */
+    bool open( const std::string & file_path );
+
+    std::size_t size() const
+      {
+          return M_steps.size();
+      }
+
+    /*!
+      \brief convert the loaded data to the datagrams of the monitor protocol.
+      \param version monitor protocol version
+      \param stream result holder
+      \return false if the version is not supported.
+     */
+    bool createStream( const int version,
+                       Stream & stream ) const;
+
+    /*!
+      \brief create the playmode and team datagrams of the step for a client joining late.
+      \param version monitor protocol version
+      \param step index of the step sent next
+      \param datagrams result holder
+      \return false if the protocol does not need them.
+
+      The text protocol sends the playmode and team lines only when they are
+      changed. The binary protocols contain them in every show datagram.
+     */
+    bool createStateDatagrams( const int version,
+                               const std::size_t step,
+                               Datagrams & datagrams ) const;
+
+    virtual
+    bool handleEOF();
+
+    virtual
+    bool handleShow( const rcsc::rcg::ShowInfoT & show );
+    virtual
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg );
+    virtual
+    bool handleDraw( const int time,
+                     const rcsc::rcg::drawinfo_t & draw );
+    virtual
+    bool handlePlayMode( const int time,
+                         const rcsc::PlayMode pm );
+    virtual
+    bool handleTeam( const int time,
+                     const rcsc::rcg::TeamT & team_l,
+                     const rcsc::rcg::TeamT & team_r );
+
+    virtual
+    bool handlePlayerType( const std::string & msg );
+    virtual
+    bool handleServerParam( const std::string & msg );
+    virtual
+    bool handlePlayerParam( const std::string & msg );
+
+private:
+
+    void createTextStream( const int version,
+                           Stream & stream ) const;
+    void createBinaryStream( const int version,
+                             Stream & stream ) const;
+};
+
+#endif
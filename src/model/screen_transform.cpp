@@ -0,0 +1,91 @@
+// -*-c++-*-
+
+/*!
+  \file screen_transform.cpp
+  \brief field to screen coordinate transform Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "screen_transform.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*-------------------------------------------------------------------*/
+/*!
+  One (x, y) pair fills a 128 bit register, so a pair is converted by one
+  multiply and one add without any shuffle. The unaligned load and store
+  are used because the buffers are usually QPointF arrays.
+*/
+void
+ScreenTransform::map( const double * src,
+                      double * dst,
+                      const std::size_t n ) const
+{
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d offset = _mm256_setr_pd( M_center_x, M_center_y, M_center_x, M_center_y );
+    const __m256d scale = _mm256_set1_pd( M_signed_scale );
+    for ( ; i + 2 <= n; i += 2 )
+    {
+        const __m256d v = _mm256_loadu_pd( src + i * 2 );
+        _mm256_storeu_pd( dst + i * 2, _mm256_add_pd( offset, _mm256_mul_pd( v, scale ) ) );
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128d offset = _mm_setr_pd( M_center_x, M_center_y );
+    const __m128d scale = _mm_set1_pd( M_signed_scale );
+    for ( ; i < n; ++i )
+    {
+        const __m128d v = _mm_loadu_pd( src + i * 2 );
+        _mm_storeu_pd( dst + i * 2, _mm_add_pd( offset, _mm_mul_pd( v, scale ) ) );
+    }
+#elif defined(__aarch64__)
+    const double center[2] = { M_center_x, M_center_y };
+    const float64x2_t offset = vld1q_f64( center );
+    const float64x2_t scale = vdupq_n_f64( M_signed_scale );
+    for ( ; i < n; ++i )
+    {
+        const float64x2_t v = vld1q_f64( src + i * 2 );
+        vst1q_f64( dst + i * 2, vaddq_f64( offset, vmulq_f64( v, scale ) ) );
+    }
+#endif
+
+    for ( ; i < n; ++i )
+    {
+        dst[i * 2] = M_center_x + src[i * 2] * M_signed_scale;
+        dst[i * 2 + 1] = M_center_y + src[i * 2 + 1] * M_signed_scale;
+    }
+}
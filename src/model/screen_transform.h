@@ -0,0 +1,148 @@
+// -*-c++-*-
+
+/*!
+  \file screen_transform.h
+  \brief field to screen coordinate transform Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_SCREEN_TRANSFORM_H
+#define SOCCERWINDOW2_MODEL_SCREEN_TRANSFORM_H
+
+#include <cstddef>
+
+/*!
+  \class ScreenTransform
+  \brief immutable snapshot of the field to screen transform.
+
+  The reverse mode is folded into the sign of the scale factor, so the
+  conversion is a single multiply-add without any branch. A snapshot is
+  taken by Options::screenTransform() once per frame and is passed to the
+  painters that convert many points.
+*/
+class ScreenTransform {
+private:
+
+    double M_center_x; //!< screen x of the field origin
+    double M_center_y; //!< screen y of the field origin
+    double M_scale; //!< pixels per meter
+    double M_signed_scale; //!< M_scale with the sign of the reverse mode
+
+public:
+
+    /*!
+      \brief create the transform.
+      \param center_x screen x of the field origin
+      \param center_y screen y of the field origin
+      \param scale pixels per meter
+      \param reverse true if the field is drawn rotated by 180 degrees
+     */
+    ScreenTransform( const double center_x,
+                     const double center_y,
+                     const double scale,
+                     const bool reverse )
+        : M_center_x( center_x ),
+          M_center_y( center_y ),
+          M_scale( scale ),
+          M_signed_scale( reverse ? -scale : scale )
+      { }
+
+    /*!
+      \brief get the transform whose coordinates are mirrored around the field origin.
+      \param mirror if false, the same transform is returned.
+
+      This is used for the data written in the right side player's coordinate.
+     */
+    ScreenTransform mirrored( const bool mirror ) const
+      {
+          ScreenTransform t( *this );
+          if ( mirror )
+          {
+              t.M_signed_scale = -t.M_signed_scale;
+          }
+          return t;
+      }
+
+    bool operator==( const ScreenTransform & other ) const
+      {
+          return M_center_x == other.M_center_x
+              && M_center_y == other.M_center_y
+              && M_signed_scale == other.M_signed_scale;
+      }
+
+    bool operator!=( const ScreenTransform & other ) const
+      {
+          return ! operator==( other );
+      }
+
+    double scale( const double len ) const
+      {
+          return len * M_scale;
+      }
+
+    double screenX( const double x ) const
+      {
+          return M_center_x + x * M_signed_scale;
+      }
+
+    double screenY( const double y ) const
+      {
+          return M_center_y + y * M_signed_scale;
+      }
+
+    double fieldX( const double screen_x ) const
+      {
+          return ( screen_x - M_center_x ) / M_signed_scale;
+      }
+
+    double fieldY( const double screen_y ) const
+      {
+          return ( screen_y - M_center_y ) / M_signed_scale;
+      }
+
+    /*!
+      \brief convert (x, y) pairs stored contiguously to the screen coordinates.
+      \param src n pairs of field coordinates
+      \param dst n pairs of screen coordinates. may be the same as src.
+      \param n the number of pairs
+     */
+    void map( const double * src,
+              double * dst,
+              const std::size_t n ) const;
+
+    /*!
+      \brief convert (x, y) pairs stored contiguously in place.
+      \param xy n pairs of coordinates
+      \param n the number of pairs
+     */
+    void map( double * xy,
+              const std::size_t n ) const
+      {
+          map( xy, xy, n );
+      }
+};
+
+#endif
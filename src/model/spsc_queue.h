@@ -0,0 +1,126 @@
+// -*-c++-*-
+
+/*!
+  \file spsc_queue.h
+  \brief lock-free single producer single consumer queue Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_SPSC_QUEUE_H
+#define SOCCERWINDOW2_MODEL_SPSC_QUEUE_H
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+/*!
+  \class SPSCQueue
+  \brief bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+
+  The capacity is rounded up to a power of two. push() fails when the queue is full,
+  so the producer decides what to do with the overflowed element.
+*/
+template < typename T >
+class SPSCQueue {
+private:
+
+    std::vector< T > M_buffer;
+    const std::size_t M_mask;
+
+    //! next slot to be read. written only by the consumer.
+    alignas( 64 ) std::atomic< std::size_t > M_head;
+    //! next slot to be written. written only by the producer.
+    alignas( 64 ) std::atomic< std::size_t > M_tail;
+
+    // not used
+    SPSCQueue( const SPSCQueue & ) = delete;
+    SPSCQueue & operator=( const SPSCQueue & ) = delete;
+
+    static
+    std::size_t round_up( const std::size_t n )
+      {
+          std::size_t size = 2;
+          while ( size < n ) size <<= 1;
+          return size;
+      }
+
+public:
+
+    explicit
+    SPSCQueue( const std::size_t capacity )
+        : M_buffer( round_up( capacity ) ),
+          M_mask( M_buffer.size() - 1 ),
+          M_head( 0 ),
+          M_tail( 0 )
+      { }
+
+    std::size_t capacity() const
+      {
+          return M_buffer.size();
+      }
+
+    //! producer side
+    bool push( const T & value )
+      {
+          const std::size_t tail = M_tail.load( std::memory_order_relaxed );
+          if ( tail - M_head.load( std::memory_order_acquire ) >= M_buffer.size() )
+          {
+              return false;
+          }
+
+          M_buffer[tail & M_mask] = value;
+          M_tail.store( tail + 1, std::memory_order_release );
+          return true;
+      }
+
+    //! consumer side
+    bool pop( T & value )
+      {
+          const std::size_t head = M_head.load( std::memory_order_relaxed );
+          if ( head == M_tail.load( std::memory_order_acquire ) )
+          {
+              return false;
+          }
+
+          value = M_buffer[head & M_mask];
+          M_buffer[head & M_mask] = T(); // release the reference as soon as possible
+          M_head.store( head + 1, std::memory_order_release );
+          return true;
+      }
+
+    //! approximate number of elements. exact only in the producer or the consumer thread.
+    std::size_t size() const
+      {
+          return M_tail.load( std::memory_order_acquire ) - M_head.load( std::memory_order_acquire );
+      }
+
+    bool empty() const
+      {
+          return size() == 0;
+      }
+};
+
+#endif
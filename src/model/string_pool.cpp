@@ -0,0 +1,168 @@
+// -*-c++-*-
+
+/*!
+  \file string_pool.cpp
+  \brief interned string pool Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "string_pool.h"
+
+#include <algorithm>
+
+namespace {
+
+const std::size_t MIN_PURGE_THRESHOLD = 1024;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+StringPool::StringPool()
+    : M_purge_threshold( MIN_PURGE_THRESHOLD )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PooledString
+StringPool::intern( const char * str )
+{
+    if ( ! str
+         || *str == '\0' )
+    {
+        return PooledString();
+    }
+
+    return intern( std::string( str ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PooledString
+StringPool::intern( const std::string & str )
+{
+    if ( str.empty() )
+    {
+        return PooledString();
+    }
+
+    ++M_stats.lookups_;
+
+    // non-owning key that aliases the argument
+    const Entry key( Entry(), &str );
+
+    std::unordered_set< Entry, EntryHash, EntryEqual >::const_iterator it = M_entries.find( key );
+    if ( it != M_entries.end() )
+    {
+        ++M_stats.hits_;
+        M_stats.saved_bytes_ += str.length();
+        return PooledString( *it );
+    }
+
+    if ( M_entries.size() >= M_purge_threshold )
+    {
+        purge();
+        M_purge_threshold = std::max( MIN_PURGE_THRESHOLD, M_entries.size() * 2 );
+    }
+
+    Entry entry = std::make_shared< const std::string >( str );
+    M_entries.insert( entry );
+
+    ++M_stats.entries_;
+    M_stats.pooled_bytes_ += str.length();
+
+    return PooledString( entry );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+StringPool::purge()
+{
+    std::size_t removed = 0;
+
+    std::unordered_set< Entry, EntryHash, EntryEqual >::iterator it = M_entries.begin();
+    while ( it != M_entries.end() )
+    {
+        if ( it->use_count() == 1 )
+        {
+            M_stats.pooled_bytes_ -= (*it)->length();
+            it = M_entries.erase( it );
+            ++removed;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    M_stats.entries_ = M_entries.size();
+
+    return removed;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+StringPool::clear()
+{
+    M_entries.clear();
+    M_purge_threshold = MIN_PURGE_THRESHOLD;
+    M_stats = Stats();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+StringPool::printStats( std::ostream & os ) const
+{
+    os << "string pool:"
+       << " entries=" << M_stats.entries_
+       << " pooled=" << M_stats.pooled_bytes_ << "[byte]"
+       << " lookups=" << M_stats.lookups_
+       << " hits=" << M_stats.hits_
+       << " (" << M_stats.hitRate() * 100.0 << "%)"
+       << " saved=" << M_stats.saved_bytes_ << "[byte]";
+    return os;
+}
@@ -0,0 +1,206 @@
+// -*-c++-*-
+
+/*!
+  \file string_pool.h
+  \brief interned string pool Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_STRING_POOL_H
+#define SOCCERWINDOW2_MODEL_STRING_POOL_H
+
+#include <unordered_set>
+#include <memory>
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+/*!
+  \class PooledString
+  \brief immutable reference counted string handle returned by StringPool.
+
+  A default constructed handle represents an empty string without any allocation.
+*/
+class PooledString {
+private:
+    std::shared_ptr< const std::string > M_str;
+
+public:
+
+    PooledString()
+      { }
+
+    explicit
+    PooledString( const std::shared_ptr< const std::string > & str )
+        : M_str( str )
+      { }
+
+    bool empty() const
+      {
+          return ! M_str || M_str->empty();
+      }
+
+    std::size_t length() const
+      {
+          return M_str ? M_str->length() : 0;
+      }
+
+    const std::string & str() const
+      {
+          return M_str ? *M_str : empty_string();
+      }
+
+    const char * c_str() const
+      {
+          return str().c_str();
+      }
+
+    operator const std::string &() const
+      {
+          return str();
+      }
+
+    //! true if both handles refer to the same pooled instance.
+    bool sameInstance( const PooledString & other ) const
+      {
+          return M_str == other.M_str;
+      }
+
+private:
+
+    static
+    const std::string & empty_string()
+      {
+          static const std::string s_empty;
+          return s_empty;
+      }
+};
+
+inline
+std::ostream &
+operator<<( std::ostream & os,
+            const PooledString & s )
+{
+    return os << s.str();
+}
+
+/*!
+  \class StringPool
+  \brief string interning table. identical strings share one allocation.
+
+  Each entry is kept alive while at least one PooledString refers to it.
+  Unreferenced entries are removed by purge().
+*/
+class StringPool {
+public:
+
+    //! usage statistics
+    struct Stats {
+        std::size_t lookups_; //!< number of intern() calls with a non-empty string
+        std::size_t hits_; //!< number of lookups resolved to an existing entry
+        std::size_t saved_bytes_; //!< total bytes not allocated thanks to the hits
+        std::size_t entries_; //!< number of pooled strings
+        std::size_t pooled_bytes_; //!< total length of pooled strings
+
+        Stats()
+            : lookups_( 0 ),
+              hits_( 0 ),
+              saved_bytes_( 0 ),
+              entries_( 0 ),
+              pooled_bytes_( 0 )
+          { }
+
+        double hitRate() const
+          {
+              return ( lookups_ == 0
+                       ? 0.0
+                       : static_cast< double >( hits_ ) / lookups_ );
+          }
+    };
+
+private:
+
+    typedef std::shared_ptr< const std::string > Entry;
+
+    struct EntryHash {
+        std::size_t operator()( const Entry & e ) const
+          {
+              return std::hash< std::string >()( *e );
+          }
+    };
+
+    struct EntryEqual {
+        bool operator()( const Entry & lhs,
+                         const Entry & rhs ) const
+          {
+              return *lhs == *rhs;
+          }
+    };
+
+    std::unordered_set< Entry, EntryHash, EntryEqual > M_entries;
+
+    //! the table size at which the next automatic purge is performed
+    std::size_t M_purge_threshold;
+
+    Stats M_stats;
+
+    // not used
+    StringPool( const StringPool & ) = delete;
+    StringPool & operator=( const StringPool & ) = delete;
+
+public:
+
+    StringPool();
+
+    /*!
+      \brief get the shared handle of the given string.
+      \param str source string
+      \return pooled string handle. empty handle if str is empty.
+    */
+    PooledString intern( const char * str );
+    PooledString intern( const std::string & str );
+
+    /*!
+      \brief remove all entries that are not referenced from outside.
+      \return the number of removed entries.
+    */
+    std::size_t purge();
+
+    /*!
+      \brief release all entries and reset statistics.
+      Handles already returned remain valid.
+     */
+    void clear();
+
+    const Stats & stats() const
+      {
+          return M_stats;
+      }
+
+    std::ostream & printStats( std::ostream & os ) const;
+};
+
+#endif
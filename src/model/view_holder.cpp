@@ -44,6 +44,7 @@
 #include <rcsc/rcg/serializer.h>
 #include <rcsc/rcg/util.h>
 
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <iostream>
@@ -54,12 +55,44 @@ const std::size_t RCG_SIZE_LIMIT = 6000 * 8;
 
 const std::string DEFAULT_DEBUG_VIEW_EXTENSION = ".dcl";
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief adjust the indices after removing the first count elements.
+  \param indices index container
+  \param count the number of removed elements
+  \param keep_zero if false, an index that becomes zero is also removed.
+*/
+void
+shift_indices( std::vector< std::size_t > & indices,
+               const std::size_t count,
+               const bool keep_zero )
+{
+    std::vector< std::size_t >::iterator it = indices.begin();
+    while ( it != indices.end()
+            && ( *it < count
+                 || ( ! keep_zero && *it == count ) ) )
+    {
+        ++it;
+    }
+    indices.erase( indices.begin(), it );
+
+    for ( std::size_t & i : indices )
+    {
+        i -= count;
+    }
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
   default constructor.
 */
 ViewHolder::ViewHolder()
     : M_last_playmode( rcsc::PM_Null ),
+      M_evicted_count( 0 ),
       M_default_type()
 {
     M_player_types.insert( std::pair< int, rcsc::PlayerType >( 0, M_default_type ) );
@@ -90,6 +123,8 @@ ViewHolder::clear()
     M_last_team_right.clear();
 
     M_score_change_indices.clear();
+    M_game_start_indices.clear();
+    M_evicted_count = 0;
     M_penalty_scores_left.clear();
     M_penalty_scores_right.clear();
 
@@ -98,6 +133,7 @@ ViewHolder::clear()
 
     M_left_debug_view.clear();
     M_right_debug_view.clear();
+    M_debug_string_pool.clear();
 
     M_default_type = rcsc::PlayerType();
     M_player_types.clear();
@@ -390,7 +426,14 @@ ViewHolder::handleEOF()
 bool
 ViewHolder::handleShow( const rcsc::rcg::ShowInfoT & show )
 {
-    if ( M_monitor_view_cont.size() > RCG_SIZE_LIMIT )
+    // the window is applied only to the live data.
+    // an opened game log keeps the size limit.
+    const bool windowed = ( Options::instance().monitorClientMode()
+                            && ( Options::instance().timeShiftWindowCycles() > 0
+                                 || Options::instance().timeShiftWindowGames() > 0 ) );
+
+    if ( ! windowed
+         && M_monitor_view_cont.size() > RCG_SIZE_LIMIT )
     {
         return false;
     }
@@ -427,8 +470,22 @@ ViewHolder::handleShow( const rcsc::rcg::ShowInfoT & show )
             }
         }
 
+        if ( ! M_monitor_view_cont.empty()
+             && M_last_monitor_view->time().cycle() < M_monitor_view_cont.back()->time().cycle()
+             && ( M_game_start_indices.empty()
+                  || M_game_start_indices.back() != M_monitor_view_cont.size() ) )
+        {
+            // the game time was reset. a new game has started.
+            M_game_start_indices.push_back( M_monitor_view_cont.size() );
+        }
+
         M_monitor_view_cont.push_back( M_last_monitor_view );
 
+        if ( windowed )
+        {
+            evictOldViewData();
+        }
+
         if ( M_last_monitor_view->time().cycle() == ptr->time().cycle()
              && ( pm == rcsc::PM_BeforeKickOff
                   || pm == rcsc::PM_TimeOver
@@ -456,6 +513,66 @@ ViewHolder::handleShow( const rcsc::rcg::ShowInfoT & show )
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  The view data are removed in chunks, so that the container is not
+  shifted on every cycle.
+*/
+void
+ViewHolder::evictOldViewData()
+{
+    const std::size_t size = M_monitor_view_cont.size();
+    const std::size_t window_cycles = static_cast< std::size_t >( Options::instance().timeShiftWindowCycles() );
+    const std::size_t window_games = static_cast< std::size_t >( Options::instance().timeShiftWindowGames() );
+
+    std::size_t count = 0;
+
+    if ( window_cycles > 0 )
+    {
+        const std::size_t slack = std::max( static_cast< std::size_t >( 100 ), window_cycles / 4 );
+        if ( size > window_cycles + slack )
+        {
+            count = size - window_cycles;
+        }
+    }
+
+    if ( window_games > 0
+         && M_game_start_indices.size() >= window_games )
+    {
+        // keep the latest window_games games.
+        count = std::max( count,
+                          M_game_start_indices[M_game_start_indices.size() - window_games] );
+    }
+
+    // always keep the latest view data
+    count = std::min( count, size - 1 );
+
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    const rcsc::GameTime oldest = M_monitor_view_cont[count]->time();
+
+    M_monitor_view_cont.erase( M_monitor_view_cont.begin(),
+                               M_monitor_view_cont.begin() + count );
+
+    shift_indices( M_score_change_indices, count, true );
+    shift_indices( M_game_start_indices, count, false );
+
+    M_evicted_count += count;
+
+    // debug view data are keyed by the game time.
+    // if the buffer still spans several games, the time order is ambiguous.
+    if ( M_game_start_indices.empty() )
+    {
+        M_left_debug_view.erase( M_left_debug_view.begin(),
+                                 M_left_debug_view.lower_bound( oldest ) );
+        M_right_debug_view.erase( M_right_debug_view.begin(),
+                                  M_right_debug_view.lower_bound( oldest ) );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -721,7 +838,14 @@ ViewHolder::getViewData( const std::size_t idx ) const
 std::size_t
 ViewHolder::getIndexOf( const int cycle ) const
 {
-    MonitorViewData::Cont::const_iterator it = std::lower_bound( M_monitor_view_cont.begin(),
+    // search only the latest game. the time is not monotonic over several games.
+    MonitorViewData::Cont::const_iterator first = M_monitor_view_cont.begin();
+    if ( ! M_game_start_indices.empty() )
+    {
+        first += M_game_start_indices.back();
+    }
+
+    MonitorViewData::Cont::const_iterator it = std::lower_bound( first,
                                                                  M_monitor_view_cont.end(),
                                                                  cycle,
                                                                  []( const MonitorViewData::ConstPtr & lhs,
@@ -780,7 +904,13 @@ ViewHolder::getIndexOf( const int cycle ) const
 std::size_t
 ViewHolder::getIndexOf( const rcsc::GameTime & t ) const
 {
-    MonitorViewData::Cont::const_iterator it = std::lower_bound( M_monitor_view_cont.begin(),
+    MonitorViewData::Cont::const_iterator first = M_monitor_view_cont.begin();
+    if ( ! M_game_start_indices.empty() )
+    {
+        first += M_game_start_indices.back();
+    }
+
+    MonitorViewData::Cont::const_iterator it = std::lower_bound( first,
                                                                  M_monitor_view_cont.end(),
                                                                  t,
                                                                  []( const MonitorViewData::ConstPtr & lhs,
@@ -34,6 +34,7 @@
 
 #include "monitor_view_data.h"
 #include "debug_view_data.h"
+#include "string_pool.h"
 
 #include <rcsc/common/player_type.h>
 #include <rcsc/common/team_graphic.h>
@@ -59,6 +60,12 @@ private:
     //! the set of score changed index
     std::vector< std::size_t > M_score_change_indices;
 
+    //! the first index of each game except the first one stored
+    std::vector< std::size_t > M_game_start_indices;
+
+    //! total number of view data removed by the time shift window
+    std::size_t M_evicted_count;
+
     //! the set of penalty score/miss event. first: time, second: playmode
     std::vector< std::pair< int, rcsc::PlayMode > > M_penalty_scores_left;
     std::vector< std::pair< int, rcsc::PlayMode > > M_penalty_scores_right;
@@ -80,6 +87,9 @@ private:
     //! debug view data set for right players (key:cycle)
     DebugViewData::Map M_right_debug_view;
 
+    //! shared comment/message strings referred from debug view data
+    StringPool M_debug_string_pool;
+
     rcsc::TeamGraphic M_team_graphic_left; //! left team graphic
     rcsc::TeamGraphic M_team_graphic_right; //! right team graphic
 
@@ -170,6 +180,17 @@ public:
           return M_right_debug_view;
       }
 
+    //! get the interning table for debug view comments and messages
+    StringPool & debugStringPool()
+      {
+          return M_debug_string_pool;
+      }
+
+    const StringPool & debugStringPool() const
+      {
+          return M_debug_string_pool;
+      }
+
     // get debug view data
     DebugViewData::ConstPtr getDebugView( const rcsc::GameTime & time,
                                           const AgentID & player ) const;
@@ -207,6 +228,25 @@ public:
           return M_last_monitor_view;
       }
 
+    const
+    std::vector< std::size_t > & gameStartIndices() const
+      {
+          return M_game_start_indices;
+      }
+
+    /*!
+      \brief get the total number of view data removed from the front of the container.
+      Indices held outside must be decreased by the growth of this value.
+     */
+    std::size_t evictedCount() const
+      {
+          return M_evicted_count;
+      }
+
+    /*!
+      \brief get the index of the view data in the latest game.
+      The container is not ordered by time if it holds several games.
+     */
     std::size_t getIndexOf( const int cycle ) const;
     std::size_t getIndexOf( const rcsc::GameTime & t ) const;
 
@@ -234,6 +274,9 @@ private:
 
     void addMonitorViewData( MonitorViewData::ConstPtr ptr );
 
+    //! remove the view data out of the time shift window
+    void evictOldViewData();
+
     bool analyzeTeamGraphic( const std::string & msg );
 };
 
@@ -0,0 +1,182 @@
+// -*-c++-*-
+
+/*!
+  \file viewport.h
+  \brief visible area test and level-of-detail policy Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_MODEL_VIEWPORT_H
+#define SOCCERWINDOW2_MODEL_VIEWPORT_H
+
+#include "screen_transform.h"
+
+#include <algorithm>
+#include <limits>
+
+/*!
+  \class Viewport
+  \brief the visible area of the canvas in both screen and field coordinates.
+
+  Painters skip the shapes that are entirely outside the visible area and
+  draw the shapes smaller than MIN_DETAIL_PIXELS as a point. The field
+  coordinates follow the given transform, so a mirrored transform gives the
+  visible area in the right side player's coordinates.
+*/
+class Viewport {
+public:
+
+    //! the screen length under which the shape is collapsed to a point
+    static constexpr double MIN_DETAIL_PIXELS = 1.0;
+
+private:
+
+    ScreenTransform M_transform;
+
+    double M_screen_left;
+    double M_screen_top;
+    double M_screen_right;
+    double M_screen_bottom;
+
+    double M_field_left;
+    double M_field_top;
+    double M_field_right;
+    double M_field_bottom;
+
+public:
+
+    /*!
+      \brief create the visible area of the canvas.
+      \param transform transform used to draw the shapes
+      \param width canvas width. if not positive, everything is visible.
+      \param height canvas height. if not positive, everything is visible.
+     */
+    Viewport( const ScreenTransform & transform,
+              const double width,
+              const double height )
+        : M_transform( transform ),
+          M_screen_left( 0.0 ),
+          M_screen_top( 0.0 ),
+          M_screen_right( width ),
+          M_screen_bottom( height ),
+          M_field_left( 0.0 ),
+          M_field_top( 0.0 ),
+          M_field_right( 0.0 ),
+          M_field_bottom( 0.0 )
+      {
+          if ( width <= 0.0
+               || height <= 0.0
+               || transform.scale( 1.0 ) <= 0.0 )
+          {
+              const double inf = std::numeric_limits< double >::max();
+              M_screen_left = M_field_left = -inf;
+              M_screen_top = M_field_top = -inf;
+              M_screen_right = M_field_right = inf;
+              M_screen_bottom = M_field_bottom = inf;
+              return;
+          }
+
+          // the reverse mode swaps the sides of the field rectangle.
+          const double x0 = transform.fieldX( M_screen_left );
+          const double x1 = transform.fieldX( M_screen_right );
+          const double y0 = transform.fieldY( M_screen_top );
+          const double y1 = transform.fieldY( M_screen_bottom );
+          M_field_left = std::min( x0, x1 );
+          M_field_right = std::max( x0, x1 );
+          M_field_top = std::min( y0, y1 );
+          M_field_bottom = std::max( y0, y1 );
+      }
+
+    const ScreenTransform & transform() const
+      {
+          return M_transform;
+      }
+
+    /*!
+      \brief check if the field point is visible.
+      \param x field x
+      \param y field y
+      \param pixel_margin extra screen length around the point. e.g. the text extent.
+     */
+    bool contains( const double x,
+                   const double y,
+                   const double pixel_margin = 0.0 ) const
+      {
+          const double margin = pixel_margin / M_transform.scale( 1.0 );
+          return M_field_left - margin <= x && x <= M_field_right + margin
+              && M_field_top - margin <= y && y <= M_field_bottom + margin;
+      }
+
+    /*!
+      \brief check if the field rectangle may be visible.
+      the corners may be given in any order.
+     */
+    bool intersects( const double x0,
+                     const double y0,
+                     const double x1,
+                     const double y1 ) const
+      {
+          return std::min( x0, x1 ) <= M_field_right
+              && M_field_left <= std::max( x0, x1 )
+              && std::min( y0, y1 ) <= M_field_bottom
+              && M_field_top <= std::max( y0, y1 );
+      }
+
+    /*!
+      \brief check if the field circle may be visible.
+     */
+    bool intersectsCircle( const double x,
+                           const double y,
+                           const double r ) const
+      {
+          return intersects( x - r, y - r, x + r, y + r );
+      }
+
+    /*!
+      \brief check if the screen rectangle may be visible.
+      the corners may be given in any order.
+     */
+    bool intersectsScreen( const double x0,
+                           const double y0,
+                           const double x1,
+                           const double y1 ) const
+      {
+          return std::min( x0, x1 ) <= M_screen_right
+              && M_screen_left <= std::max( x0, x1 )
+              && std::min( y0, y1 ) <= M_screen_bottom
+              && M_screen_top <= std::max( y0, y1 );
+      }
+
+    /*!
+      \brief check if the field length is too small to draw its detail.
+     */
+    bool isSubPixel( const double len ) const
+      {
+          return M_transform.scale( len ) < MIN_DETAIL_PIXELS;
+      }
+};
+
+#endif
@@ -91,7 +91,7 @@ BallPainter::draw( QPainter & painter )
     // set GDI objects
     painter.setPen( dconf.transparentPen() );
 
-    if ( opt.gradient() )
+    if ( opt.renderGradient() )
     {
         QRadialGradient gradient( ix, iy,
                                   ball_radius,
@@ -119,7 +119,7 @@ BallPainter::draw( QPainter & painter )
     {
         double color_radius = ball_radius;
 
-        if ( opt.gradient() )
+        if ( opt.renderGradient() )
         {
             //color_radius = ball_radius;
             QRadialGradient gradient( ix,
@@ -146,7 +146,7 @@ BallPainter::draw( QPainter & painter )
     {
         double color_radius = ball_radius;
 
-        if ( opt.gradient() )
+        if ( opt.renderGradient() )
         {
             //color_radius = ball_radius;
             QRadialGradient gradient( ix,
@@ -206,7 +206,7 @@ BallPainter::drawFutureState( QPainter & painter ) const
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -283,7 +283,7 @@ BallPainter::drawFutureState( QPainter & painter ) const
 
 #endif
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
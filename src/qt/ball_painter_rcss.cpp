@@ -130,7 +130,7 @@ BallPainterRCSS::drawFutureState( QPainter & painter ) const
     const DrawConfig & dconf = DrawConfig::instance();
 
     //QPainter::RenderHints hints = painter.renderHints();
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -192,7 +192,7 @@ BallPainterRCSS::drawFutureState( QPainter & painter ) const
 
     painter.restore();
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -46,9 +46,37 @@
 #include "draw_config.h"
 
 #include "options.h"
+#include "viewport.h"
 #include "main_data.h"
 #include "monitor_view_data.h"
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TraceCache::Style
+ball_trace_style( const rcsc::PlayMode pmode )
+{
+    switch ( pmode ) {
+    case rcsc::PM_BeforeKickOff:
+    case rcsc::PM_TimeOver:
+    case rcsc::PM_KickOff_Left:
+    case rcsc::PM_KickOff_Right:
+        return TraceCache::RESET;
+    case rcsc::PM_PlayOn:
+    case rcsc::PM_AfterGoal_Left:
+    case rcsc::PM_AfterGoal_Right:
+        return TraceCache::PLAYON;
+    default:
+        break;
+    }
+
+    return TraceCache::SETPLAY;
+}
+
+}
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -60,6 +88,7 @@ BallTracePainter::BallTracePainter( const MainData & main_data )
     , M_center_x( 0 )
     , M_center_y( 0 )
     , M_field_scale( 0.0 )
+    , M_trace_cache( &ball_trace_style )
 {
     M_point_pixmap = std::shared_ptr< QPixmap >( new QPixmap( 5, 5 ) );
 
@@ -89,7 +118,7 @@ BallTracePainter::draw( QPainter & painter )
     }
 
 #if 1
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -102,7 +131,7 @@ BallTracePainter::draw( QPainter & painter )
 
     drawTrace( painter );
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -200,49 +229,25 @@ BallTracePainter::drawTrace( QPainter & painter )
         return false;
     }
 
-    const bool line_trace = opt.lineTrace();
+    M_trace_cache.update( vc, TraceCache::BALL );
+
+    const Viewport viewport( opt.screenTransform(), opt.canvasWidth(), opt.canvasHeight() );
 
     painter.setBrush( DrawConfig::instance().transparentBrush() );
 
-    const QPen & bpen = DrawConfig::instance().ballPen();
     QPen black_dot_pen( Qt::black );
     black_dot_pen.setStyle( Qt::DotLine );
 
-    std::size_t i = first;
-    QPointF prev( opt.screenX( vc[i]->ball().x() ),
-                  opt.screenY( vc[i]->ball().y() ) );
-    ++i;
-    for ( ; i <= last; ++i )
-    {
-        switch ( vc[i]->playmode() ) {
-        case rcsc::PM_BeforeKickOff:
-        case rcsc::PM_TimeOver:
-        case rcsc::PM_KickOff_Left:
-        case rcsc::PM_KickOff_Right:
-            prev.setX( opt.screenX( 0.0 ) );
-            prev.setY( opt.screenY( 0.0 ) );
-            continue;
-        case rcsc::PM_PlayOn:
-        case rcsc::PM_AfterGoal_Left:
-        case rcsc::PM_AfterGoal_Right:
-            painter.setPen( bpen );
-            break;
-        default:
-            painter.setPen( black_dot_pen );
-            break;
-        }
+    M_trace_cache.drawLines( painter, viewport, first, last,
+                             DrawConfig::instance().ballPen(),
+                             black_dot_pen );
 
-        const rcsc::rcg::BallT & b = vc[i]->ball();
-        QPointF next( opt.screenX( b.x() ),
-                      opt.screenY( b.y() ) );
-
-        painter.drawLine( QLineF( prev, next ) );
-        if ( ! line_trace )
-        {
-            painter.drawPixmap( QPointF( next.x() - 2, next.y() - 2 ),
-                                *M_point_pixmap );
-        }
-        prev = next;
+    if ( ! opt.lineTrace()
+         && opt.renderOverlays() )
+    {
+        M_trace_cache.drawMarkers( painter, viewport, first, last,
+                                   *M_point_pixmap,
+                                   *M_point_pixmap );
     }
 
     return true;
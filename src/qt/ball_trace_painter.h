@@ -33,6 +33,7 @@
 #define SOCCERWINDOW2_QT_BALL_TRACE_PAINTER_H
 
 #include "painter_interface.h"
+#include "trace_cache.h"
 
 #include <memory>
 
@@ -54,6 +55,8 @@ private:
     double M_center_y;
     double M_field_scale;
 
+    TraceCache M_trace_cache;
+
     // not used
     BallTracePainter();
 public:
@@ -0,0 +1,410 @@
+// -*-c++-*-
+
+/*!
+  \file batch_renderer.cpp
+  \brief headless game log renderer class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGlobal>
+#include <QDir>
+#include <QImage>
+#include <QPainter>
+#include <QThread>
+#include <QThreadPool>
+
+#include "batch_renderer.h"
+
+#include "field_canvas.h"
+#include "field_painter.h"
+#include "team_graphic_painter.h"
+#include "painter_interface.h"
+#include "image_encode_task.h"
+
+#include "options.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+namespace {
+
+const int DEFAULT_WIDTH = 1024;
+const int DEFAULT_HEIGHT = 768;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+BatchRenderer::BatchRenderer()
+    : M_field_painter( new FieldPainter() ),
+      M_size( DEFAULT_WIDTH, DEFAULT_HEIGHT ),
+      M_debug_log_unum( 0 )
+{
+    M_team_graphic_painter = std::shared_ptr< TeamGraphicPainter >( new TeamGraphicPainter( M_main_data ) );
+    FieldCanvas::create_painters( M_main_data,
+                                  static_cast< int >( Options::instance().paintStyle() ),
+                                  M_painters );
+
+    if ( Options::instance().canvasWidth() > 0
+         && Options::instance().canvasHeight() > 0 )
+    {
+        M_size = QSize( Options::instance().canvasWidth(),
+                        Options::instance().canvasHeight() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+BatchRenderer::~BatchRenderer()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::vector< std::size_t >
+BatchRenderer::parse_cycles( const std::string & text,
+                             const ViewHolder & holder,
+                             const int step )
+{
+    std::vector< std::size_t > indices;
+
+    const std::size_t size = holder.monitorViewCont().size();
+    if ( size == 0 )
+    {
+        return indices;
+    }
+
+    // ViewHolder::getIndexOf() returns 0 if the cycle is over the end of the log.
+    const auto index_of = [&]( const int cycle )
+        {
+            const std::size_t index = holder.getIndexOf( cycle );
+            return ( holder.monitorViewCont()[index]->time().cycle() < cycle
+                     ? size
+                     : index );
+        };
+
+    std::vector< std::pair< std::size_t, std::size_t > > ranges;
+
+    if ( text.empty() )
+    {
+        ranges.push_back( std::make_pair( std::size_t( 0 ), size - 1 ) );
+    }
+    else
+    {
+        std::istringstream is( text );
+        std::string token;
+        while ( std::getline( is, token, ',' ) )
+        {
+            int first = 0;
+            int last = 0;
+            char dash = '\0';
+            const int n = std::sscanf( token.c_str(), " %d %c %d", &first, &dash, &last );
+            if ( n == 1 )
+            {
+                last = first;
+            }
+            else if ( n != 3
+                      || dash != '-'
+                      || first > last )
+            {
+                std::cerr << "(BatchRenderer) Illegal cycle range [" << token << "]" << std::endl;
+                continue;
+            }
+
+            const std::size_t first_index = index_of( first );
+            const std::size_t end_index = index_of( last + 1 );
+            if ( first_index >= size
+                 || end_index <= first_index )
+            {
+                // no view data in the range
+                continue;
+            }
+
+            // the last view data whose cycle is not greater than the last cycle.
+            ranges.push_back( std::make_pair( first_index, end_index - 1 ) );
+        }
+    }
+
+    for ( const std::pair< std::size_t, std::size_t > & r : ranges )
+    {
+        for ( std::size_t i = r.first; i <= r.second; i += step )
+        {
+            indices.push_back( i );
+        }
+    }
+
+    std::sort( indices.begin(), indices.end() );
+    indices.erase( std::unique( indices.begin(), indices.end() ), indices.end() );
+
+    return indices;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+BatchRenderer::run()
+{
+    const Options & opt = Options::instance();
+
+    if ( ! open_files( M_main_data, M_debug_log_unum ) )
+    {
+        return 1;
+    }
+
+    const std::vector< std::size_t > indices = parse_cycles( opt.batchCycles(),
+                                                             M_main_data.viewHolder(),
+                                                             opt.batchStep() );
+    if ( indices.empty() )
+    {
+        std::cerr << "(BatchRenderer) No cycle to be rendered." << std::endl;
+        return 1;
+    }
+
+    QString file_path = ( opt.imageSaveDir().empty()
+                          ? QDir::currentPath()
+                          : QString::fromStdString( opt.imageSaveDir() ) );
+    if ( ! QDir().mkpath( file_path ) )
+    {
+        std::cerr << "(BatchRenderer) Failed to create the directory ["
+                  << file_path.toStdString() << "]" << std::endl;
+        return 1;
+    }
+    if ( ! file_path.endsWith( QChar( '/' ) ) )
+    {
+        file_path += QChar( '/' );
+    }
+    file_path += QString::fromStdString( opt.imageNamePrefix() );
+
+    const QString format = QString::fromStdString( opt.imageSaveFormat() ).toLower();
+    const QByteArray format_name = format.toLatin1();
+
+    QThreadPool encoder_pool;
+    encoder_pool.setMaxThreadCount( std::max( 1, QThread::idealThreadCount() ) );
+
+    const std::size_t max_pending = static_cast< std::size_t >( encoder_pool.maxThreadCount() ) * 2;
+    std::deque< std::pair< QString, std::future< bool > > > pending;
+
+    std::cerr << "(BatchRenderer) render " << indices.size() << " images."
+              << " size = " << M_size.width() << " x " << M_size.height()
+              << std::endl;
+
+    int result = 0;
+
+    for ( std::size_t i = 0; i <= indices.size() && result == 0; ++i )
+    {
+        while ( ! pending.empty()
+                && ( pending.size() >= max_pending
+                     || i == indices.size() ) )
+        {
+            if ( ! pending.front().second.get() )
+            {
+                std::cerr << "(BatchRenderer) Failed to save the image ["
+                          << pending.front().first.toStdString() << "]" << std::endl;
+                result = 1;
+            }
+            pending.pop_front();
+        }
+
+        if ( i == indices.size() )
+        {
+            break;
+        }
+
+        MonitorViewData::ConstPtr view = M_main_data.viewHolder().getViewData( indices[i] );
+        if ( ! view )
+        {
+            continue;
+        }
+
+        QString file_path_all = file_path;
+        file_path_all += QString( "%1" ).arg( view->time().cycle(), 5, 10, QChar( '0' ) );
+        if ( view->time().stopped() > 0 )
+        {
+            file_path_all += QString( "-%1" ).arg( view->time().stopped() );
+        }
+        file_path_all += QChar( '.' );
+        file_path_all += format;
+
+        QImage image( M_size, QImage::Format_RGB32 );
+        render( indices[i], image );
+
+        ImageEncodeTask * task = new ImageEncodeTask( image, file_path_all, format_name );
+        pending.push_back( std::make_pair( file_path_all, task->result() ) );
+        encoder_pool.start( task );
+    }
+
+    encoder_pool.waitForDone();
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+BatchRenderer::open_files( MainData & main_data,
+                           int & debug_log_unum )
+{
+    const Options & opt = Options::instance();
+
+    debug_log_unum = 0;
+
+    if ( opt.gameLogFilePath().empty() )
+    {
+        std::cerr << "(BatchRenderer) No game log file." << std::endl;
+        return false;
+    }
+
+    if ( ! main_data.openRCG( opt.gameLogFilePath() )
+         || main_data.viewHolder().monitorViewCont().empty() )
+    {
+        std::cerr << "(BatchRenderer) Failed to read the game log ["
+                  << opt.gameLogFilePath() << "]" << std::endl;
+        return false;
+    }
+
+    if ( ! opt.drawDataFile().empty()
+         && ! main_data.openDrawData( opt.drawDataFile() ) )
+    {
+        std::cerr << "(BatchRenderer) Failed to read the draw data ["
+                  << opt.drawDataFile() << "]" << std::endl;
+    }
+
+    if ( ! opt.debugLogDir().empty() )
+    {
+        main_data.openDebugView( opt.debugLogDir() );
+    }
+
+    if ( ! opt.batchDebugLogPlayer().empty() )
+    {
+        debug_log_unum = open_debug_log( main_data );
+        if ( debug_log_unum == 0 )
+        {
+            std::cerr << "(BatchRenderer) Failed to read the debug log of ["
+                      << opt.batchDebugLogPlayer() << "]" << std::endl;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+BatchRenderer::open_debug_log( MainData & main_data )
+{
+    const std::string & player = Options::instance().batchDebugLogPlayer();
+
+    const char side_char = player.empty() ? '\0' : player[0];
+    const int unum = std::atoi( player.c_str() + 1 );
+
+    if ( ( side_char != 'l' && side_char != 'r' )
+         || unum < 1 || 11 < unum )
+    {
+        return 0;
+    }
+
+    const rcsc::SideID side = ( side_char == 'l' ? rcsc::LEFT : rcsc::RIGHT );
+
+    MonitorViewData::ConstPtr view = main_data.viewHolder().lastMonitorView();
+    if ( ! view )
+    {
+        return 0;
+    }
+
+    const std::string & team_name = ( side == rcsc::LEFT
+                                      ? view->leftTeam().name()
+                                      : view->rightTeam().name() );
+    if ( team_name.empty()
+         || ! main_data.setDebugLogDir( team_name, side, unum,
+                                        Options::instance().debugLogDir() ) )
+    {
+        return 0;
+    }
+
+    // draw all levels of the selected player
+    main_data.setDebugLogLevel( ~std::int32_t( 0 ), true );
+    Options::instance().setSelectedNumber( side, unum );
+
+    return unum;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+BatchRenderer::render( const std::size_t index,
+                       QImage & image )
+{
+    M_main_data.setViewDataIndex( static_cast< int >( index ) );
+    M_main_data.update( image.width(), image.height() );
+
+    if ( M_debug_log_unum != 0 )
+    {
+        if ( MonitorViewData::ConstPtr view = M_main_data.getCurrentViewData() )
+        {
+            M_main_data.seekDebugLogData( M_debug_log_unum, view->time() );
+        }
+    }
+
+    QPainter painter( &image );
+
+    if ( Options::instance().antiAliasing() )
+    {
+        painter.setRenderHint( QPainter::Antialiasing, true );
+    }
+    painter.setRenderHint( QPainter::TextAntialiasing, false );
+
+    M_field_painter->draw( painter );
+    M_team_graphic_painter->draw( painter );
+
+    for ( std::shared_ptr< PainterInterface > & p : M_painters )
+    {
+        p->draw( painter );
+    }
+}
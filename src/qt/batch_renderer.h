@@ -0,0 +1,116 @@
+// -*-c++-*-
+
+/*!
+  \file batch_renderer.h
+  \brief headless game log renderer class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_BATCH_RENDERER_H
+#define SOCCERWINDOW2_QT_BATCH_RENDERER_H
+
+#include "main_data.h"
+
+#include <QSize>
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstddef>
+
+class QImage;
+class FieldPainter;
+class TeamGraphicPainter;
+class PainterInterface;
+
+/*!
+  \class BatchRenderer
+  \brief renders the game log to image files without any window.
+
+  Only MainData and the painters are used, so the renderer works on the
+  offscreen platform plugin of Qt.
+*/
+class BatchRenderer {
+private:
+
+    MainData M_main_data;
+
+    std::shared_ptr< FieldPainter > M_field_painter;
+    std::shared_ptr< TeamGraphicPainter > M_team_graphic_painter;
+    std::vector< std::shared_ptr< PainterInterface > > M_painters;
+
+    QSize M_size;
+
+    //! player whose debug log is drawn. 0 means none.
+    int M_debug_log_unum;
+
+    // not used
+    BatchRenderer( const BatchRenderer & ) = delete;
+    BatchRenderer & operator=( const BatchRenderer & ) = delete;
+
+public:
+
+    BatchRenderer();
+    ~BatchRenderer();
+
+    /*!
+      \brief load the files given by the options and render all requested cycles.
+      \return exit status of the application
+     */
+    int run();
+
+    /*!
+      \brief parse the cycle list. e.g. "1,100-200"
+      \param text cycle list string. empty means all cycles.
+      \param holder view holder that contains the game log
+      \param step render every step-th view data in each range
+      \return view data indices in ascending order without duplicates
+     */
+    static
+    std::vector< std::size_t > parse_cycles( const std::string & text,
+                                             const ViewHolder & holder,
+                                             const int step );
+
+    /*!
+      \brief load the game log and the optional files given by the options.
+      \param main_data data holder
+      \param debug_log_unum the player whose debug log is loaded. 0 if none.
+      \return false if the game log cannot be loaded.
+     */
+    static
+    bool open_files( MainData & main_data,
+                     int & debug_log_unum );
+
+private:
+
+    static
+    int open_debug_log( MainData & main_data );
+
+    void render( const std::size_t index,
+                 QImage & image );
+};
+
+#endif
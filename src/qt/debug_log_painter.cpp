@@ -44,14 +44,80 @@
 #include "debug_log_painter.h"
 
 #include "draw_config.h"
+#include "screen_points.h"
 
 #include "options.h"
+#include "viewport.h"
 #include "main_data.h"
 #include "debug_log_data.h"
 #include "debug_log_holder.h"
 
+#include <algorithm>
 #include <iostream>
 
+namespace {
+
+//! the maximum number of points on an arc
+const int MAX_ARC_LOOP = 18;
+
+//! screen length around the text anchor in which the text may be visible
+const double TEXT_MARGIN = 256.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief set the pen of the color only if the color is changed from the previous shape.
+  \param fallback pen used if the color is not valid.
+*/
+inline
+void
+set_pen( QPainter & painter,
+         const ColorTable::ID color,
+         const QPen & fallback,
+         ColorTable::ID & current )
+{
+    if ( color == current )
+    {
+        return;
+    }
+
+    const DrawConfig::ColorHandle & handle = DrawConfig::instance().colorHandle( color );
+    painter.setPen( handle.valid_ ? handle.pen_ : fallback );
+    current = color;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief set the pen and the brush of the color only if the color is changed from the previous shape.
+  \param fallback pen used if the color is not valid. its color is used for the brush.
+*/
+inline
+void
+set_pen_brush( QPainter & painter,
+               const ColorTable::ID color,
+               const QPen & fallback,
+               ColorTable::ID & current )
+{
+    if ( color == current )
+    {
+        return;
+    }
+
+    const DrawConfig::ColorHandle & handle = DrawConfig::instance().colorHandle( color );
+    if ( handle.valid_ )
+    {
+        painter.setPen( handle.pen_ );
+        painter.setBrush( handle.brush_ );
+    }
+    else
+    {
+        painter.setPen( fallback );
+        painter.setBrush( fallback.color() );
+    }
+    current = color;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -100,7 +166,7 @@ DebugLogPainter::draw( QPainter & painter )
 
     const rcsc::SideID player_side = ( number < 0 ? rcsc::RIGHT : rcsc::LEFT );
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -123,7 +189,7 @@ DebugLogPainter::draw( QPainter & painter )
 
     drawActionSequence( painter, player_side );
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -149,31 +215,39 @@ DebugLogPainter::drawPoints( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     painter.setBrush( dconf.transparentBrush() );
 
+    // consecutive points of the same color are drawn at once.
+    QVector< QPointF > points;
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::PointCont::const_reference v : log_data.pointCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.contains( v.x_, v.y_ ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
+            if ( v.color_ != current
+                 && ! points.isEmpty() )
             {
-                painter.setPen( dconf.debugShapePen() );
+                map_to_screen( transform, points.data(), points.size() );
+                painter.drawPoints( points.constData(), points.size() );
+                points.clear();
             }
 
-            painter.drawPoint( QPointF( opt.screenX( v.x_ * reverse ),
-                                        opt.screenY( v.y_ * reverse ) ) );
+            set_pen( painter, v.color_, dconf.debugShapePen(), current );
+
+            points.push_back( QPointF( v.x_, v.y_ ) );
         }
     }
 
+    if ( ! points.isEmpty() )
+    {
+        map_to_screen( transform, points.data(), points.size() );
+        painter.drawPoints( points.constData(), points.size() );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -190,32 +264,39 @@ DebugLogPainter::drawLines( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     painter.setBrush( dconf.transparentBrush() );
 
+    // consecutive lines of the same color are drawn at once.
+    QVector< QLineF > lines;
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::LineCont::const_reference v : log_data.lineCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersects( v.x1_, v.y1_, v.x2_, v.y2_ ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
+            if ( v.color_ != current
+                 && ! lines.isEmpty() )
             {
-                painter.setPen( dconf.debugShapePen() );
+                map_to_screen( transform, lines.data(), lines.size() );
+                painter.drawLines( lines );
+                lines.clear();
             }
 
-            painter.drawLine( QLineF( opt.screenX( v.x1_ * reverse ),
-                                      opt.screenY( v.y1_ * reverse ),
-                                      opt.screenX( v.x2_ * reverse ),
-                                      opt.screenY( v.y2_ * reverse ) ) );
+            set_pen( painter, v.color_, dconf.debugShapePen(), current );
+
+            lines.push_back( QLineF( v.x1_, v.y1_, v.x2_, v.y2_ ) );
         }
     }
+
+    if ( ! lines.isEmpty() )
+    {
+        map_to_screen( transform, lines.data(), lines.size() );
+        painter.drawLines( lines );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -232,28 +313,22 @@ DebugLogPainter::drawArcs( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     painter.setBrush( dconf.transparentBrush() );
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::ArcCont::const_reference v : log_data.arcCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersectsCircle( v.x_, v.y_, v.r_ ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
-            {
-                painter.setPen( dconf.debugShapePen() );
-            }
+            set_pen( painter, v.color_, dconf.debugShapePen(), current );
 
             const double circumference_factor = ( 2.0 * M_PI ) * std::fabs( v.span_angle_ / 360.0 );
-            const double len = ( v.r_ * opt.fieldScale() ) * circumference_factor;
+            const double len = transform.scale( v.r_ ) * circumference_factor;
 
             const int min_min_loop = ( v.span_angle_ < 45.0
                                        ? 1
@@ -263,39 +338,32 @@ DebugLogPainter::drawArcs( QPainter & painter,
                                        ? 3
                                        : 4 );
 
-            const int loop = std::min( std::max( min_min_loop,
-                                                 static_cast< int >( rint( len / 32.0 ) ) ),
-                                       18 );
+            const int loop = ( viewport.isSubPixel( v.r_ * 2.0 )
+                               ? 1
+                               : std::min( std::max( min_min_loop,
+                                                     static_cast< int >( rint( len / 32.0 ) ) ),
+                                           MAX_ARC_LOOP ) );
 
             const double angle_step = ( loop == 1
                                         ? 0.0
                                         : v.span_angle_ / ( loop - 1 ) );
 
             rcsc::AngleDeg angle = v.start_angle_;
-            rcsc::Vector2D rpos = rcsc::Vector2D::polar2vector( v.r_, angle );
-
-            if ( loop == 1 )
+            QPointF points[MAX_ARC_LOOP];
+            for ( int i = 0; i < loop; ++i, angle += angle_step )
             {
-                painter.drawPoint( QPointF( opt.screenX( ( v.x_ + rpos.x ) * reverse ),
-                                            opt.screenY( ( v.y_ + rpos.y ) * reverse ) ) );
-                continue;
+                const rcsc::Vector2D rpos = rcsc::Vector2D::polar2vector( v.r_, angle );
+                points[i] = QPointF( v.x_ + rpos.x, v.y_ + rpos.y );
             }
+            map_to_screen( transform, points, loop );
 
-
-            QPainterPath path;
-
-            path.moveTo( opt.screenX( ( v.x_ + rpos.x ) * reverse ),
-                         opt.screenY( ( v.y_ + rpos.y ) * reverse ) );
-
-            angle += angle_step;
-            for ( int i = 1; i < loop; ++i, angle += angle_step )
+            if ( loop == 1 )
             {
-                rpos = rcsc::Vector2D::polar2vector( v.r_, angle );
-                path.lineTo( opt.screenX( ( v.x_ + rpos.x ) * reverse ),
-                             opt.screenY( ( v.y_ + rpos.y ) * reverse ) );
+                painter.drawPoint( points[0] );
+                continue;
             }
 
-            painter.drawPath( path );
+            painter.drawPolyline( points, loop );
         }
     }
 }
@@ -314,53 +382,51 @@ DebugLogPainter::drawCircles( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::CircleCont::const_reference v : log_data.filledCircleCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersectsCircle( v.x_, v.y_, v.r_ ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-                painter.setBrush( col );
-            }
-            else
+            set_pen_brush( painter, v.color_, dconf.debugShapePen(), current );
+
+            const QPointF center( transform.screenX( v.x_ ),
+                                  transform.screenY( v.y_ ) );
+            if ( viewport.isSubPixel( v.r_ * 2.0 ) )
             {
-                painter.setPen( dconf.debugShapePen() );
-                painter.setBrush( dconf.debugShapePen().color() );
+                draw_dot( painter, center );
+                continue;
             }
 
-            double r = opt.scale( v.r_ );
-            painter.drawEllipse( QRectF( opt.screenX( ( v.x_ - v.r_ ) * reverse ),
-                                         opt.screenY( ( v.y_ - v.r_ ) * reverse ),
-                                         r * 2, r * 2 ) );
+            const double r = transform.scale( v.r_ );
+            painter.drawEllipse( center, r, r );
         }
     }
 
     painter.setBrush( dconf.transparentBrush() );
 
+    current = ~ColorTable::ID( 0 );
     for ( DebugLogData::CircleCont::const_reference v : log_data.circleCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersectsCircle( v.x_, v.y_, v.r_ ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
+            set_pen( painter, v.color_, dconf.debugShapePen(), current );
+
+            const QPointF center( transform.screenX( v.x_ ),
+                                  transform.screenY( v.y_ ) );
+            if ( viewport.isSubPixel( v.r_ * 2.0 ) )
             {
-                painter.setPen( dconf.debugShapePen() );
+                draw_dot( painter, center );
+                continue;
             }
 
-            double r = opt.scale( v.r_ );
-            painter.drawEllipse( QRectF( opt.screenX( ( v.x_ - v.r_ ) * reverse ),
-                                         opt.screenY( ( v.y_ - v.r_ ) * reverse ),
-                                         r * 2, r * 2 ) );
+            const double r = transform.scale( v.r_ );
+            painter.drawEllipse( center, r, r );
         }
     }
 }
@@ -379,33 +445,28 @@ DebugLogPainter::drawTriangles( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::TriangleCont::const_reference v : log_data.filledTriangleCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersects( std::min( { v.x1_, v.x2_, v.x3_ } ),
+                                     std::min( { v.y1_, v.y2_, v.y3_ } ),
+                                     std::max( { v.x1_, v.x2_, v.x3_ } ),
+                                     std::max( { v.y1_, v.y2_, v.y3_ } ) ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-                painter.setBrush( col );
-            }
-            else
-            {
-                painter.setPen( dconf.debugShapePen() );
-                painter.setBrush( dconf.debugShapePen().color() );
-            }
+            set_pen_brush( painter, v.color_, dconf.debugShapePen(), current );
 
             QPointF points[4];
-            points[0].setX( opt.screenX( v.x1_ * reverse ) );
-            points[0].setY( opt.screenY( v.y1_ * reverse ) );
-            points[1].setX( opt.screenX( v.x2_ * reverse ) );
-            points[1].setY( opt.screenY( v.y2_ * reverse ) );
-            points[2].setX( opt.screenX( v.x3_ * reverse ) );
-            points[2].setY( opt.screenY( v.y3_ * reverse ) );
+            points[0].setX( transform.screenX( v.x1_ ) );
+            points[0].setY( transform.screenY( v.y1_ ) );
+            points[1].setX( transform.screenX( v.x2_ ) );
+            points[1].setY( transform.screenY( v.y2_ ) );
+            points[2].setX( transform.screenX( v.x3_ ) );
+            points[2].setY( transform.screenY( v.y3_ ) );
             points[3] = points[0];
 
             painter.drawPolyline( points, 4 );
@@ -414,27 +475,24 @@ DebugLogPainter::drawTriangles( QPainter & painter,
 
     painter.setBrush( dconf.transparentBrush() );
 
+    current = ~ColorTable::ID( 0 );
     for ( DebugLogData::TriangleCont::const_reference v : log_data.triangleCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersects( std::min( { v.x1_, v.x2_, v.x3_ } ),
+                                     std::min( { v.y1_, v.y2_, v.y3_ } ),
+                                     std::max( { v.x1_, v.x2_, v.x3_ } ),
+                                     std::max( { v.y1_, v.y2_, v.y3_ } ) ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
-            {
-                painter.setPen( dconf.debugShapePen() );
-            }
+            set_pen( painter, v.color_, dconf.debugShapePen(), current );
 
             QPointF points[4];
-            points[0].setX( opt.screenX( v.x1_ * reverse ) );
-            points[0].setY( opt.screenY( v.y1_ * reverse ) );
-            points[1].setX( opt.screenX( v.x2_ * reverse ) );
-            points[1].setY( opt.screenY( v.y2_ * reverse ) );
-            points[2].setX( opt.screenX( v.x3_ * reverse ) );
-            points[2].setY( opt.screenY( v.y3_ * reverse ) );
+            points[0].setX( transform.screenX( v.x1_ ) );
+            points[0].setY( transform.screenY( v.y1_ ) );
+            points[1].setX( transform.screenX( v.x2_ ) );
+            points[1].setY( transform.screenY( v.y2_ ) );
+            points[2].setX( transform.screenX( v.x3_ ) );
+            points[2].setY( transform.screenY( v.y3_ ) );
             points[3] = points[0];
 
             painter.drawPolyline( points, 4 );
@@ -456,53 +514,49 @@ DebugLogPainter::drawRectangles( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::RectCont::const_reference v : log_data.filledRectCont() )
     {
         if ( level & v.level_ )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
+            const QRectF rect( transform.screenX( v.left_ ),
+                               transform.screenY( v.top_ ),
+                               transform.scale( v.width_ ),
+                               transform.scale( v.height_ ) );
+            if ( ! viewport.intersectsScreen( rect.left(), rect.top(), rect.right(), rect.bottom() ) )
             {
-                painter.setPen( col );
-                painter.setBrush( col );
-            }
-            else
-            {
-                painter.setPen( dconf.debugShapePen() );
-                painter.setBrush( dconf.debugShapePen().color() );
+                continue;
             }
 
-            painter.drawRect( QRectF( opt.screenX( v.left_ * reverse ),
-                                      opt.screenY( v.top_ * reverse ),
-                                      opt.scale( v.width_ ),
-                                      opt.scale( v.height_ ) ) );
+            set_pen_brush( painter, v.color_, dconf.debugShapePen(), current );
+
+            painter.drawRect( rect );
         }
     }
 
     painter.setBrush( dconf.transparentBrush() );
 
+    current = ~ColorTable::ID( 0 );
     for ( DebugLogData::RectCont::const_reference v : log_data.rectCont() )
     {
         if ( level & v.level_ )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
+            const QRectF rect( transform.screenX( v.left_ ),
+                               transform.screenY( v.top_ ),
+                               transform.scale( v.width_ ),
+                               transform.scale( v.height_ ) );
+            if ( ! viewport.intersectsScreen( rect.left(), rect.top(), rect.right(), rect.bottom() ) )
             {
-                painter.setPen( dconf.debugShapePen() );
+                continue;
             }
 
-            painter.drawRect( QRectF( opt.screenX( v.left_ * reverse ),
-                                      opt.screenY( v.top_ * reverse ),
-                                      opt.scale( v.width_ ),
-                                      opt.scale( v.height_ ) ) );
+            set_pen( painter, v.color_, dconf.debugShapePen(), current );
+
+            painter.drawRect( rect );
         }
     }
 }
@@ -514,17 +568,21 @@ namespace {
 */
 void
 draw_sector( QPainter & painter,
-             const rcsc::SideID player_side,
+             const Viewport & viewport,
              const DebugLogData::SectorT & sector )
 {
-    const Options & opt = Options::instance();
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const ScreenTransform & transform = viewport.transform();
+
+    if ( viewport.isSubPixel( sector.max_r_ * 2.0 ) )
+    {
+        draw_dot( painter, QPointF( transform.screenX( sector.x_ ),
+                                    transform.screenY( sector.y_ ) ) );
+        return;
+    }
 
     const double circumference_factor = ( 2.0 * M_PI ) * std::fabs( sector.span_angle_ / 360.0 );
-    const double min_len = ( sector.min_r_ * opt.fieldScale() ) * circumference_factor;
-    const double max_len = ( sector.max_r_ * opt.fieldScale() ) * circumference_factor;
+    const double min_len = transform.scale( sector.min_r_ ) * circumference_factor;
+    const double max_len = transform.scale( sector.max_r_ ) * circumference_factor;
 
     const int min_min_loop = ( sector.span_angle_ < 1.0
                                ? 1
@@ -540,10 +598,10 @@ draw_sector( QPainter & painter,
 
     const int min_loop = std::min( std::max( min_min_loop,
                                              static_cast< int >( rint( min_len / 32.0 ) ) ),
-                                   18 );
+                                   MAX_ARC_LOOP );
     const int max_loop = std::min( std::max( min_min_loop,
                                              static_cast< int >( rint( max_len / 32.0 ) ) ),
-                                   18 );
+                                   MAX_ARC_LOOP );
 
     const double min_angle_step = ( min_loop == 1
                                     ? 0.0
@@ -552,20 +610,20 @@ draw_sector( QPainter & painter,
                                     ? 0.0
                                     : sector.span_angle_ / ( max_loop - 1 ) );
 
-    QPainterPath path;
+    // the outer arc, the inner end of its last ray and the inner arc
+    QPointF points[MAX_ARC_LOOP * 2 + 1];
+    int n = 0;
 
     rcsc::AngleDeg angle = sector.start_angle_;
 
     rcsc::Vector2D rpos = rcsc::Vector2D::polar2vector( sector.max_r_, angle );
-    path.moveTo( opt.screenX( ( sector.x_ + rpos.x ) * reverse ),
-                 opt.screenY( ( sector.y_ + rpos.y ) * reverse ) );
+    points[n++] = QPointF( sector.x_ + rpos.x, sector.y_ + rpos.y );
 
     angle += max_angle_step;
     for ( int i = 1; i < max_loop; ++i, angle += max_angle_step )
     {
         rpos = rcsc::Vector2D::polar2vector( sector.max_r_, angle );
-        path.lineTo( opt.screenX( ( sector.x_ + rpos.x  ) * reverse ),
-                     opt.screenY( ( sector.y_ + rpos.y ) * reverse ) );
+        points[n++] = QPointF( sector.x_ + rpos.x, sector.y_ + rpos.y );
     }
 
     if ( sector.max_r_ <= 1.0e-5 )
@@ -577,20 +635,18 @@ draw_sector( QPainter & painter,
         rpos *= sector.min_r_ / sector.max_r_;
     }
 
-    path.lineTo( opt.screenX( ( sector.x_ + rpos.x  ) * reverse ),
-                 opt.screenY( ( sector.y_ + rpos.y ) * reverse ) );
+    points[n++] = QPointF( sector.x_ + rpos.x, sector.y_ + rpos.y );
 
     angle -= min_angle_step;
     for ( int i = 0; i < min_loop; ++i, angle -= min_angle_step )
     {
         rpos = rcsc::Vector2D::polar2vector( sector.min_r_, angle );
-        path.lineTo( opt.screenX( ( sector.x_ + rpos.x  ) * reverse ),
-                     opt.screenY( ( sector.y_ + rpos.y ) * reverse ) );
+        points[n++] = QPointF( sector.x_ + rpos.x, sector.y_ + rpos.y );
     }
 
-    path.closeSubpath();
+    map_to_screen( transform, points, n );
 
-    painter.drawPath( path );
+    painter.drawPolygon( points, n );
 }
 
 }
@@ -607,45 +663,35 @@ DebugLogPainter::drawSectors( QPainter & painter,
 {
     const int level = M_main_data.debugLogHolder().level();
 
+    const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::SectorCont::const_reference v : log_data.filledSectorCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersectsCircle( v.x_, v.y_, v.max_r_ ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-                painter.setBrush( col );
-            }
-            else
-            {
-                painter.setPen( dconf.debugShapePen() );
-                painter.setBrush( dconf.debugShapePen().color() );
-            }
+            set_pen_brush( painter, v.color_, dconf.debugShapePen(), current );
 
-            draw_sector( painter, player_side, v );
+            draw_sector( painter, viewport, v );
         }
     }
 
     painter.setBrush( dconf.transparentBrush() );
 
+    current = ~ColorTable::ID( 0 );
     for ( DebugLogData::SectorCont::const_reference v : log_data.sectorCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.intersectsCircle( v.x_, v.y_, v.max_r_ ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
-            {
-                painter.setPen( dconf.debugShapePen() );
-            }
+            set_pen( painter, v.color_, dconf.debugShapePen(), current );
 
-            draw_sector( painter, player_side, v );
+            draw_sector( painter, viewport, v );
         }
     }
 }
@@ -664,29 +710,23 @@ DebugLogPainter::drawMessages( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( player_side != rcsc::LEFT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     painter.setFont( dconf.debugLogMessageFont() );
     painter.setBrush( dconf.transparentBrush() );
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( DebugLogData::MessageCont::const_reference v : log_data.messageCont() )
     {
-        if ( level & v.level_ )
+        if ( ( level & v.level_ )
+             && viewport.contains( v.x_, v.y_, TEXT_MARGIN ) )
         {
-            QColor col( v.color_.c_str() );
-            if ( col.isValid() )
-            {
-                painter.setPen( col );
-            }
-            else
-            {
-                painter.setPen( dconf.debugLogMessageFontPen() );
-            }
+            set_pen( painter, v.color_, dconf.debugLogMessageFontPen(), current );
 
-            painter.drawText( QPointF( opt.screenX( v.x_ * reverse ),
-                                       opt.screenY( v.y_ * reverse ) ),
+            painter.drawText( QPointF( transform.screenX( v.x_ ),
+                                       transform.screenY( v.y_ ) ),
                               QString::fromStdString( v.message_ ) );
         }
     }
@@ -716,17 +756,15 @@ DebugLogPainter::drawActionSequence( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( player_side == rcsc::LEFT
-                             ? 1.0
-                             : -1.0 );
+    const ScreenTransform transform = opt.screenTransform().mirrored( player_side != rcsc::LEFT );
 
     painter.setBrush( dconf.transparentBrush() );
 
-    double r = opt.scale( 0.5 );
+    double r = transform.scale( 0.5 );
     for ( const ActionDescription & v : ptr->actions() )
     {
-        QPointF to( opt.screenX( v.toPos().x * reverse ),
-                    opt.screenY( v.toPos().y * reverse ) );
+        QPointF to( transform.screenX( v.toPos().x ),
+                    transform.screenY( v.toPos().y ) );
 
         if ( v.category() == ActionDescription::PASS )
         {
@@ -737,8 +775,8 @@ DebugLogPainter::drawActionSequence( QPainter & painter,
             painter.setPen( dconf.debugActionSequencePen() );
         }
 
-        painter.drawLine( QPointF( opt.screenX( v.fromPos().x * reverse ),
-                                   opt.screenY( v.fromPos().y * reverse ) ),
+        painter.drawLine( QPointF( transform.screenX( v.fromPos().x ),
+                                   transform.screenY( v.fromPos().y ) ),
                           to );
         painter.drawEllipse( to, r, r );
     }
@@ -746,13 +784,13 @@ DebugLogPainter::drawActionSequence( QPainter & painter,
     painter.setPen( dconf.debugLogMessageFontPen() );
     for ( const ActionDescription & v : ptr->actions() )
     {
-        QPointF to( opt.screenX( v.toPos().x * reverse ) + r,
-                    opt.screenY( v.toPos().y * reverse ) + r );
+        QPointF to( transform.screenX( v.toPos().x ) + r,
+                    transform.screenY( v.toPos().y ) + r );
         painter.drawText( to, QString( "%1,%2" ).arg( v.safeLevel() ).arg( v.value() ) );
     }
 
-    QPointF text_pos( opt.screenX( ptr->actions().back().toPos().x * reverse ) + r,
-                      opt.screenY( ptr->actions().back().toPos().y * reverse ) - r );
+    QPointF text_pos( transform.screenX( ptr->actions().back().toPos().x ) + r,
+                      transform.screenY( ptr->actions().back().toPos().y ) - r );
 
     painter.setPen( dconf.debugActionSequencePen() );
     painter.drawText( text_pos, QString::number( ptr->value() ) );
@@ -44,13 +44,17 @@
 #include "debug_painter.h"
 
 #include "draw_config.h"
+#include "screen_points.h"
 // model
 #include "options.h"
+#include "viewport.h"
 #include "main_data.h"
 
 #include <rcsc/common/server_param.h>
 #include <rcsc/geom/angle_deg.h>
 
+#include <algorithm>
+#include <vector>
 #include <iostream>
 #include <cmath>
 
@@ -119,7 +123,7 @@ draw_communication( QPainter & painter,
         painter.setPen( Qt::darkMagenta );
         painter.setBrush( dconf.transparentBrush() );
 
-        for ( std::map< int, std::string >::const_reference hear : debug_view.hearMessages() )
+        for ( std::map< int, PooledString >::const_reference hear : debug_view.hearMessages() )
         {
             for ( const rcsc::rcg::PlayerT & p : players )
             {
@@ -277,7 +281,7 @@ DebugPainter::draw( QPainter & painter )
     // draw shapes
     if ( opt.showDebugViewShape() )
     {
-        if ( opt.antiAliasing() )
+        if ( opt.renderAntiAliasing() )
         {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
             painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -293,7 +297,7 @@ DebugPainter::draw( QPainter & painter )
         drawRectangles( painter, self_side, *view );
         drawCircles( painter, self_side, *view );
 
-        if ( opt.antiAliasing() )
+        if ( opt.renderAntiAliasing() )
         {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
             painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -416,7 +420,7 @@ DebugPainter::drawSelf( QPainter & painter,
 
         painter.drawText( QPointF( sx - r,
                                    sy + r + painter.fontMetrics().ascent() ),
-                          QString::fromStdString( self->comment_ ) );
+                          QString::fromStdString( self->comment_.str() ) );
     }
 }
 
@@ -463,7 +467,7 @@ DebugPainter::drawBall( QPainter & painter,
                                  r * 2, r * 2 ) );
 
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -523,7 +527,7 @@ DebugPainter::drawBall( QPainter & painter,
 #endif
 
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -543,7 +547,7 @@ DebugPainter::drawBall( QPainter & painter,
 
         painter.drawText( QPointF( p.x() - r,
                                    p.y() + r + painter.fontMetrics().ascent() ),
-                          QString::fromStdString( ball->comment_ ) );
+                          QString::fromStdString( ball->comment_.str() ) );
     }
 }
 
@@ -664,7 +668,7 @@ DebugPainter::drawPlayers( QPainter & painter,
 
             painter.drawText( QPointF( pos.x() - r,
                                        pos.y() + r + painter.fontMetrics().ascent() ),
-                              QString::fromStdString( pl->comment_ ) );
+                              QString::fromStdString( pl->comment_.str() ) );
         }
     }
 }
@@ -767,16 +771,31 @@ DebugPainter::drawLines( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( self_side == rcsc::RIGHT
-                             ? -1.0
-                             : 1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( self_side == rcsc::RIGHT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     // painter.setPen( dconf.debugShapePen() );
     painter.setBrush( dconf.transparentBrush() );
 
+    std::vector< QLineF > lines;
+    lines.reserve( view.lines().size() );
+    for ( const DebugViewData::LineT & line : view.lines() )
+    {
+        lines.push_back( QLineF( line.x1_, line.y1_, line.x2_, line.y2_ ) );
+    }
+    map_to_screen( transform, lines.data(), lines.size() );
+
 // #ifdef USE_GL_WIDGET
+    std::vector< QLineF >::const_iterator l = lines.begin();
     for ( const DebugViewData::LineT & line : view.lines() )
     {
+        if ( ! viewport.intersectsScreen( l->x1(), l->y1(), l->x2(), l->y2() ) )
+        {
+            ++l;
+            continue;
+        }
+
         if ( line.color_.empty() )
         {
             painter.setPen( dconf.debugShapePen() );
@@ -793,10 +812,8 @@ DebugPainter::drawLines( QPainter & painter,
                 painter.setPen( dconf.debugShapePen() );
             }
         }
-        painter.drawLine( QLineF( opt.screenX( line.x1_ * reverse ),
-                                  opt.screenY( line.y1_ * reverse ),
-                                  opt.screenX( line.x2_ * reverse ),
-                                  opt.screenY( line.y2_ * reverse ) ) );
+        painter.drawLine( *l );
+        ++l;
     }
 // #else
 //     QPainterPath path;
@@ -830,9 +847,9 @@ DebugPainter::drawTriangles( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( self_side == rcsc::RIGHT
-                             ? -1.0
-                             : 1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( self_side == rcsc::RIGHT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     // painter.setPen( dconf.debugShapePen() );
     painter.setBrush( dconf.transparentBrush() );
@@ -840,15 +857,23 @@ DebugPainter::drawTriangles( QPainter & painter,
 // #ifdef USE_GLWIDGET
     for ( const DebugViewData::TriangleT & tri : view.triangles() )
     {
+        if ( ! viewport.intersects( std::min( { tri.x1_, tri.x2_, tri.x3_ } ),
+                                    std::min( { tri.y1_, tri.y2_, tri.y3_ } ),
+                                    std::max( { tri.x1_, tri.x2_, tri.x3_ } ),
+                                    std::max( { tri.y1_, tri.y2_, tri.y3_ } ) ) )
+        {
+            continue;
+        }
+
         std::cerr << "triangle (" << tri.x1_ << ',' << tri.y1_ << ")("
                   << '(' << tri.x2_ << ',' << tri.y2_ << ")("
                   << '(' << tri.x3_ << ',' << tri.y3_ << ")" << std::endl;
-        QPointF points[4] = { QPointF( opt.screenX( tri.x1_ * reverse ),
-                                       opt.screenY( tri.y1_ * reverse ) ),
-                              QPointF( opt.screenX( tri.x2_ * reverse ),
-                                       opt.screenY( tri.y2_ * reverse ) ),
-                              QPointF( opt.screenX( tri.x3_ * reverse ),
-                                       opt.screenY( tri.y3_ * reverse ) ) };
+        QPointF points[4] = { QPointF( transform.screenX( tri.x1_ ),
+                                       transform.screenY( tri.y1_ ) ),
+                              QPointF( transform.screenX( tri.x2_ ),
+                                       transform.screenY( tri.y2_ ) ),
+                              QPointF( transform.screenX( tri.x3_ ),
+                                       transform.screenY( tri.y3_ ) ) };
         if ( tri.color_.empty() )
         {
             painter.setPen( dconf.debugShapePen() );
@@ -909,9 +934,9 @@ DebugPainter::drawRectangles( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( self_side == rcsc::RIGHT
-                             ? -1.0
-                             : 1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( self_side == rcsc::RIGHT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     // painter.setPen( dconf.debugShapePen() );
     painter.setBrush( dconf.transparentBrush() );
@@ -919,10 +944,15 @@ DebugPainter::drawRectangles( QPainter & painter,
 // #ifdef USE_GLWIDGET
     for ( const DebugViewData::RectT & rect : view.rectangles() )
     {
-        double left_x = opt.screenX( rect.left_x_ * reverse );
-        double top_y = opt.screenY( rect.top_y_ * reverse );
-        double right_x = opt.screenX( rect.right_x_ * reverse );
-        double bottom_y = opt.screenY( rect.bottom_y_ * reverse );
+        if ( ! viewport.intersects( rect.left_x_, rect.top_y_, rect.right_x_, rect.bottom_y_ ) )
+        {
+            continue;
+        }
+
+        double left_x = transform.screenX( rect.left_x_ );
+        double top_y = transform.screenY( rect.top_y_ );
+        double right_x = transform.screenX( rect.right_x_ );
+        double bottom_y = transform.screenY( rect.bottom_y_ );
 
         if ( rect.color_.empty() )
         {
@@ -982,9 +1012,9 @@ DebugPainter::drawCircles( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    const double reverse = ( self_side == rcsc::RIGHT
-                             ? -1.0
-                             : 1.0 );
+    const Viewport viewport( opt.screenTransform().mirrored( self_side == rcsc::RIGHT ),
+                             opt.canvasWidth(), opt.canvasHeight() );
+    const ScreenTransform & transform = viewport.transform();
 
     // painter.setPen( dconf.debugShapePen() );
     painter.setBrush( dconf.transparentBrush() );
@@ -992,7 +1022,12 @@ DebugPainter::drawCircles( QPainter & painter,
 // #ifdef USE_GLWIDGET
     for ( const DebugViewData::CircleT & c : view.circles() )
     {
-        double r = opt.scale( c.radius_ );
+        if ( ! viewport.intersectsCircle( c.center_x_, c.center_y_, c.radius_ ) )
+        {
+            continue;
+        }
+
+        double r = transform.scale( c.radius_ );
 
         if ( c.color_.empty() )
         {
@@ -1010,8 +1045,15 @@ DebugPainter::drawCircles( QPainter & painter,
                 painter.setPen( dconf.debugShapePen() );
             }
         }
-        painter.drawEllipse( QRectF( opt.screenX( c.center_x_ * reverse ) - r,
-                                     opt.screenY( c.center_y_ * reverse ) - r,
+        if ( viewport.isSubPixel( c.radius_ * 2.0 ) )
+        {
+            draw_dot( painter, QPointF( transform.screenX( c.center_x_ ),
+                                        transform.screenY( c.center_y_ ) ) );
+            continue;
+        }
+
+        painter.drawEllipse( QRectF( transform.screenX( c.center_x_ ) - r,
+                                     transform.screenY( c.center_y_ ) - r,
                                      r * 2,
                                      r * 2 ) );
     }
@@ -1052,7 +1094,7 @@ DebugPainter::drawMessage( QPainter & painter,
     {
         painter.drawText( rect,
                           Qt::AlignLeft | Qt::TextWordWrap,
-                          QString::fromStdString( view.message() ),
+                          QString::fromStdString( view.message().str() ),
                           &bounding_rect );
         rect.setRect( 10, bounding_rect.bottom() + 1,
                       win.width() - 20,
@@ -1062,7 +1104,7 @@ DebugPainter::drawMessage( QPainter & painter,
     if ( ! view.sayMessage().empty() )
     {
         QString text = QObject::tr( "Say: " );
-        text += QString::fromStdString( view.sayMessage() );
+        text += QString::fromStdString( view.sayMessage().str() );
 
         painter.drawText( rect, Qt::AlignLeft, text, &bounding_rect );
         rect.setRect( 10, bounding_rect.bottom() + 1,
@@ -1074,10 +1116,10 @@ DebugPainter::drawMessage( QPainter & painter,
     {
         QString text = QObject::tr( "Hear: " );
 
-        for ( std::map< int, std::string >::const_reference hear : view.hearMessages() )
+        for ( std::map< int, PooledString >::const_reference hear : view.hearMessages() )
         {
             text += QString( "(%1" ).arg( hear.first );
-            text += QString::fromStdString( hear.second );
+            text += QString::fromStdString( hear.second.str() );
             text += QObject::tr( ")" );
         }
 
@@ -34,12 +34,37 @@
 #endif
 
 #include <QtNetwork>
+#include <QTimer>
 
 #include "debug_server.h"
 
 #include "main_data.h"
+#include "options.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
+
+namespace {
+
+//! size of the frame length header (32bit unsigned, network byte order)
+const qint64 FRAME_HEADER_SIZE = 4;
+
+//! the maximum number of frames delivered in one event loop iteration
+const int FRAME_BUDGET = 64;
+
+inline
+quint32
+frame_length( const QByteArray & header )
+{
+    const unsigned char * p = reinterpret_cast< const unsigned char * >( header.constData() );
+    return ( static_cast< quint32 >( p[0] ) << 24 )
+        | ( static_cast< quint32 >( p[1] ) << 16 )
+        | ( static_cast< quint32 >( p[2] ) << 8 )
+        | ( static_cast< quint32 >( p[3] ) );
+}
+
+}
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -50,9 +75,62 @@ DebugServer::DebugServer( QObject * parent,
                           const int port )
 
     : QObject( parent ),
-      M_socket( new QUdpSocket( this ) ),
+      M_socket( static_cast< QUdpSocket * >( 0 ) ),
+      M_tcp_server( static_cast< QTcpServer * >( 0 ) ),
+      M_local_server( static_cast< QLocalServer * >( 0 ) ),
+      M_stream_pending( false ),
       M_main_data( main_data )
 {
+    switch ( Options::instance().debugServerTransport() ) {
+    case Options::DEBUG_SERVER_TCP:
+        openTcp( port );
+        break;
+    case Options::DEBUG_SERVER_UNIX:
+        openLocal( QString::fromStdString( Options::instance().debugServerSocket() ) );
+        break;
+    case Options::DEBUG_SERVER_UDP:
+    default:
+        openUdp( port );
+        break;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  destructor.
+*/
+DebugServer::~DebugServer()
+{
+    if ( M_socket
+         && isConnected() )
+    {
+        M_socket->close();
+    }
+
+    if ( M_tcp_server
+         || M_local_server )
+    {
+        std::cerr << "debug server stream:"
+                  << " frames=" << M_stream_stats.frames_
+                  << " bytes=" << M_stream_stats.bytes_
+                  << " max_frame=" << M_stream_stats.max_frame_size_
+                  << " max_pending=" << M_stream_stats.max_pending_bytes_
+                  << " deferred=" << M_stream_stats.deferred_
+                  << " rejected=" << M_stream_stats.rejected_
+                  << std::endl;
+    }
+    //std::cerr << "delete DebugServer" << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::openUdp( const int port )
+{
+    M_socket = new QUdpSocket( this );
+
     if ( ! M_socket->bind( port ) )
     {
 
@@ -71,15 +149,48 @@ DebugServer::DebugServer( QObject * parent,
 
 /*-------------------------------------------------------------------*/
 /*!
-  destructor.
+
 */
-DebugServer::~DebugServer()
+void
+DebugServer::openTcp( const int port )
 {
-    if ( isConnected() )
+    M_tcp_server = new QTcpServer( this );
+
+    if ( ! M_tcp_server->listen( QHostAddress::LocalHost, port ) )
     {
-        M_socket->close();
+        std::cerr << __FILE__ << ": failed to listen the tcp port " << port
+                  << " : " << M_tcp_server->errorString().toStdString()
+                  << std::endl;
+        return;
     }
-    //std::cerr << "delete DebugServer" << std::endl;
+
+    connect( M_tcp_server, SIGNAL( newConnection() ),
+             this, SLOT( handleNewTcpConnection() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::openLocal( const QString & name )
+{
+    M_local_server = new QLocalServer( this );
+
+    // remove the stale socket file left by a crashed process
+    QLocalServer::removeServer( name );
+
+    if ( ! M_local_server->listen( name ) )
+    {
+        std::cerr << __FILE__ << ": failed to listen the local socket ["
+                  << name.toStdString() << "] : "
+                  << M_local_server->errorString().toStdString()
+                  << std::endl;
+        return;
+    }
+
+    connect( M_local_server, SIGNAL( newConnection() ),
+             this, SLOT( handleNewLocalConnection() ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -89,7 +200,18 @@ DebugServer::~DebugServer()
 bool
 DebugServer::isConnected() const
 {
-    return ( M_socket->socketDescriptor() != -1 );
+    if ( M_tcp_server )
+    {
+        return M_tcp_server->isListening();
+    }
+
+    if ( M_local_server )
+    {
+        return M_local_server->isListening();
+    }
+
+    return ( M_socket
+             && M_socket->socketDescriptor() != -1 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -99,15 +221,220 @@ DebugServer::isConnected() const
 void
 DebugServer::handleReceive()
 {
-    char buf[8192];
+    std::vector< char > buf( 8192 );
 
     while ( M_socket->hasPendingDatagrams() )
     {
-        int n = M_socket->readDatagram( buf, sizeof( buf ) );
+        const qint64 size = M_socket->pendingDatagramSize();
+        if ( size >= static_cast< qint64 >( buf.size() ) )
+        {
+            buf.resize( size + 1 );
+        }
+
+        int n = M_socket->readDatagram( &buf[0], buf.size() - 1 );
         if ( n > 0 )
         {
             buf[n] = '\0';
-            M_main_data.receiveDebugClientPacket( buf );
+            M_main_data.receiveDebugClientPacket( &buf[0] );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::handleNewTcpConnection()
+{
+    while ( M_tcp_server->hasPendingConnections() )
+    {
+        QTcpSocket * socket = M_tcp_server->nextPendingConnection();
+
+        // limit the userland buffer to one frame.
+        // the kernel buffer and the sender are blocked while it is full.
+        socket->setReadBufferSize( Options::instance().debugServerMaxFrameSize() + FRAME_HEADER_SIZE );
+
+        addStream( socket );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::handleNewLocalConnection()
+{
+    while ( M_local_server->hasPendingConnections() )
+    {
+        QLocalSocket * socket = M_local_server->nextPendingConnection();
+
+        socket->setReadBufferSize( Options::instance().debugServerMaxFrameSize() + FRAME_HEADER_SIZE );
+
+        addStream( socket );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::addStream( QIODevice * dev )
+{
+    M_streams.push_back( dev );
+
+    connect( dev, SIGNAL( readyRead() ),
+             this, SLOT( handleStreamReceive() ) );
+    connect( dev, SIGNAL( disconnected() ),
+             this, SLOT( handleStreamDisconnected() ) );
+
+    std::cerr << "debug server: accepted a stream connection. total "
+              << M_streams.size() << std::endl;
+
+    if ( dev->bytesAvailable() > 0 )
+    {
+        readFrames( dev, FRAME_BUDGET );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::handleStreamReceive()
+{
+    QIODevice * dev = qobject_cast< QIODevice * >( sender() );
+    if ( ! dev )
+    {
+        return;
+    }
+
+    readFrames( dev, FRAME_BUDGET );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::handleStreamPending()
+{
+    M_stream_pending = false;
+
+    // readFrames() may close the connection and modify M_streams.
+    const QList< QIODevice * > streams = M_streams;
+    for ( QIODevice * dev : streams )
+    {
+        readFrames( dev, FRAME_BUDGET );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DebugServer::handleStreamDisconnected()
+{
+    QIODevice * dev = qobject_cast< QIODevice * >( sender() );
+    if ( ! dev )
+    {
+        return;
+    }
+
+    // deliver the frames that have already been received.
+    while ( readFrames( dev, FRAME_BUDGET ) > 0 )
+    {
+
+    }
+
+    M_streams.removeAll( dev );
+    dev->deleteLater();
+
+    std::cerr << "debug server: a stream connection closed. total "
+              << M_streams.size() << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DebugServer::hasCompleteFrame( QIODevice * dev ) const
+{
+    const qint64 available = dev->bytesAvailable();
+    if ( available < FRAME_HEADER_SIZE )
+    {
+        return false;
+    }
+
+    return available >= FRAME_HEADER_SIZE + frame_length( dev->peek( FRAME_HEADER_SIZE ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+DebugServer::readFrames( QIODevice * dev,
+                         const int budget )
+{
+    const qint64 max_frame_size = Options::instance().debugServerMaxFrameSize();
+
+    M_stream_stats.max_pending_bytes_ = std::max( M_stream_stats.max_pending_bytes_,
+                                                  dev->bytesAvailable() );
+
+    int count = 0;
+    while ( count < budget
+            && dev->bytesAvailable() >= FRAME_HEADER_SIZE )
+    {
+        const qint64 length = frame_length( dev->peek( FRAME_HEADER_SIZE ) );
+
+        if ( length > max_frame_size )
+        {
+            std::cerr << __FILE__ << ": (readFrames) too large frame " << length
+                      << " > " << max_frame_size << ". close the connection."
+                      << std::endl;
+            ++M_stream_stats.rejected_;
+            dev->close();
+            return count;
+        }
+
+        if ( dev->bytesAvailable() < FRAME_HEADER_SIZE + length )
+        {
+            // wait the rest of this frame
+            break;
+        }
+
+        dev->read( FRAME_HEADER_SIZE );
+        // QByteArray is always null terminated.
+        const QByteArray payload = dev->read( length );
+
+        ++count;
+        ++M_stream_stats.frames_;
+        M_stream_stats.bytes_ += payload.size();
+        M_stream_stats.max_frame_size_ = std::max( M_stream_stats.max_frame_size_,
+                                                   static_cast< qint64 >( payload.size() ) );
+
+        if ( ! payload.isEmpty() )
+        {
+            M_main_data.receiveDebugClientPacket( payload.constData() );
         }
     }
+
+    if ( count >= budget
+         && hasCompleteFrame( dev )
+         && ! M_stream_pending )
+    {
+        // readyRead() is not emitted again for the buffered data.
+        // continue in the next event loop iteration to keep the GUI responsive.
+        ++M_stream_stats.deferred_;
+        M_stream_pending = true;
+        QTimer::singleShot( 0, this, SLOT( handleStreamPending() ) );
+    }
+
+    return count;
 }
@@ -33,7 +33,11 @@
 #define SOCCERWINDOW2_QT_DEBUG_SERVER_H
 
 #include <QObject>
+#include <QList>
 
+class QIODevice;
+class QLocalServer;
+class QTcpServer;
 class QUdpSocket;
 
 class MainData;
@@ -45,9 +49,41 @@ class DebugServer
 
     Q_OBJECT
 
+public:
+
+    //! stream transport statistics
+    struct StreamStats {
+        qint64 frames_; //!< number of delivered frames
+        qint64 bytes_; //!< total payload size of delivered frames
+        qint64 max_frame_size_; //!< the largest payload size
+        qint64 max_pending_bytes_; //!< high-water mark of the buffered bytes on one connection
+        qint64 deferred_; //!< number of times the frame budget was exhausted
+        qint64 rejected_; //!< number of connections closed by an oversized frame
+
+        StreamStats()
+            : frames_( 0 ),
+              bytes_( 0 ),
+              max_frame_size_( 0 ),
+              max_pending_bytes_( 0 ),
+              deferred_( 0 ),
+              rejected_( 0 )
+          { }
+    };
+
 private:
     QUdpSocket * M_socket;
 
+    QTcpServer * M_tcp_server;
+    QLocalServer * M_local_server;
+
+    //! accepted stream connections
+    QList< QIODevice * > M_streams;
+
+    //! true while the deferred stream processing is scheduled
+    bool M_stream_pending;
+
+    StreamStats M_stream_stats;
+
     MainData & M_main_data;
 
     //! not used
@@ -65,10 +101,41 @@ public:
     //! check if socket is opened.
     bool isConnected() const;
 
+    const StreamStats & streamStats() const
+      {
+          return M_stream_stats;
+      }
+
+private:
+
+    void openUdp( const int port );
+    void openTcp( const int port );
+    void openLocal( const QString & name );
+
+    void addStream( QIODevice * dev );
+
+    /*!
+      \brief deliver complete frames buffered in the device.
+      \param dev stream device
+      \param budget the maximum number of frames to be delivered
+      \return the number of delivered frames
+     */
+    int readFrames( QIODevice * dev,
+                    const int budget );
+
+    bool hasCompleteFrame( QIODevice * dev ) const;
+
 private slots:
 
     void handleReceive();
 
+    void handleNewTcpConnection();
+    void handleNewLocalConnection();
+
+    void handleStreamReceive();
+    void handleStreamPending();
+    void handleStreamDisconnected();
+
 };
 
 #endif
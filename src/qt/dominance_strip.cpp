@@ -0,0 +1,261 @@
+// -*-c++-*-
+
+/*!
+  \file dominance_strip.cpp
+  \brief dominated area strip widget class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGlobal>
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QtWidgets>
+#else
+#include <QtGui>
+#endif
+
+#include "dominance_strip.h"
+
+#include "draw_config.h"
+// model
+#include "main_data.h"
+
+/*!
+  \class DominanceStrip::Task
+  \brief analyzes the view data in the worker thread.
+*/
+class DominanceStrip::Task
+    : public QRunnable {
+private:
+    DominanceStrip & M_strip;
+    const MonitorViewData::Cont M_views; //!< copied in the GUI thread
+    std::promise< AreasPtr > M_result;
+
+public:
+    Task( DominanceStrip & strip,
+          const MonitorViewData::Cont & views )
+        : M_strip( strip ),
+          M_views( views )
+      {
+          setAutoDelete( true );
+      }
+
+    std::future< AreasPtr > result()
+      {
+          return M_result.get_future();
+      }
+
+    void run() override
+      {
+          DominanceSeries & series = M_strip.M_series;
+          series.update( M_views );
+
+          std::shared_ptr< Areas > areas( new Areas );
+          areas->left_.reserve( series.size() );
+          areas->right_.reserve( series.size() );
+          for ( std::size_t i = 0; i < series.size(); ++i )
+          {
+              areas->left_.push_back( series.leftArea( i ) );
+              areas->right_.push_back( series.rightArea( i ) );
+          }
+
+          M_result.set_value( areas );
+          QMetaObject::invokeMethod( &M_strip, "handleFinished", Qt::QueuedConnection );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DominanceStrip::DominanceStrip( const MainData & main_data,
+                                QWidget * parent )
+    : QWidget( parent ),
+      M_main_data( main_data ),
+      M_areas( new Areas ),
+      M_last_size( 0 ),
+      M_generation( 0 ),
+      M_task_generation( 0 )
+{
+    // DominanceSeries uses several threads by itself.
+    M_pool.setMaxThreadCount( 1 );
+
+    this->setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Fixed );
+    this->setToolTip( tr( "Area dominated by each team" ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  the queued handleFinished() is discarded with this object.
+*/
+DominanceStrip::~DominanceStrip()
+{
+    M_pool.waitForDone();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+QSize
+DominanceStrip::sizeHint() const
+{
+    return QSize( 200, 10 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DominanceStrip::updateSeries()
+{
+    const MonitorViewData::Cont & vc = M_main_data.viewHolder().monitorViewCont();
+
+    const MonitorViewData::ConstPtr front = ( vc.empty() ? MonitorViewData::ConstPtr() : vc.front() );
+    const MonitorViewData::ConstPtr back = ( vc.empty() ? MonitorViewData::ConstPtr() : vc.back() );
+
+    if ( vc.size() != M_last_size
+         || front != M_last_front
+         || back != M_last_back )
+    {
+        M_last_size = vc.size();
+        M_last_front = front;
+        M_last_back = back;
+        ++M_generation;
+
+        // a running task is followed by the next one in handleFinished().
+        if ( ! M_result.valid() )
+        {
+            startTask();
+        }
+    }
+
+    // the current index line
+    this->update();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DominanceStrip::startTask()
+{
+    M_task_generation = M_generation;
+
+    Task * task = new Task( *this, M_main_data.viewHolder().monitorViewCont() );
+    M_result = task->result();
+    M_pool.start( task );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DominanceStrip::handleFinished()
+{
+    if ( ! M_result.valid() )
+    {
+        return;
+    }
+
+    M_areas = M_result.get();
+    this->update();
+
+    if ( M_task_generation != M_generation )
+    {
+        startTask();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DominanceStrip::paintEvent( QPaintEvent * )
+{
+    QPainter painter( this );
+
+    const int w = this->width();
+    const int h = this->height();
+    const Areas & areas = *M_areas;
+    const std::size_t size = areas.left_.size();
+
+    painter.fillRect( this->rect(), DrawConfig::instance().rightTeamBrush() );
+
+    if ( size == 0
+         || w <= 0 )
+    {
+        return;
+    }
+
+    //
+    // left team's share averaged in each column
+    //
+    QPolygonF polygon;
+    polygon.reserve( w + 2 );
+    polygon.push_back( QPointF( 0.0, 0.0 ) );
+
+    for ( int x = 0; x < w; ++x )
+    {
+        const std::size_t first = static_cast< std::size_t >( x ) * size / w;
+        const std::size_t last = std::max( first + 1,
+                                           static_cast< std::size_t >( x + 1 ) * size / w );
+        double left = 0.0;
+        double total = 0.0;
+        for ( std::size_t i = first; i < last && i < size; ++i )
+        {
+            left += areas.left_[i];
+            total += areas.left_[i] + areas.right_[i];
+        }
+
+        const double rate = ( total > 0.0 ? left / total : 0.5 );
+        polygon.push_back( QPointF( x, h * rate ) );
+    }
+
+    polygon.push_back( QPointF( w, 0.0 ) );
+
+    painter.setPen( Qt::NoPen );
+    painter.setBrush( DrawConfig::instance().leftTeamBrush() );
+    painter.drawPolygon( polygon );
+
+    //
+    // half line and current index
+    //
+    painter.setPen( QPen( Qt::gray, 0, Qt::DotLine ) );
+    painter.drawLine( QPointF( 0.0, h * 0.5 ), QPointF( w, h * 0.5 ) );
+
+    const double x = static_cast< double >( M_main_data.viewIndex() ) * w / size;
+    painter.setPen( QPen( Qt::black, 0 ) );
+    painter.drawLine( QPointF( x, 0.0 ), QPointF( x, h ) );
+}
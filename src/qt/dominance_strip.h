@@ -0,0 +1,136 @@
+// -*-c++-*-
+
+/*!
+  \file dominance_strip.h
+  \brief dominated area strip widget class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_DOMINANCE_STRIP_H
+#define SOCCERWINDOW2_QT_DOMINANCE_STRIP_H
+
+#include <QWidget>
+#include <QThreadPool>
+
+#include "dominance_series.h"
+
+#include <future>
+#include <memory>
+#include <vector>
+
+class QPaintEvent;
+
+class MainData;
+
+/*!
+  \class DominanceStrip
+  \brief plots the share of the area dominated by each team over the whole match.
+
+  The upper part of each column is the left team's share and the lower
+  part is the right team's share. The current cycle is marked by a line.
+
+  The series is analyzed by a worker thread so that the slider does not
+  wait for a long log. Only one task runs at a time. A request made while
+  the task is running is handled by the next task after the result is
+  applied in the GUI thread.
+*/
+class DominanceStrip
+    : public QWidget {
+
+    Q_OBJECT
+
+private:
+
+    //! the team areas in each view data
+    struct Areas {
+        std::vector< float > left_;
+        std::vector< float > right_;
+    };
+
+    typedef std::shared_ptr< const Areas > AreasPtr;
+
+    class Task;
+    friend class Task;
+
+    const MainData & M_main_data;
+
+    //! used only by the running task
+    DominanceSeries M_series;
+
+    //! the areas drawn by paintEvent()
+    AreasPtr M_areas;
+
+    //! the view data of the last request. used to skip the unchanged data.
+    MonitorViewData::ConstPtr M_last_front;
+    MonitorViewData::ConstPtr M_last_back;
+    std::size_t M_last_size;
+
+    //! incremented by each request of the new view data
+    int M_generation;
+    //! the generation analyzed by the running or the last task
+    int M_task_generation;
+    //! the result of the running task. invalid if no task is running.
+    std::future< AreasPtr > M_result;
+
+    QThreadPool M_pool;
+
+    // not used
+    DominanceStrip( const DominanceStrip & ) = delete;
+    DominanceStrip & operator=( const DominanceStrip & ) = delete;
+
+public:
+
+    DominanceStrip( const MainData & main_data,
+                    QWidget * parent );
+
+    /*!
+      \brief wait for the running task.
+     */
+    ~DominanceStrip();
+
+    /*!
+      \brief request the analysis of the new view data and repaint.
+     */
+    void updateSeries();
+
+    QSize sizeHint() const override;
+
+protected:
+
+    void paintEvent( QPaintEvent * event ) override;
+
+private:
+
+    void startTask();
+
+private slots:
+
+    //! apply the result of the finished task. invoked in the GUI thread.
+    void handleFinished();
+
+};
+
+#endif
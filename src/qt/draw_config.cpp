@@ -1059,6 +1059,36 @@ DrawConfig::toString( const QColor & color )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+DrawConfig::resolveColorHandles() const
+{
+    const ColorTable & table = ColorTable::instance();
+    const std::size_t size = table.size();
+
+    for ( std::size_t id = M_color_handles.size(); id < size; ++id )
+    {
+        ColorHandle handle;
+
+        const std::string name = table.name( static_cast< ColorTable::ID >( id ) );
+        if ( ! name.empty() )
+        {
+            const QColor col( name.c_str() );
+            if ( col.isValid() )
+            {
+                handle.valid_ = true;
+                handle.pen_ = QPen( col );
+                handle.brush_ = QBrush( col );
+            }
+        }
+
+        M_color_handles.push_back( handle );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 DrawConfig::setScoreBoardFont( const QFont & font )
@@ -38,9 +38,27 @@
 #include <QPen>
 #include <QString>
 
+#include "color_table.h"
+
+#include <vector>
+
 //! draw object configuration manager class
 class DrawConfig {
 public:
+
+    /*!
+      \brief pen and brush resolved from a color string in ColorTable.
+    */
+    struct ColorHandle {
+        bool valid_; //!< false if the color string is empty or not a valid color
+        QPen pen_;
+        QBrush brush_;
+
+        ColorHandle()
+            : valid_( false )
+          { }
+    };
+
     //--------------------------------------------------
     // default color settings
     static const QColor SCORE_BOARD_COLOR;
@@ -299,6 +317,9 @@ private:
     QPen M_fedit_shoot_line_pen;
     QPen M_fedit_free_kick_circle_pen;
 
+    //! resolved colors indexed by ColorTable::ID. extended on demand.
+    mutable std::vector< ColorHandle > M_color_handles;
+
     //! constructor
     DrawConfig();
     DrawConfig( const DrawConfig & );
@@ -331,11 +352,32 @@ private:
     //! convert clor object to config string
     QString toString( const QColor & color );
 
+    //! resolve the colors registered in ColorTable after the last call.
+    void resolveColorHandles() const;
+
 public:
 
     //--------------------------------------------------
     // accessor
 
+    /*!
+      \brief get the pen and the brush of the color registered in ColorTable.
+      The color string is converted only when the id is used for the first time.
+      Only the GUI thread may call this.
+     */
+    const ColorHandle & colorHandle( const ColorTable::ID id ) const
+      {
+          if ( id >= M_color_handles.size() )
+          {
+              resolveColorHandles();
+              if ( id >= M_color_handles.size() )
+              {
+                  return M_color_handles[ColorTable::NONE];
+              }
+          }
+          return M_color_handles[id];
+      }
+
     const QPen & transparentPen() const { return M_transparent_pen; }
     const QBrush & transparentBrush() const { return M_transparent_brush; }
 
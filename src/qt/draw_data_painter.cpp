@@ -43,7 +43,10 @@
 
 #include "draw_data_painter.h"
 
+#include "draw_config.h"
+#include "screen_points.h"
 #include "options.h"
+#include "viewport.h"
 #include "main_data.h"
 #include "draw_data_holder.h"
 
@@ -51,27 +54,66 @@
 
 namespace {
 
+//! screen length around the text anchor in which the text may be visible
+const double TEXT_MARGIN = 256.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief set the pen of the color only if the color is changed from the previous shape.
+  \param fallback pen used if the color is not valid.
+*/
+void
+set_pen( QPainter & painter,
+         const ColorTable::ID color,
+         const QPen & fallback,
+         ColorTable::ID & current )
+{
+    if ( color == current )
+    {
+        return;
+    }
+
+    const DrawConfig::ColorHandle & handle = DrawConfig::instance().colorHandle( color );
+    painter.setPen( handle.valid_ ? handle.pen_ : fallback );
+    current = color;
+}
+
+/*-------------------------------------------------------------------*/
+void
+set_brush( QPainter & painter,
+           const ColorTable::ID color )
+{
+    const DrawConfig::ColorHandle & handle = DrawConfig::instance().colorHandle( color );
+    if ( handle.valid_ )
+    {
+        painter.setBrush( handle.brush_ );
+    }
+    else
+    {
+        painter.setBrush( Qt::NoBrush );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 void
 draw_texts( QPainter & painter,
+            const Viewport & viewport,
             const DrawTextCont & cont )
 {
-    const Options & opt = Options::instance();
+    const ScreenTransform & transform = viewport.transform();
+    const QPen fallback( Qt::white );
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & t : cont )
     {
-        QColor col( t.color_.c_str() );
-        if ( col.isValid() )
+        if ( ! viewport.contains( t.x_, t.y_, TEXT_MARGIN ) )
         {
-            painter.setPen( col );
-        }
-        else
-        {
-            painter.setPen( Qt::white );
+            continue;
         }
 
-        painter.drawText( QPointF( opt.screenX( t.x_ ),
-                                   opt.screenY( t.y_ ) ),
+        set_pen( painter, t.color_, fallback, current );
+        painter.drawText( QPointF( transform.screenX( t.x_ ),
+                                   transform.screenY( t.y_ ) ),
                           QString::fromStdString( t.msg_ ) );
     }
 }
@@ -79,123 +121,137 @@ draw_texts( QPainter & painter,
 /*-------------------------------------------------------------------*/
 void
 draw_points( QPainter & painter,
+             const Viewport & viewport,
              const DrawPointCont & cont )
 {
-    const Options & opt = Options::instance();
+    const ScreenTransform & transform = viewport.transform();
+    const QPen fallback( Qt::white );
 
+    // consecutive points of the same color are drawn at once.
+    QVector< QPointF > points;
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & p : cont )
     {
-        QColor col( p.color_.c_str() );
-        if ( col.isValid() )
+        if ( ! viewport.contains( p.x_, p.y_ ) )
         {
-            painter.setPen( col );
+            continue;
         }
-        else
+
+        if ( p.color_ != current
+             && ! points.isEmpty() )
         {
-            painter.setPen( Qt::white );
+            map_to_screen( transform, points.data(), points.size() );
+            painter.drawPoints( points.constData(), points.size() );
+            points.clear();
         }
 
-        painter.drawPoint( QPointF( opt.screenX( p.x_ ),
-                                    opt.screenY( p.y_ ) ) );
+        set_pen( painter, p.color_, fallback, current );
+        points.push_back( QPointF( p.x_, p.y_ ) );
+    }
+
+    if ( ! points.isEmpty() )
+    {
+        map_to_screen( transform, points.data(), points.size() );
+        painter.drawPoints( points.constData(), points.size() );
     }
 }
 
 /*-------------------------------------------------------------------*/
 void
 draw_lines( QPainter & painter,
+            const Viewport & viewport,
             const DrawLineCont & cont )
 {
-    const Options & opt = Options::instance();
+    const ScreenTransform & transform = viewport.transform();
+    const QPen fallback( Qt::white );
 
+    // consecutive lines of the same color are drawn at once.
+    QVector< QLineF > lines;
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & l : cont )
     {
-        QColor col( l.color_.c_str() );
-        if ( col.isValid() )
+        if ( ! viewport.intersects( l.x1_, l.y1_, l.x2_, l.y2_ ) )
         {
-            painter.setPen( col );
+            continue;
         }
-        else
+
+        if ( l.color_ != current
+             && ! lines.isEmpty() )
         {
-            painter.setPen( Qt::white );
+            map_to_screen( transform, lines.data(), lines.size() );
+            painter.drawLines( lines );
+            lines.clear();
         }
 
-        painter.drawLine( QLineF( opt.screenX( l.x1_ ),
-                                  opt.screenY( l.y1_ ),
-                                  opt.screenX( l.x2_ ),
-                                  opt.screenY( l.y2_ ) ) );
+        set_pen( painter, l.color_, fallback, current );
+        lines.push_back( QLineF( l.x1_, l.y1_, l.x2_, l.y2_ ) );
+    }
+
+    if ( ! lines.isEmpty() )
+    {
+        map_to_screen( transform, lines.data(), lines.size() );
+        painter.drawLines( lines );
     }
 }
 
 /*-------------------------------------------------------------------*/
 void
 draw_rects( QPainter & painter,
+            const Viewport & viewport,
             const DrawRectCont & cont )
 {
-    const Options & opt = Options::instance();
+    const ScreenTransform & transform = viewport.transform();
+    const QPen fallback( Qt::NoPen );
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & r : cont )
     {
-        QColor line_col( r.line_color_.c_str() );
-        QColor fill_col( r.fill_color_.c_str() );
-        if ( line_col.isValid() )
-        {
-            painter.setPen( line_col );
-        }
-        else
+        const QRectF rect( transform.screenX( r.left_ ),
+                           transform.screenY( r.top_ ),
+                           transform.scale( r.width_ ),
+                           transform.scale( r.height_ ) );
+        if ( ! viewport.intersectsScreen( rect.left(), rect.top(), rect.right(), rect.bottom() ) )
         {
-            painter.setPen( Qt::NoPen );
+            continue;
         }
 
-        if ( fill_col.isValid() )
-        {
-            painter.setBrush( fill_col );
-        }
-        else
-        {
-            painter.setBrush( Qt::NoBrush );
-        }
+        set_pen( painter, r.line_color_, fallback, current );
+        set_brush( painter, r.fill_color_ );
 
-        painter.drawRect( QRectF( opt.screenX( r.left_ ),
-                                  opt.screenY( r.top_ ),
-                                  opt.scale( r.width_ ),
-                                  opt.scale( r.height_ ) ) );
+        painter.drawRect( rect );
     }
 }
 
 /*-------------------------------------------------------------------*/
 void
 draw_circles( QPainter & painter,
+              const Viewport & viewport,
               const DrawCircleCont & cont )
 {
-    const Options & opt = Options::instance();
+    const ScreenTransform & transform = viewport.transform();
+    const QPen fallback( Qt::NoPen );
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & c : cont )
     {
-        QColor line_col( c.line_color_.c_str() );
-        QColor fill_col( c.fill_color_.c_str() );
-
-        if ( line_col.isValid() )
+        if ( ! viewport.intersectsCircle( c.x_, c.y_, c.r_ ) )
         {
-            painter.setPen( line_col );
-        }
-        else
-        {
-            painter.setPen( Qt::NoPen );
+            continue;
         }
 
-        if ( fill_col.isValid() )
-        {
-            painter.setBrush( fill_col );
-        }
-        else
+        set_pen( painter, c.line_color_, fallback, current );
+        set_brush( painter, c.fill_color_ );
+
+        const QPointF center( transform.screenX( c.x_ ),
+                              transform.screenY( c.y_ ) );
+        if ( viewport.isSubPixel( c.r_ * 2.0 ) )
         {
-            painter.setBrush( Qt::NoBrush );
+            draw_dot( painter, center );
+            continue;
         }
 
-        double r = opt.scale( c.r_ );
-        painter.drawEllipse( QPointF( opt.screenX( c.x_ ),
-                                      opt.screenY( c.y_ ) ),
-                             r, r );
+        double r = transform.scale( c.r_ );
+        painter.drawEllipse( center, r, r );
     }
 }
 
@@ -238,9 +294,11 @@ DrawDataPainter::draw( QPainter & painter )
         return;
     }
 
-    draw_rects( painter, it->second.rects_ );
-    draw_circles( painter, it->second.circles_ );
-    draw_lines( painter, it->second.lines_ );
-    draw_texts( painter, it->second.texts_ );
-    draw_points( painter, it->second.points_ );
+    const Viewport viewport( opt.screenTransform(), opt.canvasWidth(), opt.canvasHeight() );
+
+    draw_rects( painter, viewport, it->second.rects_ );
+    draw_circles( painter, viewport, it->second.circles_ );
+    draw_lines( painter, viewport, it->second.lines_ );
+    draw_texts( painter, viewport, it->second.texts_ );
+    draw_points( painter, viewport, it->second.points_ );
 }
@@ -43,6 +43,7 @@
 
 #include "features_log_painter.h"
 
+#include "draw_config.h"
 #include "options.h"
 #include "main_data.h"
 #include "features_log.h"
@@ -53,35 +54,78 @@ namespace {
 
 const double selected_width = 4.0;
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief set the pen of the color only if the color is changed from the previous shape.
+*/
+void
+set_pen( QPainter & painter,
+         const ColorTable::ID color,
+         const bool selected,
+         ColorTable::ID & current )
+{
+    if ( color == current )
+    {
+        return;
+    }
+
+    const DrawConfig::ColorHandle & handle = DrawConfig::instance().colorHandle( color );
+    QPen pen( handle.valid_ ? handle.pen_ : QPen( Qt::white ) );
+    if ( selected ) pen.setWidth( selected_width );
+
+    painter.setPen( pen );
+    current = color;
+}
+
+/*-------------------------------------------------------------------*/
+void
+set_brush( QPainter & painter,
+           const ColorTable::ID color )
+{
+    const DrawConfig::ColorHandle & handle = DrawConfig::instance().colorHandle( color );
+    if ( handle.valid_ )
+    {
+        painter.setBrush( handle.brush_ );
+    }
+    else
+    {
+        painter.setBrush( Qt::NoBrush );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 void
 draw_texts( QPainter & painter,
             const DrawTextCont & cont,
             const bool selected )
 {
+    if ( cont.empty() )
+    {
+        return;
+    }
+
     const Options & opt = Options::instance();
 
-    for ( const auto & t : cont )
+    if ( selected )
     {
-        QColor col( t.color_.c_str() );
-        QPen pen( ( col.isValid() ? col : Qt::white ) );
-        if ( selected )
-        {
-            painter.save();
-            QFont font = painter.font();
-            font.setWeight( QFont::Bold );
-            painter.setFont( font );
-        }
+        painter.save();
+        QFont font = painter.font();
+        font.setWeight( QFont::Bold );
+        painter.setFont( font );
+    }
 
-        painter.setPen( pen );
+    ColorTable::ID current = ~ColorTable::ID( 0 );
+    for ( const auto & t : cont )
+    {
+        set_pen( painter, t.color_, false, current );
         painter.drawText( QPointF( opt.screenX( t.x_ ),
                                    opt.screenY( t.y_ ) ),
                           QString::fromStdString( t.msg_ ) );
+    }
 
-        if ( selected )
-        {
-            painter.restore();
-        }
+    if ( selected )
+    {
+        painter.restore();
     }
 }
 
@@ -93,15 +137,26 @@ draw_points( QPainter & painter,
 {
     const Options & opt = Options::instance();
 
+    // consecutive points of the same color are drawn at once.
+    QVector< QPointF > points;
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & p : cont )
     {
-        QColor col( p.color_.c_str() );
-        QPen pen( col.isValid() ? col : Qt::white );
-        if ( selected ) pen.setWidth( selected_width );
+        if ( p.color_ != current
+             && ! points.isEmpty() )
+        {
+            painter.drawPoints( points.constData(), points.size() );
+            points.clear();
+        }
 
-        painter.setPen( pen );
-        painter.drawPoint( QPointF( opt.screenX( p.x_ ),
-                                    opt.screenY( p.y_ ) ) );
+        set_pen( painter, p.color_, selected, current );
+        points.push_back( QPointF( opt.screenX( p.x_ ),
+                                   opt.screenY( p.y_ ) ) );
+    }
+
+    if ( ! points.isEmpty() )
+    {
+        painter.drawPoints( points.constData(), points.size() );
     }
 }
 
@@ -113,17 +168,28 @@ draw_lines( QPainter & painter,
 {
     const Options & opt = Options::instance();
 
+    // consecutive lines of the same color are drawn at once.
+    QVector< QLineF > lines;
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & l : cont )
     {
-        QColor col( l.color_.c_str() );
-        QPen pen( col.isValid() ? col : Qt::white );
-        if ( selected ) pen.setWidth( selected_width );
-
-        painter.setPen( pen );
-        painter.drawLine( QLineF( opt.screenX( l.x1_ ),
-                                  opt.screenY( l.y1_ ),
-                                  opt.screenX( l.x2_ ),
-                                  opt.screenY( l.y2_ ) ) );
+        if ( l.color_ != current
+             && ! lines.isEmpty() )
+        {
+            painter.drawLines( lines );
+            lines.clear();
+        }
+
+        set_pen( painter, l.color_, selected, current );
+        lines.push_back( QLineF( opt.screenX( l.x1_ ),
+                                 opt.screenY( l.y1_ ),
+                                 opt.screenX( l.x2_ ),
+                                 opt.screenY( l.y2_ ) ) );
+    }
+
+    if ( ! lines.isEmpty() )
+    {
+        painter.drawLines( lines );
     }
 }
 
@@ -135,24 +201,11 @@ draw_rects( QPainter & painter,
 {
     const Options & opt = Options::instance();
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & r : cont )
     {
-        QColor line_col( r.line_color_.c_str() );
-        QColor fill_col( r.fill_color_.c_str() );
-
-        QPen pen( ( line_col.isValid() ? line_col : Qt::white ) );
-        if ( selected ) pen.setWidth( selected_width );
-
-        painter.setPen( pen );
-
-        if ( fill_col.isValid() )
-        {
-            painter.setBrush( fill_col );
-        }
-        else
-        {
-            painter.setBrush( Qt::NoBrush );
-        }
+        set_pen( painter, r.line_color_, selected, current );
+        set_brush( painter, r.fill_color_ );
 
         painter.drawRect( QRectF( opt.screenX( r.left_ ),
                                   opt.screenY( r.top_ ),
@@ -169,24 +222,11 @@ draw_circles( QPainter & painter,
 {
     const Options & opt = Options::instance();
 
+    ColorTable::ID current = ~ColorTable::ID( 0 );
     for ( const auto & c : cont )
     {
-        QColor line_col( c.line_color_.c_str() );
-        QColor fill_col( c.fill_color_.c_str() );
-
-        QPen pen( ( line_col.isValid() ? line_col : Qt::white ) );
-        if ( selected ) pen.setWidth( selected_width );
-
-        painter.setPen( pen );
-
-        if ( fill_col.isValid() )
-        {
-            painter.setBrush( fill_col );
-        }
-        else
-        {
-            painter.setBrush( Qt::NoBrush );
-        }
+        set_pen( painter, c.line_color_, selected, current );
+        set_brush( painter, c.fill_color_ );
 
         double r = opt.scale( c.r_ );
         painter.drawEllipse( QPointF( opt.screenX( c.x_ ),
@@ -66,16 +66,77 @@
 
 // model
 #include "main_data.h"
+#include "debug_log_data.h"
 #include "options.h"
 #include "formation_edit_data.h"
+#include "latency_monitor.h"
+#include "quality_governor.h"
 
 #include <rcsc/common/server_param.h>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <typeinfo>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cassert>
 
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the field painter shared by all canvases.
+  The painter has no per canvas state.
+*/
+std::shared_ptr< FieldPainter >
+shared_field_painter()
+{
+    static std::weak_ptr< FieldPainter > s_painter;
+
+    std::shared_ptr< FieldPainter > ptr = s_painter.lock();
+    if ( ! ptr )
+    {
+        ptr = std::shared_ptr< FieldPainter >( new FieldPainter() );
+        s_painter = ptr;
+    }
+
+    return ptr;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+double
+elapsed_usec( const std::chrono::steady_clock::time_point & start )
+{
+    return std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count();
+}
+
+/*-------------------------------------------------------------------*/
+//! exponential moving average of the profile samples
+inline
+void
+smooth_usec( double & average,
+             const double sample )
+{
+    if ( average <= 0.0 )
+    {
+        average = sample;
+    }
+    else
+    {
+        average += 0.1 * ( sample - average );
+    }
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -92,7 +153,12 @@ FieldCanvas::FieldCanvas( MainData & main_data )
     M_monitor_menu( static_cast< QMenu * >( 0 ) ),
     M_offline_menu( static_cast< QMenu * >( 0 ) ),
     M_cursor_timer( new QTimer( this ) ),
-    M_paint_style( -1 )
+    M_paint_style( -1 ),
+    M_static_layer_key(),
+    M_dynamic_layer_index( 0 ),
+    M_overlay_only( false ),
+    M_static_layer_usec( 0.0 ),
+    M_frame_usec( 0.0 )
 {
     //this->setPalette( M_main_data.drawConfig().fieldBrush().color() );
     //this->setAutoFillBackground( true );
@@ -105,7 +171,8 @@ FieldCanvas::FieldCanvas( MainData & main_data )
     // paint directory
     //this->setAttribute( Qt::WA_PaintOnScreen );
 
-    M_field_painter = std::shared_ptr< FieldPainter >( new FieldPainter() );
+    M_field_painter = shared_field_painter();
+    M_team_graphic_painter = std::shared_ptr< TeamGraphicPainter >( new TeamGraphicPainter( M_main_data ) );
     M_formation_editor_painter = std::shared_ptr< FormationEditorPainter >( new FormationEditorPainter( M_main_data ) );
 
     createPainters();
@@ -138,52 +205,83 @@ FieldCanvas::createPainters()
     }
 
     M_paint_style = static_cast< int >( paint_style );
-    M_painters.clear();
-
-    if ( paint_style == Options::PAINT_RCSSMONITOR )
-    {
-        //M_painters.push_back( std::shared_ptr< PainterInterface >( new FieldEvaluationPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new TeamGraphicPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new BallTracePainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new PlayerTracePainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new PlayerPainterRCSS( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new BallPainterRCSS( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new OffsideLinePainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new PlayerControlPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new VoronoiDiagramPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new DebugPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new DebugLogPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new DrawDataPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new FeaturesLogPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new ScoreBoardPainterRCSS( M_main_data ) ) );
+    create_painters( M_main_data, paint_style, M_painters );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  create the painters drawn over the field. the order is the drawing order.
+*/
+void
+FieldCanvas::create_painters( MainData & main_data,
+                              const int style,
+                              std::vector< std::shared_ptr< PainterInterface > > & painters )
+{
+    painters.clear();
+
+    if ( style == Options::PAINT_RCSSMONITOR )
+    {
+        //painters.push_back( std::shared_ptr< PainterInterface >( new FieldEvaluationPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new BallTracePainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new PlayerTracePainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new PlayerPainterRCSS( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new BallPainterRCSS( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new OffsideLinePainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new PlayerControlPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new VoronoiDiagramPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new DebugPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new DebugLogPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new DrawDataPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new FeaturesLogPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new ScoreBoardPainterRCSS( main_data ) ) );
     }
     else
     {
-        if ( paint_style != Options::PAINT_DEFAULT )
+        if ( style != Options::PAINT_DEFAULT )
         {
-            std::cerr << __FILE__ << ": ***WARNING*** (createPainters) "
-                      << "Unsupported paint style : " << paint_style << std::endl;
+            std::cerr << __FILE__ << ": ***WARNING*** (create_painters) "
+                      << "Unsupported paint style : " << style << std::endl;
         }
 
-        //M_painters.push_back( std::shared_ptr< PainterInterface >( new FieldEvaluationPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new TeamGraphicPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new BallTracePainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new PlayerTracePainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new PlayerPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new BallPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new OffsideLinePainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new VoronoiDiagramPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new DebugPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new DebugLogPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new DrawDataPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new FeaturesLogPainter( M_main_data ) ) );
-        M_painters.push_back( std::shared_ptr< PainterInterface >( new ScoreBoardPainter( M_main_data ) ) );
+        //painters.push_back( std::shared_ptr< PainterInterface >( new FieldEvaluationPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new BallTracePainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new PlayerTracePainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new PlayerPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new BallPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new OffsideLinePainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new VoronoiDiagramPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new DebugPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new DebugLogPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new DrawDataPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new FeaturesLogPainter( main_data ) ) );
+        painters.push_back( std::shared_ptr< PainterInterface >( new ScoreBoardPainter( main_data ) ) );
     }
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+std::string
+FieldCanvas::painter_name( const PainterInterface & painter )
+{
+    const char * name = typeid( painter ).name();
+#ifdef __GNUC__
+    int status = 0;
+    char * demangled = abi::__cxa_demangle( name, static_cast< char * >( 0 ), 0, &status );
+    if ( demangled )
+    {
+        std::string result( demangled );
+        std::free( demangled );
+        return result;
+    }
+#endif
+    return std::string( name );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 FieldCanvas::setNormalMenu( QMenu * menu )
@@ -313,9 +411,11 @@ FieldCanvas::changePlayMode( int mode )
 void
 FieldCanvas::paintEvent( QPaintEvent * )
 {
+    const std::chrono::steady_clock::time_point paint_start = std::chrono::steady_clock::now();
+
     QPainter painter( this );
 
-    if ( Options::instance().antiAliasing() )
+    if ( Options::instance().renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -341,14 +441,181 @@ FieldCanvas::paintEvent( QPaintEvent * )
         M_transform.scale( opt.fieldScale(), opt.fieldScale() );
     }
 
-    draw( painter );
-
-    // draw mouse measure
+    updateStaticLayer();
 
     if ( M_mouse_state[2].isDragged() )
     {
+        // while the mouse measure is shown, the composed layers are reused
+        // as long as only the overlay is changed.
+        if ( ! M_overlay_only
+             || ! isDynamicLayerValid() )
+        {
+            M_dynamic_layer = M_static_layer.copy();
+
+            QPainter layer_painter( &M_dynamic_layer );
+            layer_painter.setRenderHints( painter.renderHints() );
+            drawDynamicLayer( layer_painter );
+
+            M_dynamic_layer_view = M_main_data.getCurrentViewData();
+            M_dynamic_layer_index = M_main_data.viewIndex();
+            M_dynamic_layer_transform = M_transform;
+        }
+
+        painter.drawPixmap( 0, 0, M_dynamic_layer );
+
+        // draw mouse measure
         drawMouseMeasure( painter );
     }
+    else
+    {
+        if ( ! M_dynamic_layer.isNull() )
+        {
+            M_dynamic_layer = QPixmap();
+            M_dynamic_layer_view.reset();
+        }
+
+        painter.drawPixmap( 0, 0, M_static_layer );
+        drawDynamicLayer( painter );
+    }
+
+    M_overlay_only = false;
+
+    if ( Options::instance().showProfileHUD() )
+    {
+        smooth_usec( M_frame_usec, elapsed_usec( paint_start ) );
+        drawProfileHUD( painter );
+    }
+
+    LatencyMonitor::instance().stampPaint();
+    QualityGovernor::instance().addFrameTime( elapsed_usec( paint_start ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FieldCanvas::StaticLayerKey::operator==( const StaticLayerKey & other ) const
+{
+    return ( size_ == other.size_
+             && pixel_ratio_ == other.pixel_ratio_
+             && score_board_height_ == other.score_board_height_
+             && field_scale_ == other.field_scale_
+             && center_x_ == other.center_x_
+             && center_y_ == other.center_y_
+             && grass_type_ == other.grass_type_
+             && gradient_ == other.gradient_
+             && anti_aliasing_ == other.anti_aliasing_
+             && keepaway_mode_ == other.keepaway_mode_
+             && show_flags_ == other.show_flags_
+             && show_grid_coord_ == other.show_grid_coord_
+             && grid_step_ == other.grid_step_
+             && reverse_side_ == other.reverse_side_
+             && team_graphic_ == other.team_graphic_
+             && team_graphic_scale_ == other.team_graphic_scale_
+             && team_graphic_left_ == other.team_graphic_left_
+             && team_graphic_right_ == other.team_graphic_right_
+             && goal_width_ == other.goal_width_
+             && keepaway_length_ == other.keepaway_length_
+             && keepaway_width_ == other.keepaway_width_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FieldCanvas::StaticLayerKey
+FieldCanvas::createStaticLayerKey() const
+{
+    const Options & opt = Options::instance();
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    StaticLayerKey key;
+    key.size_ = this->size();
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
+    key.pixel_ratio_ = this->devicePixelRatioF();
+#else
+    key.pixel_ratio_ = 1.0;
+#endif
+    key.score_board_height_ = opt.scoreBoardHeight();
+    key.field_scale_ = opt.fieldScale();
+    key.center_x_ = opt.fieldCenter().x;
+    key.center_y_ = opt.fieldCenter().y;
+    key.grass_type_ = static_cast< int >( opt.fieldGrassType() );
+    key.gradient_ = opt.renderGradient();
+    key.anti_aliasing_ = opt.renderAntiAliasing();
+    key.keepaway_mode_ = ( opt.keepawayMode() || SP.keepawayMode() );
+    key.show_flags_ = opt.showFlags();
+    key.show_grid_coord_ = opt.showGridCoord();
+    key.grid_step_ = opt.gridStep();
+    key.reverse_side_ = opt.reverseSide();
+    key.team_graphic_ = ( opt.showTeamGraphic() && ! opt.anonymousMode() );
+    key.team_graphic_scale_ = opt.teamGraphicScale();
+    key.team_graphic_left_ = M_main_data.viewHolder().teamGraphicLeft().tiles().size();
+    key.team_graphic_right_ = M_main_data.viewHolder().teamGraphicRight().tiles().size();
+    key.goal_width_ = SP.goalWidth();
+    key.keepaway_length_ = SP.keepawayLength();
+    key.keepaway_width_ = SP.keepawayWidth();
+
+    return key;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  Rebuild the static layer if the canvas size, the scale or any option
+  used by the field painter or the team graphic painter is changed.
+  Color and font changes are notified by redrawAll().
+*/
+void
+FieldCanvas::updateStaticLayer()
+{
+    const StaticLayerKey key = createStaticLayerKey();
+
+    if ( ! M_redraw_all
+         && ! M_static_layer.isNull()
+         && key == M_static_layer_key )
+    {
+        return;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    M_static_layer = QPixmap( key.size_ * key.pixel_ratio_ );
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
+    M_static_layer.setDevicePixelRatio( key.pixel_ratio_ );
+#endif
+
+    {
+        QPainter painter( &M_static_layer );
+        if ( key.anti_aliasing_ )
+        {
+            painter.setRenderHint( QPainter::Antialiasing, true );
+        }
+
+        M_field_painter->draw( painter );
+        M_team_graphic_painter->draw( painter );
+    }
+
+    M_static_layer_usec = elapsed_usec( start );
+    M_static_layer_key = key;
+    M_redraw_all = false;
+
+    // the composed layers contain the old static layer.
+    M_dynamic_layer = QPixmap();
+    M_dynamic_layer_view.reset();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+FieldCanvas::isDynamicLayerValid() const
+{
+    return ( ! M_dynamic_layer.isNull()
+             && M_dynamic_layer_view == M_main_data.getCurrentViewData()
+             && M_dynamic_layer_index == M_main_data.viewIndex()
+             && M_dynamic_layer_transform == M_transform );
 }
 
 /*-------------------------------------------------------------------*/
@@ -596,6 +863,7 @@ FieldCanvas::mouseMoveEvent( QMouseEvent * event )
                 new_rect.setRight( M_mouse_state[2].draggedPoint().x() + 512 );
             }
             // draw mouse measure
+            M_overlay_only = true;
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
             this->update( s_last_rect.united( new_rect ) );
 #else
@@ -634,15 +902,40 @@ FieldCanvas::mouseMoveEvent( QMouseEvent * event )
 void
 FieldCanvas::draw( QPainter & painter )
 {
-    createPainters();
-
     M_field_painter->draw( painter );
+    M_team_graphic_painter->draw( painter );
+
+    drawDynamicLayer( painter );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+FieldCanvas::drawDynamicLayer( QPainter & painter )
+{
+    createPainters();
 
     if ( M_main_data.getCurrentViewData() )
     {
-        for ( auto p : M_painters )
+        if ( Options::instance().showProfileHUD() )
         {
-            p->draw( painter );
+            M_painter_usec.resize( M_painters.size(), 0.0 );
+
+            for ( std::size_t i = 0; i < M_painters.size(); ++i )
+            {
+                const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                M_painters[i]->draw( painter );
+                smooth_usec( M_painter_usec[i], elapsed_usec( start ) );
+            }
+        }
+        else
+        {
+            for ( auto p : M_painters )
+            {
+                p->draw( painter );
+            }
         }
     }
 
@@ -650,8 +943,106 @@ FieldCanvas::draw( QPainter & painter )
     {
         M_formation_editor_painter->draw( painter );
     }
+}
 
-    M_redraw_all = false;
+/*-------------------------------------------------------------------*/
+/*!
+  draw the drawing time of each painter and the amount of the debug data
+  of the selected player in the current cycle.
+*/
+void
+FieldCanvas::drawProfileHUD( QPainter & painter )
+{
+    const Options & opt = Options::instance();
+
+    QStringList lines;
+    lines << tr( "frame        %1 ms" ).arg( M_frame_usec * 0.001, 7, 'f', 2 );
+    lines << tr( "static layer %1 ms (last rebuild)" ).arg( M_static_layer_usec * 0.001, 7, 'f', 2 );
+
+    if ( M_painter_usec.size() == M_painters.size() )
+    {
+        for ( std::size_t i = 0; i < M_painters.size(); ++i )
+        {
+            lines << QString( "%1 %2 ms" )
+                .arg( QString::fromStdString( painter_name( *M_painters[i] ) ), -24 )
+                .arg( M_painter_usec[i] * 0.001, 7, 'f', 2 );
+        }
+    }
+
+    const int number = std::abs( opt.selectedNumber() );
+    MonitorViewData::ConstPtr monitor_view = M_main_data.getCurrentViewData();
+    if ( number != 0
+         && monitor_view )
+    {
+        const DebugViewData::Map & view_map = ( opt.selectedNumber() < 0
+                                                ? M_main_data.viewHolder().rightDebugView()
+                                                : M_main_data.viewHolder().leftDebugView() );
+        rcsc::GameTime time = monitor_view->time();
+        if ( monitor_view->playmode() == rcsc::PM_BeforeKickOff )
+        {
+            time.setStopped( 0 );
+        }
+
+        DebugViewData::Map::const_iterator it = view_map.find( time );
+        if ( it != view_map.end()
+             && number <= static_cast< int >( it->second.size() )
+             && it->second[number - 1] )
+        {
+            const DebugViewData & v = *it->second[number - 1];
+            lines << tr( "debug view   %1 shapes %2 players" )
+                .arg( v.lines().size() + v.triangles().size() + v.rectangles().size() + v.circles().size() )
+                .arg( v.teammates().size() + v.opponents().size()
+                      + v.unknownTeammates().size() + v.unknownOpponents().size() + v.unknownPlayers().size() );
+        }
+
+        if ( std::shared_ptr< const DebugLogData > data = M_main_data.debugLogHolder().getData( number ) )
+        {
+            const DebugLogData & d = *data;
+            lines << tr( "debug log    %1 shapes %2 texts" )
+                .arg( d.pointCont().size() + d.lineCont().size() + d.arcCont().size()
+                      + d.circleCont().size() + d.filledCircleCont().size()
+                      + d.triangleCont().size() + d.filledTriangleCont().size()
+                      + d.rectCont().size() + d.filledRectCont().size()
+                      + d.sectorCont().size() + d.filledSectorCont().size() )
+                .arg( d.textCont().size() + d.messageCont().size() );
+        }
+    }
+
+    painter.save();
+
+    // follow the font configured for the other overlay texts.
+    const QFont & font = DrawConfig::instance().measureFont();
+    painter.setFont( font );
+
+    const QFontMetrics metrics( font );
+    int text_width = 0;
+    for ( const QString & line : lines )
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 11, 0))
+        text_width = std::max( text_width, metrics.horizontalAdvance( line ) );
+#else
+        text_width = std::max( text_width, metrics.width( line ) );
+#endif
+    }
+
+    const int margin = 4;
+    const QRect rect( 8, opt.scoreBoardHeight() + 8,
+                      text_width + margin * 2,
+                      metrics.lineSpacing() * lines.size() + margin * 2 );
+
+    painter.setPen( Qt::NoPen );
+    painter.setBrush( QColor( 0, 0, 0, 160 ) );
+    painter.drawRect( rect );
+
+    painter.setPen( Qt::white );
+    int y = rect.top() + margin + metrics.ascent();
+    for ( const QString & line : lines )
+    {
+        painter.drawText( rect.left() + margin, y, line );
+        y += metrics.lineSpacing();
+    }
+
+    painter.restore();
 }
 
 /*-------------------------------------------------------------------*/
@@ -40,10 +40,14 @@
 #include <QWidget>
 #endif
 
+#include <QPixmap>
+
 #include "mouse_state.h"
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstddef>
 
 class QContextMenuEvent;
 class QMenu;
@@ -55,8 +59,10 @@ class QPointF;
 class QTimer;
 
 class MainData;
+class MonitorViewData;
 class PainterInterface;
 class FieldPainter;
+class TeamGraphicPainter;
 class FormationEditorPainter;
 
 //! main soccer field canvas class
@@ -72,6 +78,39 @@ class FieldCanvas
 
 private:
 
+    /*!
+      \brief the values on which the static layer depends.
+    */
+    struct StaticLayerKey {
+        QSize size_;
+        qreal pixel_ratio_;
+        int score_board_height_;
+        double field_scale_;
+        double center_x_;
+        double center_y_;
+        int grass_type_;
+        bool gradient_;
+        bool anti_aliasing_;
+        bool keepaway_mode_;
+        bool show_flags_;
+        bool show_grid_coord_;
+        int grid_step_;
+        bool reverse_side_;
+        bool team_graphic_;
+        double team_graphic_scale_;
+        std::size_t team_graphic_left_;
+        std::size_t team_graphic_right_;
+        double goal_width_;
+        double keepaway_length_;
+        double keepaway_width_;
+
+        bool operator==( const StaticLayerKey & other ) const;
+        bool operator!=( const StaticLayerKey & other ) const
+          {
+              return ! ( *this == other );
+          }
+    };
+
     MainData & M_main_data;
 
     QTransform M_transform;
@@ -92,10 +131,30 @@ private:
     int M_paint_style;
     std::shared_ptr< FieldPainter > M_field_painter;
 
+    std::shared_ptr< TeamGraphicPainter > M_team_graphic_painter;
+
     std::vector< std::shared_ptr< PainterInterface > > M_painters;
 
     std::shared_ptr< FormationEditorPainter > M_formation_editor_painter;
 
+    //! field and team graphics. rebuilt only when the key is changed.
+    QPixmap M_static_layer;
+    StaticLayerKey M_static_layer_key;
+
+    //! static and dynamic layers composed. used while only the overlay is changed.
+    QPixmap M_dynamic_layer;
+    std::shared_ptr< const MonitorViewData > M_dynamic_layer_view;
+    std::size_t M_dynamic_layer_index;
+    QTransform M_dynamic_layer_transform;
+
+    //! true if the pending repaint was requested only for the overlay layer.
+    bool M_overlay_only;
+
+    //! smoothed drawing time of each painter in M_painters [usec]. updated only while the profile HUD is shown.
+    std::vector< double > M_painter_usec;
+    double M_static_layer_usec; //!< the last rebuild time of the static layer [usec]
+    double M_frame_usec; //!< smoothed time of paintEvent [usec]
+
     // not used
     FieldCanvas( const FieldCanvas & );
     const FieldCanvas & operator=( const FieldCanvas & );
@@ -109,6 +168,16 @@ public:
 
     void createPainters();
 
+    //! create the painters drawn over the field and the team graphics.
+    static
+    void create_painters( MainData & main_data,
+                          const int style,
+                          std::vector< std::shared_ptr< PainterInterface > > & painters );
+
+    //! get the readable class name of the painter.
+    static
+    std::string painter_name( const PainterInterface & painter );
+
     void setNormalMenu( QMenu * menu );
     void setSystemMenu( QMenu * menu );
     void setMonitorMenu( QMenu * menu );
@@ -118,6 +187,13 @@ public:
 
 private:
 
+    StaticLayerKey createStaticLayerKey() const;
+    void updateStaticLayer();
+    void drawDynamicLayer( QPainter & painter );
+    bool isDynamicLayerValid() const;
+
+    void drawProfileHUD( QPainter & painter );
+
     void drawMouseMeasure( QPainter & painter );
     void createBallMovePath( const QPoint & start_point,
                              const QPoint & end_point,
@@ -68,7 +68,7 @@ FieldPainter::FieldPainter()
 void
 FieldPainter::draw( QPainter & painter )
 {
-    if ( Options::instance().antiAliasing() )
+    if ( Options::instance().renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -95,7 +95,7 @@ FieldPainter::draw( QPainter & painter )
         drawGrid( painter );
     }
 
-    if ( Options::instance().antiAliasing() )
+    if ( Options::instance().renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
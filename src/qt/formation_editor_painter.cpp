@@ -149,7 +149,7 @@ FormationEditorPainter::drawTriangulation( QPainter & painter )
         return;
     }
 
-    if ( Options::instance().antiAliasing() )
+    if ( Options::instance().renderAntiAliasing() )
     {
         setAntialiasFlag( painter, false );
     }
@@ -224,7 +224,7 @@ FormationEditorPainter::drawTriangulation( QPainter & painter )
         painter.drawRect( QRectF( it->ball_.x - 1.0, it->ball_.y - 1.0, 2.0, 2.0 ) );
     }
 
-    if ( Options::instance().antiAliasing() )
+    if ( Options::instance().renderAntiAliasing() )
     {
         setAntialiasFlag( painter, true );
     }
@@ -437,7 +437,7 @@ FormationEditorPainter::drawBackgroundTriangulation( QPainter & painter )
         return;
     }
 
-    if ( Options::instance().antiAliasing() )
+    if ( Options::instance().renderAntiAliasing() )
     {
         setAntialiasFlag( painter, false );
     }
@@ -500,7 +500,7 @@ FormationEditorPainter::drawBackgroundTriangulation( QPainter & painter )
         painter.setWorldMatrixEnabled( true );
     }
 
-    if ( Options::instance().antiAliasing() )
+    if ( Options::instance().renderAntiAliasing() )
     {
         setAntialiasFlag( painter, true );
     }
@@ -0,0 +1,76 @@
+// -*-c++-*-
+
+/*!
+  \file image_encode_task.h
+  \brief image file encoding task Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_IMAGE_ENCODE_TASK_H
+#define SOCCERWINDOW2_QT_IMAGE_ENCODE_TASK_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QRunnable>
+#include <QString>
+
+#include <future>
+
+/*!
+  \class ImageEncodeTask
+  \brief encode one rendered frame and write it to the file in a worker thread.
+*/
+class ImageEncodeTask
+    : public QRunnable {
+private:
+    const QImage M_image;
+    const QString M_file_path;
+    const QByteArray M_format;
+    std::promise< bool > M_result;
+
+public:
+    ImageEncodeTask( const QImage & image,
+                     const QString & file_path,
+                     const QByteArray & format )
+        : M_image( image ),
+          M_file_path( file_path ),
+          M_format( format )
+      {
+          setAutoDelete( true );
+      }
+
+    std::future< bool > result()
+      {
+          return M_result.get_future();
+      }
+
+    void run() override
+      {
+          M_result.set_value( M_image.save( M_file_path, M_format.constData() ) );
+      }
+};
+
+#endif
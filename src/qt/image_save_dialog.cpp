@@ -48,13 +48,86 @@
 #include "field_canvas.h"
 #include "view_holder.h"
 #include "dir_selector.h"
+#include "video_writer.h"
+#include "image_encode_task.h"
 
 #include "options.h"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <future>
 #include <iostream>
 #include <cassert>
 #include <cstdlib>
 
+namespace {
+
+//! file path and encoding result of a submitted frame
+typedef std::pair< QString, std::future< bool > > PendingImage;
+
+/*!
+  \class VideoEncodeTask
+  \brief convert one rendered frame to the video frame data in a worker thread.
+*/
+class VideoEncodeTask
+    : public QRunnable {
+private:
+    const VideoWriter & M_writer;
+    const QImage M_image;
+    std::promise< QByteArray > M_result;
+
+public:
+    VideoEncodeTask( const VideoWriter & writer,
+                     const QImage & image )
+        : M_writer( writer ),
+          M_image( image )
+      {
+          setAutoDelete( true );
+      }
+
+    std::future< QByteArray > result()
+      {
+          return M_result.get_future();
+      }
+
+    void run() override
+      {
+          M_result.set_value( M_writer.encode( M_image ) );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief wait for the future while keeping the dialog responsive.
+*/
+template < typename T >
+T
+wait_result( std::future< T > & result )
+{
+    while ( result.wait_for( std::chrono::milliseconds( 20 ) ) != std::future_status::ready )
+    {
+        qApp->processEvents();
+    }
+
+    return result.get();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief wait for the oldest pending frame while keeping the dialog responsive.
+  \return the encoding result
+*/
+bool
+wait_oldest_image( std::deque< PendingImage > & pending )
+{
+    const bool ok = wait_result( pending.front().second );
+    pending.pop_front();
+    return ok;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -101,6 +174,9 @@ ImageSaveDialog::createControls()
     layout->addWidget( createCycleSelectControls(),
                        0, Qt::AlignLeft );
 
+    layout->addWidget( createVideoControls(),
+                       0, Qt::AlignLeft );
+
     layout->addWidget( createFileNameControls(),
                        0, Qt::AlignLeft );
 
@@ -203,6 +279,42 @@ ImageSaveDialog::createCycleSelectControls()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+QWidget *
+ImageSaveDialog::createVideoControls()
+{
+    QGroupBox * group_box = new QGroupBox( tr( "Video (Y4M, AVI)" ) );
+
+    QHBoxLayout * layout = new QHBoxLayout();
+    layout->setSpacing( 0 );
+
+    layout->addWidget( new QLabel( tr( "FPS: " ) ),
+                       0, Qt::AlignVCenter );
+
+    M_video_fps = new QSpinBox();
+    M_video_fps->setRange( 1, 120 );
+    M_video_fps->setValue( 10 );
+    layout->addWidget( M_video_fps,
+                       0, Qt::AlignVCenter );
+
+    layout->addWidget( new QLabel( tr( " Frames/Cycle: " ) ),
+                       0, Qt::AlignVCenter );
+
+    M_frames_per_cycle = new QSpinBox();
+    M_frames_per_cycle->setRange( 1, 30 );
+    M_frames_per_cycle->setValue( 1 );
+    M_frames_per_cycle->setToolTip( tr( "The number of video frames for each cycle."
+                                        " Use FPS/10 for the real time speed." ) );
+    layout->addWidget( M_frames_per_cycle,
+                       0, Qt::AlignVCenter );
+
+    group_box->setLayout( layout );
+    return group_box;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 QWidget *
 ImageSaveDialog::createFileNameControls()
@@ -246,6 +358,16 @@ ImageSaveDialog::createFileNameControls()
                     max_width = width;
                 }
 
+                if ( text == default_format )
+                {
+                    png_index = i;
+                }
+                ++i;
+                M_format_choice->addItem( text );
+            }
+        // video formats
+        Q_FOREACH( QString text, QStringList() << "Y4M" << "AVI" )
+            {
                 if ( text == default_format )
                 {
                     png_index = i;
@@ -517,18 +639,37 @@ ImageSaveDialog::saveImage( const int start_cycle,
         file_path += name_prefix_trim;
     }
 
+    if ( VideoWriter::is_video_format( format ) )
+    {
+        // "-" streams the raw video to the standard output.
+        saveVideo( first, last,
+                   ( name_prefix == "-" && format == "y4m"
+                     ? QString( "-" )
+                     : file_path + tr( "." ) + format ),
+                   format );
+        M_main_data.setViewDataIndex( backup_index );
+        return;
+    }
+
     QString file_ext = tr( "." ) + format;
 
     //const QSize size = M_field_canvas->size();
     const QSize size( M_width->value(), M_height->value() );
-    //QImage image( M_field_canvas->size(), QImage::Format_RGB32 );
-    QImage image( size, QImage::Format_RGB32 );
+
+    // the painters share the model state, so the frames are rendered in this thread.
+    // encoding and file output, which dominate the export time, run on the worker threads.
+    QThreadPool encoder_pool;
+    encoder_pool.setMaxThreadCount( std::max( 1, QThread::idealThreadCount() ) );
+
+    // bound the number of rendered images waiting for the encoders.
+    const std::size_t max_pending = static_cast< std::size_t >( encoder_pool.maxThreadCount() ) * 2;
+    std::deque< PendingImage > pending;
 
     std::cerr << __FILE__ << ": (saveImage) "
               << "Save image size = "
-              << image.width() << " x " << image.height() << std::endl;
-
-    QPainter painter( &image );
+              << size.width() << " x " << size.height()
+              << " encoder threads = " << encoder_pool.maxThreadCount()
+              << std::endl;
 
     // show progress dialog
     QProgressDialog progress_dialog( this );
@@ -538,6 +679,7 @@ ImageSaveDialog::saveImage( const int start_cycle,
     progress_dialog.setLabelText( file_path + tr( "00000" ) + file_ext );
 
     bool confirm = true;
+    int written = first;
 
     // main loop
     for ( int i = first; i <= last; ++i )
@@ -571,38 +713,211 @@ ImageSaveDialog::saveImage( const int start_cycle,
             }
         }
 
-        progress_dialog.setValue( i );
-        progress_dialog.setLabelText( file_path_all );
-
         //QCoreApplication::processEvents();
         if ( i % 20 == 0 )
         {
             qApp->processEvents();
             if ( progress_dialog.wasCanceled() )
             {
+                encoder_pool.waitForDone();
                 M_main_data.setViewDataIndex( backup_index );
                 return;
             }
         }
 
+        // the frames are completed in order. the progress shows the last written frame.
+        while ( pending.size() >= max_pending )
+        {
+            const QString oldest_path = pending.front().first;
+            if ( ! wait_oldest_image( pending ) )
+            {
+                encoder_pool.waitForDone();
+                QMessageBox::critical( this,
+                                       tr( "Error" ),
+                                       tr( "Failed to save image file " )
+                                       + oldest_path );
+                M_main_data.setViewDataIndex( backup_index );
+                return;
+            }
+
+            progress_dialog.setValue( written++ );
+            progress_dialog.setLabelText( oldest_path );
+        }
+
         M_main_data.setViewDataIndex( i );
         M_main_data.update( size.width(), size.height() );
 
-        M_field_canvas->draw( painter );
+        // each frame has its own image, which is released by the encoder.
+        QImage image( size, QImage::Format_RGB32 );
+        {
+            QPainter painter( &image );
+            M_field_canvas->draw( painter );
+        }
 
         //std::cout << "save image " << file_path << std::endl;
-        if ( ! image.save( file_path_all, format.toLatin1() ) )
+        ImageEncodeTask * task = new ImageEncodeTask( image, file_path_all, format.toLatin1() );
+        pending.push_back( PendingImage( file_path_all, task->result() ) );
+        encoder_pool.start( task );
+    }
+
+    while ( ! pending.empty() )
+    {
+        const QString oldest_path = pending.front().first;
+        if ( ! wait_oldest_image( pending ) )
         {
+            encoder_pool.waitForDone();
             QMessageBox::critical( this,
                                    tr( "Error" ),
                                    tr( "Failed to save image file " )
-                                   + file_path_all );
+                                   + oldest_path );
             M_main_data.setViewDataIndex( backup_index );
             return;
         }
+
+        progress_dialog.setValue( written++ );
+        progress_dialog.setLabelText( oldest_path );
     }
 
     M_main_data.setViewDataIndex( backup_index );
 
     accept();
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+  The frames are rendered in this thread and converted to the video frame
+  data by the encoder threads. The converted frames are written in order.
+*/
+void
+ImageSaveDialog::saveVideo( const int first,
+                            const int last,
+                            const QString & file_path,
+                            const QString & format )
+{
+    if ( file_path != "-"
+         && QFile::exists( file_path ) )
+    {
+        int result
+            = QMessageBox::question( this,
+                                     tr( "Overwrite?" ),
+                                     tr( "There already exists a file called %1.\n Overwrite?")
+                                     .arg( file_path ),
+                                     QMessageBox::No,
+                                     QMessageBox::Yes );
+        if ( result == QMessageBox::No )
+        {
+            return;
+        }
+    }
+
+    std::unique_ptr< VideoWriter > writer = VideoWriter::create( format );
+    if ( ! writer
+         || ! writer->open( file_path,
+                            QSize( M_width->value(), M_height->value() ),
+                            M_video_fps->value() ) )
+    {
+        QMessageBox::critical( this,
+                               tr( "Error" ),
+                               tr( "Failed to open the video file " )
+                               + file_path );
+        return;
+    }
+
+    const QSize size = writer->size();
+    const int frames_per_cycle = M_frames_per_cycle->value();
+
+    std::cerr << __FILE__ << ": (saveVideo) "
+              << "Save video [" << file_path.toStdString() << "]"
+              << " size = " << size.width() << " x " << size.height()
+              << " fps = " << M_video_fps->value()
+              << std::endl;
+
+    QThreadPool encoder_pool;
+    encoder_pool.setMaxThreadCount( std::max( 1, QThread::idealThreadCount() ) );
+
+    const std::size_t max_pending = static_cast< std::size_t >( encoder_pool.maxThreadCount() ) * 2;
+    std::deque< std::future< QByteArray > > pending;
+
+    QProgressDialog progress_dialog( this );
+    progress_dialog.setWindowTitle( tr( "Video Save Progress" ) );
+    progress_dialog.setRange( first, last );
+    progress_dialog.setValue( first );
+    progress_dialog.setLabelText( file_path );
+
+    int written = first;
+    bool result = true;
+
+    for ( int i = first; i <= last + 1 && result; ++i )
+    {
+        // write the finished frames in order.
+        while ( ! pending.empty()
+                && ( pending.size() >= max_pending
+                     || i > last ) )
+        {
+            const QByteArray frame = wait_result( pending.front() );
+            pending.pop_front();
+
+            for ( int f = 0; f < frames_per_cycle && result; ++f )
+            {
+                result = writer->write( frame );
+            }
+
+            if ( ! result )
+            {
+                break;
+            }
+
+            progress_dialog.setValue( written++ );
+        }
+
+        if ( i > last
+             || ! result )
+        {
+            break;
+        }
+
+        if ( i % 20 == 0 )
+        {
+            qApp->processEvents();
+            if ( progress_dialog.wasCanceled() )
+            {
+                break;
+            }
+        }
+
+        M_main_data.setViewDataIndex( i );
+        M_main_data.update( size.width(), size.height() );
+
+        QImage image( size, QImage::Format_RGB32 );
+        {
+            QPainter painter( &image );
+            M_field_canvas->draw( painter );
+        }
+
+        VideoEncodeTask * task = new VideoEncodeTask( *writer, image );
+        pending.push_back( task->result() );
+        encoder_pool.start( task );
+    }
+
+    // the writer must outlive the encoders.
+    encoder_pool.waitForDone();
+
+    if ( ! writer->close() )
+    {
+        result = false;
+    }
+
+    if ( ! result )
+    {
+        QMessageBox::critical( this,
+                               tr( "Error" ),
+                               tr( "Failed to write the video file " )
+                               + file_path );
+        return;
+    }
+
+    if ( ! progress_dialog.wasCanceled() )
+    {
+        accept();
+    }
+}
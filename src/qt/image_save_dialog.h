@@ -68,6 +68,9 @@ private:
 
     QLineEdit * M_saved_dir;
 
+    QSpinBox * M_video_fps;
+    QSpinBox * M_frames_per_cycle;
+
 public:
 
     ImageSaveDialog( MainWindow * main_window,
@@ -82,6 +85,7 @@ private:
 
     QWidget * createImageSizeControls();
     QWidget * createCycleSelectControls();
+    QWidget * createVideoControls();
     QWidget * createFileNameControls();
     QWidget * createDirSelectControls();
     QLayout * createExecuteControls();
@@ -92,6 +96,11 @@ private:
                     const QString & name_prefix,
                     const QString & format_name );
 
+    void saveVideo( const int first,
+                    const int last,
+                    const QString & file_path,
+                    const QString & format );
+
 protected:
 
     void showEvent( QShowEvent * event );
@@ -39,9 +39,19 @@
 
 #include "options.h"
 #include "main_data.h"
+#include "latency_monitor.h"
+#include "quality_governor.h"
 
+#include <algorithm>
 #include <iostream>
 
+namespace {
+
+//! upper bound of the delay caught up by one timer event [ms]
+const qint64 MAX_CATCH_UP_MSEC = 1000;
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -51,9 +61,15 @@ LogPlayer::LogPlayer( MainData & main_data,
     : QObject( parent ),
       M_main_data( main_data ),
       M_timer( new QTimer( this ) ),
+      M_interval( Options::instance().timerInterval() ),
+      M_clock_cycles( 0 ),
       M_forward( true ),
       M_live_mode( false )
 {
+#if QT_VERSION >= 0x050000
+    M_timer->setTimerType( Qt::PreciseTimer );
+#endif
+
     connect( M_timer, SIGNAL( timeout() ),
              this, SLOT( handleTimer() ) );
 }
@@ -75,13 +91,103 @@ void
 LogPlayer::handleTimer()
 {
     //std::cerr << "LogPlayer::handleTimer" << std::endl;
-    if ( M_forward )
+
+    // the cycles due at the elapsed time, rounded to the nearest tick
+    // so that a timer event slightly earlier than expected is not lost.
+    const qint64 target = ( M_clock.elapsed() + M_interval / 2 ) / M_interval;
+    qint64 due = target - M_clock_cycles;
+    if ( due <= 0 )
     {
-        stepForwardImpl();
+        return;
+    }
+
+    if ( Options::instance().noFrameSkip() )
+    {
+        // every cycle is drawn even if the playback becomes slower.
+        due = 1;
     }
     else
     {
-        stepBackImpl();
+        // the playback clock keeps the game time even if the drawing is late.
+        // the delay over the limit, e.g. while the window is dragged, is dropped.
+        const qint64 max_due = std::max( static_cast< qint64 >( 1 ),
+                                         MAX_CATCH_UP_MSEC / M_interval );
+        due = std::min( due, max_due );
+    }
+    M_clock_cycles = target;
+
+    bool moved = false;
+    for ( qint64 i = 0; i < due; ++i )
+    {
+        if ( ! ( M_forward
+                 ? M_main_data.setViewDataStepForward()
+                 : M_main_data.setViewDataStepBack() ) )
+        {
+            break;
+        }
+        moved = true;
+    }
+
+    if ( ! moved )
+    {
+        stopPlayTimer();
+        return;
+    }
+
+    // while the quality governor skips cycles, the timer events are thinned
+    // out and the clock steps several cycles per event.
+    const int tick = ( Options::instance().noFrameSkip()
+                       ? M_interval
+                       : M_interval * QualityGovernor::instance().cycleStep() );
+    if ( M_timer->interval() != tick )
+    {
+        M_timer->start( tick );
+    }
+
+    emit updated();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LogPlayer::startPlayTimer( const int interval )
+{
+    M_interval = interval;
+    restartClock();
+    M_timer->start( M_interval );
+    QualityGovernor::instance().start( M_interval );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  The clock is restarted whenever the interval is changed, so the cycles
+  played at the old speed are not counted again.
+*/
+void
+LogPlayer::restartClock()
+{
+    M_clock.start();
+    M_clock_cycles = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  The full render quality is restored whenever the playback stops. The
+  current frame is drawn again if it was drawn with the lowered quality.
+*/
+void
+LogPlayer::stopPlayTimer()
+{
+    const bool lowered = ( QualityGovernor::instance().level() != QualityGovernor::FULL );
+
+    M_timer->stop();
+    QualityGovernor::instance().stop();
+
+    if ( lowered )
+    {
+        emit updated();
     }
 }
 
@@ -108,7 +214,7 @@ LogPlayer::stepBackImpl()
     }
     else
     {
-        M_timer->stop();
+        stopPlayTimer();
     }
 }
 
@@ -128,7 +234,7 @@ LogPlayer::stepForwardImpl()
     }
     else
     {
-        M_timer->stop();
+        stopPlayTimer();
     }
 }
 
@@ -141,7 +247,7 @@ LogPlayer::stepBack()
 {
     //std::cerr << "LogPlayer::stepBack" << std::endl;
     M_live_mode = false;
-    M_timer->stop();
+    stopPlayTimer();
 
     stepBackImpl();
 }
@@ -155,7 +261,7 @@ LogPlayer::stepForward()
 {
     //std::cerr << "LogPlayer::stepForward" << std::endl;
     M_live_mode = false;
-    M_timer->stop();
+    stopPlayTimer();
 
     stepForwardImpl();
 }
@@ -172,7 +278,7 @@ LogPlayer::playOrStop()
 
     if ( M_timer->isActive() )
     {
-        M_timer->stop();
+        stopPlayTimer();
     }
     else
     {
@@ -189,7 +295,7 @@ LogPlayer::stop()
 {
     //std::cerr << "LogPlayer::stop" << std::endl;
     M_live_mode = false;
-    M_timer->stop();
+    stopPlayTimer();
 }
 
 /*-------------------------------------------------------------------*/
@@ -205,7 +311,7 @@ LogPlayer::playBack()
 
     if ( ! M_timer->isActive() )
     {
-        M_timer->start( Options::instance().timerInterval() );
+        startPlayTimer( Options::instance().timerInterval() );
     }
 }
 
@@ -222,7 +328,7 @@ LogPlayer::playForward()
 
     if ( ! M_timer->isActive() )
     {
-        M_timer->start( Options::instance().timerInterval() );
+        startPlayTimer( Options::instance().timerInterval() );
     }
 }
 
@@ -291,7 +397,7 @@ LogPlayer::goToFirst()
     if ( M_main_data.setViewDataIndexFirst() )
     {
         M_live_mode = false;
-        M_timer->stop();
+        stopPlayTimer();
 
         emit updated();
     }
@@ -308,7 +414,7 @@ LogPlayer::goToLast()
     if ( M_main_data.setViewDataIndexLast() )
     {
         M_live_mode = false;
-        M_timer->stop();
+        stopPlayTimer();
 
         emit updated();
     }
@@ -324,9 +430,11 @@ LogPlayer::decelerate()
     //    std::cerr << "LogPlayer::decelerate" << std::endl;
     if ( M_timer->isActive() )
     {
-        int interval = M_timer->interval() * 2;
-        if ( 5000 < interval ) interval = 5000;
-        M_timer->start( interval );
+        M_interval *= 2;
+        if ( 5000 < M_interval ) M_interval = 5000;
+        QualityGovernor::instance().setInterval( M_interval );
+        restartClock();
+        M_timer->start( M_interval * QualityGovernor::instance().cycleStep() );
     }
 }
 
@@ -340,9 +448,11 @@ LogPlayer::accelerate()
     //std::cerr << "LogPlayer::accelerate" << std::endl;
     if ( M_timer->isActive() )
     {
-        int interval = M_timer->interval() / 2;
-        if ( interval < 5 ) interval = 5;
-        M_timer->start( interval );
+        M_interval /= 2;
+        if ( M_interval < 5 ) M_interval = 5;
+        QualityGovernor::instance().setInterval( M_interval );
+        restartClock();
+        M_timer->start( M_interval * QualityGovernor::instance().cycleStep() );
     }
 }
 
@@ -407,8 +517,9 @@ LogPlayer::showLive()
 {
     if ( M_main_data.setViewDataIndexLast() )
     {
-        M_timer->stop();
+        stopPlayTimer();
 
+        LatencyMonitor::instance().stampShow();
         emit updated();
     }
 }
@@ -423,7 +534,7 @@ LogPlayer::setLiveMode()
     //    std::cerr << "LogPlayer::setLiveMode" << std::endl;
     M_main_data.setViewDataIndexLast();
     M_live_mode = true;
-    M_timer->stop();
+    stopPlayTimer();
 
     //emit updated();
 }
@@ -33,6 +33,7 @@
 #define SOCCERWINDOW2_QT_LOG_PLAYER_H
 
 #include <QObject>
+#include <QElapsedTimer>
 
 #include <rcsc/game_time.h>
 
@@ -50,6 +51,11 @@ private:
     MainData & M_main_data;
 
     QTimer * M_timer;
+    int M_interval; //!< requested interval of one cycle [ms]
+
+    //! playback clock. the number of cycles to be played is given by the elapsed time.
+    QElapsedTimer M_clock;
+    qint64 M_clock_cycles; //!< the number of cycles played since the clock was started
 
     //! if true, replay direction is forward
     bool M_forward;
@@ -74,6 +80,10 @@ private:
     void stepBackImpl();
     void stepForwardImpl();
 
+    void startPlayTimer( const int interval );
+    void stopPlayTimer();
+    void restartClock();
+
 
 private slots:
 
@@ -43,6 +43,9 @@
 
 #include "log_player_tool_bar.h"
 
+#include "dominance_strip.h"
+
+#include "options.h"
 #include "main_data.h"
 
 #include <iostream>
@@ -138,7 +141,8 @@ LogPlayerToolBar::LogPlayerToolBar( const MainData & main_data,
                 parent ),
       M_main_data( main_data ),
       M_cycle_slider( static_cast< QSlider * >( 0 ) ),
-      M_cycle_edit( static_cast< QLineEdit * >( 0 ) )
+      M_cycle_edit( static_cast< QLineEdit * >( 0 ) ),
+      M_dominance_strip( static_cast< DominanceStrip * >( 0 ) )
 {
     assert( parent );
 
@@ -175,7 +179,12 @@ LogPlayerToolBar::createCycleSlider()
         return;
     }
 
-    M_cycle_slider = new CycleSlider( this->orientation(), this );
+    QWidget * slider_box = new QWidget( this );
+    QVBoxLayout * layout = new QVBoxLayout( slider_box );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->setSpacing( 0 );
+
+    M_cycle_slider = new CycleSlider( this->orientation(), slider_box );
     connect( this, SIGNAL( orientationChanged( Qt::Orientation ) ),
              M_cycle_slider, SLOT( setOrientation( Qt::Orientation ) ) );
     M_cycle_slider->setStatusTip( tr( "You can select the cycle by this slider." ) );
@@ -188,8 +197,15 @@ LogPlayerToolBar::createCycleSlider()
     //M_cycle_slider->setMinimumSize( 400, 400 );
     connect( M_cycle_slider, SIGNAL( valueChanged( int ) ),
              this, SIGNAL( indexChanged( int ) ) );
+    layout->addWidget( M_cycle_slider );
+
+    M_dominance_strip = new DominanceStrip( M_main_data, slider_box );
+    M_dominance_strip->setMaximumWidth( 640 );
+    M_dominance_strip->setVisible( Options::instance().showDominanceStrip()
+                                   && this->orientation() == Qt::Horizontal );
+    layout->addWidget( M_dominance_strip );
 
-    this->addWidget( M_cycle_slider );
+    this->addWidget( slider_box );
 }
 
 /*-------------------------------------------------------------------*/
@@ -288,6 +304,8 @@ LogPlayerToolBar::changeOrientation( Qt::Orientation orientation )
         M_cycle_slider->setMinimumSize( 200, 16 );
         M_cycle_slider->setMaximumSize( 640, 16 );
     }
+
+    updateDominanceStrip();
 #if 0
     std::cerr << "--------------------"
               << "Orientation = " << orientation << '\n'
@@ -399,4 +417,28 @@ LogPlayerToolBar::updateSlider()
     {
         M_cycle_slider->setValue( val );
     }
+
+    updateDominanceStrip();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+LogPlayerToolBar::updateDominanceStrip()
+{
+    if ( ! M_dominance_strip )
+    {
+        return;
+    }
+
+    const bool visible = ( Options::instance().showDominanceStrip()
+                           && this->orientation() == Qt::Horizontal );
+    M_dominance_strip->setVisible( visible );
+
+    if ( visible )
+    {
+        M_dominance_strip->updateSeries();
+    }
 }
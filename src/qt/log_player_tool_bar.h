@@ -41,6 +41,7 @@ class QLineEdit;
 class QMoveEvent;
 class QWidget;
 
+class DominanceStrip;
 class MainData;
 
 class LogPlayerToolBar
@@ -54,6 +55,7 @@ private:
 
     QSlider * M_cycle_slider;
     QLineEdit * M_cycle_edit;
+    DominanceStrip * M_dominance_strip;
 
 public:
 
@@ -78,6 +80,8 @@ public slots:
 
     void updateSlider();
 
+    void updateDominanceStrip();
+
 signals:
 
     void indexChanged( int idx );
@@ -36,18 +36,100 @@
 #include <QApplication>
 
 #include "main_window.h"
+#include "multi_monitor_window.h"
+#include "batch_renderer.h"
+#include "render_benchmark.h"
 #include "options.h"
+#include "main_data.h"
+#include "dominance_series.h"
+
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  analyze the game log given by the options and write the dominated area series.
+*/
+int
+write_dominance_series()
+{
+    const Options & opt = Options::instance();
+
+    if ( opt.gameLogFilePath().empty() )
+    {
+        std::cerr << "No game log file for the dominance series." << std::endl;
+        return 1;
+    }
+
+    // the debug views and the draw data are not used by the analysis.
+    MainData main_data;
+    if ( ! main_data.openRCG( opt.gameLogFilePath() )
+         || main_data.viewHolder().monitorViewCont().empty() )
+    {
+        std::cerr << "Failed to read the game log ["
+                  << opt.gameLogFilePath() << "]" << std::endl;
+        return 1;
+    }
+
+    const MonitorViewData::Cont & vc = main_data.viewHolder().monitorViewCont();
+
+    DominanceSeries series;
+    series.update( vc );
+
+    if ( opt.dominanceOutput() == "-" )
+    {
+        series.printCSV( std::cout, vc );
+        return std::cout.good() ? 0 : 1;
+    }
+
+    std::ofstream fout( opt.dominanceOutput().c_str() );
+    if ( ! fout.is_open()
+         || ! series.printCSV( fout, vc ).good() )
+    {
+        std::cerr << "Failed to write the dominance series ["
+                  << opt.dominanceOutput() << "]" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+}
 
 int
 main( int argc, char ** argv )
 {
-    std::cout << "******************************************************************\n"
-              << " " PACKAGE_NAME " " VERSION "\n"
-              << " Copyright: (C) 2005 - 2012. Hidehisa Akiyama\n"
-              << " 2011- Hidehisa Akiyama and Hiroki Shimora\n"
-              << " All rights reserved.\n"
-              << "******************************************************************\n"
-              << std::endl;
+    // the batch mode, the benchmark and the analysis do not need any display.
+    // their results may be written to the standard output.
+    bool headless = false;
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--batch-render" )
+             || ! std::strcmp( argv[i], "--benchmark-render" )
+             || ! std::strncmp( argv[i], "--dominance-output", 18 ) )
+        {
+            headless = true;
+            break;
+        }
+    }
+
+    ( headless ? std::cerr : std::cout )
+        << "******************************************************************\n"
+        << " " PACKAGE_NAME " " VERSION "\n"
+        << " Copyright: (C) 2005 - 2012. Hidehisa Akiyama\n"
+        << " 2011- Hidehisa Akiyama and Hiroki Shimora\n"
+        << " All rights reserved.\n"
+        << "******************************************************************\n"
+        << std::endl;
+
+    if ( headless
+         && qgetenv( "QT_QPA_PLATFORM" ).isEmpty() )
+    {
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+    }
 
     QApplication app( argc, argv );
 
@@ -56,6 +138,32 @@ main( int argc, char ** argv )
         return 1;
     }
 
+    if ( ! Options::instance().dominanceOutput().empty() )
+    {
+        return write_dominance_series();
+    }
+
+    if ( Options::instance().benchmarkRender() )
+    {
+        RenderBenchmark benchmark;
+        return benchmark.run();
+    }
+
+    if ( Options::instance().batchRender() )
+    {
+        BatchRenderer renderer;
+        return renderer.run();
+    }
+
+    if ( Options::instance().multiMonitorMode() )
+    {
+        MultiMonitorWindow win;
+        win.show();
+        win.init();
+
+        return app.exec();
+    }
+
     MainWindow win;
     win.show();
     win.init();
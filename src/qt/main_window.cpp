@@ -52,6 +52,7 @@
 #include "view_config_dialog.h"
 #include "debug_message_window.h"
 #include "debug_server.h"
+#include "replay_server.h"
 #include "field_canvas.h"
 #include "formation_editor_window.h"
 #include "monitor_client.h"
@@ -65,6 +66,7 @@
 
 #include "options.h"
 #include "grid_field_evaluation_data.h"
+#include "latency_monitor.h"
 
 #include <rcsc/common/server_param.h>
 
@@ -113,6 +115,7 @@
  */
 MainWindow::MainWindow()
     : M_log_player( new LogPlayer( M_main_data, this ) ),
+      M_latency_label( static_cast< QLabel * >( 0 ) ),
       M_detail_dialog( static_cast< DetailDialog * >( 0 ) ),
       M_player_type_dialog( static_cast< PlayerTypeDialog * >( 0 ) ),
       M_trainer_dialog( static_cast< TrainerDialog * >( 0 ) ),
@@ -124,6 +127,7 @@ MainWindow::MainWindow()
       M_debug_message_window( static_cast< DebugMessageWindow * >( 0 ) ),
       M_monitor_client( static_cast< MonitorClient * >( 0 ) ),
       M_debug_server( static_cast< DebugServer * >( 0 ) ),
+      M_replay_server( static_cast< ReplayServer * >( 0 ) ),
       M_last_gamelog_dir( "" ),
       M_last_connected_host( "127.0.0.1" )
 {
@@ -194,6 +198,12 @@ MainWindow::~MainWindow()
     {
         killServer();
     }
+
+    if ( ! Options::instance().latencyLogFile().empty() )
+    {
+        LatencyMonitor::instance().dump( Options::instance().latencyLogFile() );
+    }
+
     saveSettings();
     saveShortcutKeysSettings();
 }
@@ -210,6 +220,11 @@ MainWindow::init()
         openDrawData( QString::fromStdString( Options::instance().drawDataFile() ) );
     }
 
+    if ( ! Options::instance().replayServerFile().empty() )
+    {
+        startReplayServer();
+    }
+
     if ( ! Options::instance().gameLogFilePath().empty() )
     {
         openRCG( QString::fromStdString( Options::instance().gameLogFilePath() ) );
@@ -782,6 +797,24 @@ MainWindow::createActionsView()
         this->addAction( act );
     }
     //
+    M_toggle_profile_hud_act = new QAction( tr( "Profile HUD" ), this );
+    M_toggle_profile_hud_act->setObjectName( "toggle_profile_hud" );
+    M_toggle_profile_hud_act->setStatusTip( tr( "Show/Hide the drawing time of each painter" ) );
+    M_toggle_profile_hud_act->setCheckable( true );
+    M_toggle_profile_hud_act->setChecked( Options::instance().showProfileHUD() );
+    connect( M_toggle_profile_hud_act, SIGNAL( toggled( bool ) ),
+             this, SLOT( toggleProfileHUD( bool ) ) );
+    this->addAction( M_toggle_profile_hud_act );
+    //
+    M_toggle_dominance_strip_act = new QAction( tr( "Dominance Strip" ), this );
+    M_toggle_dominance_strip_act->setObjectName( "toggle_dominance_strip" );
+    M_toggle_dominance_strip_act->setStatusTip( tr( "Show/Hide the area dominated by each team under the cycle slider" ) );
+    M_toggle_dominance_strip_act->setCheckable( true );
+    M_toggle_dominance_strip_act->setChecked( Options::instance().showDominanceStrip() );
+    connect( M_toggle_dominance_strip_act, SIGNAL( toggled( bool ) ),
+             this, SLOT( toggleDominanceStrip( bool ) ) );
+    this->addAction( M_toggle_dominance_strip_act );
+    //
     M_show_player_type_dialog_act = new QAction( tr( "Player Type List" ), this );
 #ifdef Q_WS_MAC
     M_show_player_type_dialog_act->setShortcut( Qt::META + Qt::Key_H );
@@ -1276,6 +1309,16 @@ MainWindow::createActionsLogPlayer()
              M_log_player, SLOT( accelerate() ) );
     this->addAction( M_log_player_shift_up_act );
 
+    //
+    M_log_player_no_frame_skip_act = new QAction( tr( "Never Skip Cycles" ), this );
+    M_log_player_no_frame_skip_act->setObjectName( "log_player_no_frame_skip" );
+    M_log_player_no_frame_skip_act->setStatusTip( tr( "Draw every cycle even if the replay becomes slower than the speed." ) );
+    M_log_player_no_frame_skip_act->setCheckable( true );
+    M_log_player_no_frame_skip_act->setChecked( Options::instance().noFrameSkip() );
+    connect( M_log_player_no_frame_skip_act, SIGNAL( toggled( bool ) ),
+             this, SLOT( toggleNoFrameSkip( bool ) ) );
+    this->addAction( M_log_player_no_frame_skip_act );
+
     //
     // invisible actions
     //
@@ -1519,6 +1562,7 @@ MainWindow::createMenuLogPlayer()
 
     menu->addAction( M_log_player_shift_down_act );
     menu->addAction( M_log_player_shift_up_act );
+    menu->addAction( M_log_player_no_frame_skip_act );
     //#endif
 }
 
@@ -1536,6 +1580,8 @@ MainWindow::createMenuView()
 
     menu->addSeparator();
     menu->addAction( M_full_screen_act );
+    menu->addAction( M_toggle_profile_hud_act );
+    menu->addAction( M_toggle_dominance_strip_act );
 
     menu->addSeparator();
     menu->addAction( M_show_player_type_dialog_act );
@@ -1675,6 +1721,7 @@ MainWindow::createToolBars()
     M_log_player_tool_bar->addAction( M_log_player_go_last_act );
     M_log_player_tool_bar->addAction( M_log_player_shift_down_act );
     M_log_player_tool_bar->addAction( M_log_player_shift_up_act );
+    M_log_player_tool_bar->addAction( M_log_player_no_frame_skip_act );
 
     M_log_player_tool_bar->createCycleSlider();
     M_log_player_tool_bar->createCycleEdit();
@@ -1758,6 +1805,19 @@ MainWindow::createStatusBar()
 
     this->statusBar()->addPermanentWidget( M_position_label );
 
+    if ( Options::instance().latencyMonitor() )
+    {
+        LatencyMonitor::instance().setEnabled( true );
+
+        M_latency_label = new QLabel( QString::fromStdString( LatencyMonitor::instance().summary() ) );
+        this->statusBar()->addPermanentWidget( M_latency_label );
+
+        QTimer * timer = new QTimer( this );
+        connect( timer, SIGNAL( timeout() ),
+                 this, SLOT( updateLatencyLabel() ) );
+        timer->start( 1000 );
+    }
+
     //QSlider * slider = new QSlider( Qt::Horizontal );
     //this->statusBar()->addWidget( slider );
 
@@ -2677,6 +2737,8 @@ MainWindow::connectMonitorTo( const char * hostname )
         startDebugServer();
     }
 
+    M_main_data.startAutoRecording( hostname );
+
     Options::instance().setMonitorClientMode( true );
 
     M_save_rcg_act->setEnabled( false );
@@ -2737,6 +2799,8 @@ MainWindow::disconnectMonitor()
         M_debug_server = static_cast< DebugServer * >( 0 );
     }
 
+    M_main_data.stopAutoRecording();
+
     Options::instance().setMonitorClientMode( false );
 
     M_save_rcg_act->setEnabled( true );
@@ -2940,6 +3004,47 @@ MainWindow::toggleFullScreen()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MainWindow::toggleProfileHUD( bool checked )
+{
+    if ( Options::instance().showProfileHUD() != checked )
+    {
+        Options::instance().toggleShowProfileHUD();
+        M_field_canvas->update();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MainWindow::toggleDominanceStrip( bool checked )
+{
+    if ( Options::instance().showDominanceStrip() != checked )
+    {
+        Options::instance().toggleShowDominanceStrip();
+        M_log_player_tool_bar->updateDominanceStrip();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MainWindow::toggleNoFrameSkip( bool checked )
+{
+    if ( Options::instance().noFrameSkip() != checked )
+    {
+        Options::instance().toggleNoFrameSkip();
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -3161,6 +3266,37 @@ MainWindow::stopDebugServer()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MainWindow::startReplayServer()
+{
+    if ( M_replay_server )
+    {
+        return;
+    }
+
+    const Options & opt = Options::instance();
+
+    M_replay_server = new ReplayServer( this,
+                                        opt.replayServerFile(),
+                                        opt.replayServerPort(),
+                                        opt.replayServerRate(),
+                                        opt.replayServerLoss(),
+                                        opt.replayServerReorder(),
+                                        opt.replayServerSeed() );
+
+    if ( ! M_replay_server->open() )
+    {
+        std::cerr << __FILE__ << ": (startReplayServer) "
+                  << "failed to start the replay server" << std::endl;
+        delete M_replay_server;
+        M_replay_server = static_cast< ReplayServer * >( 0 );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -3373,6 +3509,21 @@ MainWindow::updatePositionLabel( const QPoint & point )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MainWindow::updateLatencyLabel()
+{
+    if ( M_latency_label
+         && statusBar()
+         && statusBar()->isVisible() )
+    {
+        M_latency_label->setText( QString::fromStdString( LatencyMonitor::instance().summary() ) );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -51,6 +51,7 @@ class QString;
 
 class DebugMessageWindow;
 class DebugServer;
+class ReplayServer;
 class DetailDialog;
 class FieldCanvas;
 class FormationEditorWindow;
@@ -81,6 +82,7 @@ private:
     //QToolBar * M_monitor_tool_bar;
 
     QLabel * M_position_label;
+    QLabel * M_latency_label; //!< live latency summary. null if not measured.
 
     DetailDialog * M_detail_dialog;
     PlayerTypeDialog * M_player_type_dialog;
@@ -96,6 +98,7 @@ private:
 
     MonitorClient * M_monitor_client;
     DebugServer * M_debug_server;
+    ReplayServer * M_replay_server;
 
     QString M_last_gamelog_dir;
     QString M_last_connected_host;
@@ -131,6 +134,8 @@ private:
     QAction * M_toggle_tool_bar_act;
     QAction * M_toggle_status_bar_act;
     QAction * M_full_screen_act;
+    QAction * M_toggle_profile_hud_act;
+    QAction * M_toggle_dominance_strip_act;
     QAction * M_show_player_type_dialog_act;
     QAction * M_show_detail_dialog_act;
     QActionGroup * M_style_act_group;
@@ -184,6 +189,7 @@ private:
     QAction * M_log_player_stop_act;
     QAction * M_log_player_play_back_act;
     QAction * M_log_player_play_forward_act;
+    QAction * M_log_player_no_frame_skip_act;
 
     // editor actions
     QAction * M_show_formation_editor_window_act;
@@ -294,6 +300,9 @@ private slots:
     void toggleToolBar();
     void toggleStatusBar();
     void toggleFullScreen();
+    void toggleProfileHUD( bool checked );
+    void toggleDominanceStrip( bool checked );
+    void toggleNoFrameSkip( bool checked );
     void showPlayerTypeDialog();
     void showDetailDialog();
     void changeStyle( bool checked );
@@ -310,6 +319,7 @@ private slots:
     void toggleDebugServer( bool on );
     void startDebugServer();
     void stopDebugServer();
+    void startReplayServer();
     void showImageSaveDialog();
 
     // help menu actions slots
@@ -325,6 +335,7 @@ public slots:
     void receiveMonitorPacket();
 
     void updatePositionLabel( const QPoint & point );
+    void updateLatencyLabel();
 
     void dropBallThere();
     void dropBall( const QPoint & pos );
@@ -34,11 +34,15 @@
 #endif
 
 #include <QtNetwork>
+#include <QThread>
 
 #include "monitor_client.h"
+#include "monitor_receiver.h"
+#include "monitor_relay.h"
 
 #include "options.h"
 #include "main_data.h"
+#include "latency_monitor.h"
 
 #include <rcsc/trainer/trainer_command.h>
 #include <rcsc/monitor/monitor_command.h>
@@ -76,6 +80,10 @@ MonitorClient::MonitorClient( QObject * parent,
       M_main_data( main_data ),
       M_socket( new QUdpSocket( this ) ),
       M_timer( new QTimer( this ) ),
+      M_thread( static_cast< QThread * >( 0 ) ),
+      M_receiver( static_cast< MonitorReceiver * >( 0 ) ),
+      M_receiver_opened( false ),
+      M_relay( static_cast< MonitorRelay * >( 0 ) ),
       M_version( version ),
       M_waited_msec( 0 )
 {
@@ -99,6 +107,18 @@ MonitorClient::MonitorClient( QObject * parent,
     M_impl->server_addr_ = host.addresses().front();
     M_impl->server_port_ = port;
 
+    if ( Options::instance().relayPort() > 0 )
+    {
+        createRelay();
+    }
+
+    if ( Options::instance().monitorThread() )
+    {
+        startReceiverThread();
+        connect( M_timer, SIGNAL( timeout() ), this, SLOT( handleTimer() ) );
+        return;
+    }
+
     // setReadBufferSize() makes no effect for UdpSocet...
     //M_socket->setReadBufferSize( 8192 * 256 );
 
@@ -119,6 +139,13 @@ MonitorClient::MonitorClient( QObject * parent,
         return;
     }
 
+    if ( M_relay
+         && ! M_relay->open() )
+    {
+        delete M_relay;
+        M_relay = static_cast< MonitorRelay * >( 0 );
+    }
+
     connect( M_socket, SIGNAL( readyRead() ), this, SLOT( handleReceive() ) );
     connect( M_timer, SIGNAL( timeout() ), this, SLOT( handleTimer() ) );
 }
@@ -130,6 +157,10 @@ MonitorClient::MonitorClient( QObject * parent,
 MonitorClient::~MonitorClient()
 {
     disconnect();
+    stopReceiverThread();
+
+    delete M_relay;
+    M_relay = static_cast< MonitorRelay * >( 0 );
 
     //std::cerr << "delete MonitorClient" << std::endl;
 }
@@ -149,8 +180,110 @@ MonitorClient::disconnect()
     if ( isConnected() )
     {
         sendDispBye();
-        M_socket->close();
+
+        if ( M_receiver )
+        {
+            // queued after the bye command
+            QMetaObject::invokeMethod( M_receiver, "close", Qt::BlockingQueuedConnection );
+            M_receiver_opened = false;
+        }
+        else
+        {
+            M_socket->close();
+        }
+    }
+
+    if ( M_relay )
+    {
+        if ( M_thread )
+        {
+            QMetaObject::invokeMethod( M_relay, "close", Qt::BlockingQueuedConnection );
+        }
+        else
+        {
+            M_relay->close();
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorClient::createRelay()
+{
+    M_relay = new MonitorRelay( M_version,
+                                static_cast< quint16 >( Options::instance().relayPort() ),
+                                Options::instance().relayMaxClients() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorClient::startReceiverThread()
+{
+    M_thread = new QThread( this );
+    M_receiver = new MonitorReceiver( M_impl->server_addr_,
+                                      M_impl->server_port_,
+                                      M_version );
+    M_receiver->moveToThread( M_thread );
+
+    if ( M_relay )
+    {
+        // forwarded directly from the receive loop in the network thread.
+        M_relay->moveToThread( M_thread );
+        M_receiver->setRelay( M_relay );
+    }
+
+    connect( M_receiver, SIGNAL( framesReady() ),
+             this, SLOT( handleFrames() ),
+             Qt::QueuedConnection );
+
+    M_thread->start();
+
+    // the socket must be created in the thread that uses it.
+    bool result = false;
+    QMetaObject::invokeMethod( M_receiver, "open",
+                               Qt::BlockingQueuedConnection,
+                               Q_RETURN_ARG( bool, result ) );
+    M_receiver_opened = result;
+
+    if ( M_relay )
+    {
+        bool relay_result = false;
+        QMetaObject::invokeMethod( M_relay, "open",
+                                   Qt::BlockingQueuedConnection,
+                                   Q_RETURN_ARG( bool, relay_result ) );
+        if ( ! relay_result )
+        {
+            std::cerr << __FILE__ << ": the monitor relay is not available." << std::endl;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorClient::stopReceiverThread()
+{
+    if ( ! M_thread )
+    {
+        return;
     }
+
+    M_thread->quit();
+    M_thread->wait();
+
+    delete M_receiver;
+    M_receiver = static_cast< MonitorReceiver * >( 0 );
+
+    delete M_thread;
+    M_thread = static_cast< QThread * >( 0 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -160,6 +293,11 @@ MonitorClient::disconnect()
 bool
 MonitorClient::isConnected() const
 {
+    if ( M_receiver )
+    {
+        return M_receiver_opened;
+    }
+
     return ( M_socket->socketDescriptor() != -1 );
 }
 
@@ -184,6 +322,8 @@ MonitorClient::handleReceive()
                                             &from_port );
             if ( n > 0 )
             {
+                LatencyMonitor::instance().stampReceive();
+                if ( M_relay ) M_relay->forward( buf, n );
                 if ( ! M_main_data.receiveMonitorPacket( buf, M_version ) )
                 {
                     std::cerr << PACKAGE_NAME << " recv: " << buf << std::endl;
@@ -215,6 +355,8 @@ MonitorClient::handleReceive()
                                             &from_port );
             if ( n > 0 )
             {
+                LatencyMonitor::instance().stampReceive();
+                if ( M_relay ) M_relay->forward( reinterpret_cast< const char * >( &disp2 ), n );
                 if ( ! M_main_data.receiveMonitorPacket( disp2 ) )
                 {
                     std::cerr << PACKAGE_NAME << " recv: "
@@ -248,6 +390,8 @@ MonitorClient::handleReceive()
                                              &from_port );
             if ( n > 0 )
             {
+                LatencyMonitor::instance().stampReceive();
+                if ( M_relay ) M_relay->forward( reinterpret_cast< const char * >( &disp1 ), n );
                 if ( ! M_main_data.receiveMonitorPacket( disp1 ) )
                 {
                     std::cerr << PACKAGE_NAME << " recv: "
@@ -279,6 +423,40 @@ MonitorClient::handleReceive()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+MonitorClient::handleFrames()
+{
+    if ( ! M_receiver )
+    {
+        return;
+    }
+
+    // reset the flag before draining not to miss the frames pushed meanwhile.
+    M_receiver->acknowledge();
+
+    int receive_count = 0;
+
+    MonitorFrame::ConstPtr frame;
+    while ( M_receiver->popFrame( frame ) )
+    {
+        M_main_data.receiveMonitorFrame( *frame );
+        ++receive_count;
+    }
+
+    if ( receive_count > 0 )
+    {
+        M_waited_msec = 0;
+        M_timer->start( POLL_INTERVAL_MS );
+
+        // the canvas is updated only once for all drained frames.
+        emit received();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 MonitorClient::handleTimer()
@@ -303,6 +481,29 @@ MonitorClient::handleTimer()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+MonitorClient::sendCommandString( const std::string & com_str )
+{
+    if ( M_receiver )
+    {
+        QMetaObject::invokeMethod( M_receiver, "send",
+                                   Qt::QueuedConnection,
+                                   Q_ARG( QByteArray, QByteArray( com_str.c_str(),
+                                                                  com_str.length() + 1 ) ) );
+    }
+    else
+    {
+        M_socket->writeDatagram( com_str.c_str(), com_str.length() + 1,
+                                 M_impl->server_addr_,
+                                 M_impl->server_port_ );
+    }
+    std::cerr << PACKAGE_NAME <<  " send: " << com_str << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 MonitorClient::sendCommand( const rcsc::MonitorCommand & com )
@@ -315,11 +516,7 @@ MonitorClient::sendCommand( const rcsc::MonitorCommand & com )
     std::ostringstream ostr;
     com.toCommandString( ostr );
 
-    std::string com_str = ostr.str();
-    M_socket->writeDatagram( com_str.c_str(), com_str.length() + 1,
-                             M_impl->server_addr_,
-                             M_impl->server_port_ );
-    std::cerr << PACKAGE_NAME <<  " send: " << com_str << std::endl;
+    sendCommandString( ostr.str() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -337,11 +534,7 @@ MonitorClient::sendCommand( const rcsc::TrainerCommand & com )
     std::ostringstream ostr;
     com.toCommandString( ostr );
 
-    std::string com_str = ostr.str();
-    M_socket->writeDatagram( com_str.c_str(), com_str.length() + 1,
-                             M_impl->server_addr_,
-                             M_impl->server_port_ );
-    std::cerr << PACKAGE_NAME << " send: " << com_str << std::endl;
+    sendCommandString( ostr.str() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -38,6 +38,7 @@
 
 #include <memory>
 
+class QThread;
 class QTimer;
 class QUdpSocket;
 
@@ -47,6 +48,8 @@ class TrainerCommand;
 }
 
 class MainData;
+class MonitorReceiver;
+class MonitorRelay;
 
 //! monitor client that connect to the rcssserver
 class MonitorClient
@@ -65,6 +68,14 @@ private:
     QUdpSocket * M_socket;
     QTimer * M_timer;
 
+    //! network thread. null if packets are received in the GUI thread.
+    QThread * M_thread;
+    MonitorReceiver * M_receiver;
+    bool M_receiver_opened;
+
+    //! downstream monitor relay. null if not enabled.
+    MonitorRelay * M_relay;
+
     int M_version; //!< protocol version
 
     int M_waited_msec;
@@ -90,6 +101,12 @@ public:
 
 private:
 
+    void createRelay();
+
+    void startReceiverThread();
+    void stopReceiverThread();
+
+    void sendCommandString( const std::string & com_str );
     void sendCommand( const rcsc::MonitorCommand & com );
     void sendCommand( const rcsc::TrainerCommand & com );
 
@@ -174,6 +191,7 @@ public:
 private slots:
 
     void handleReceive();
+    void handleFrames();
     void handleTimer();
 
 
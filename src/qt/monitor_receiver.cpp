@@ -0,0 +1,249 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_receiver.cpp
+  \brief monitor packet receiver running in the network thread Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtNetwork>
+
+#include "monitor_receiver.h"
+#include "monitor_relay.h"
+
+#include <rcsc/rcg/parser_v4.h>
+#include <rcsc/rcg/types.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace {
+//! about 40 seconds of live data at the default simulator step
+const std::size_t QUEUE_CAPACITY = 4096;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorReceiver::MonitorReceiver( const QHostAddress & server_addr,
+                                  const quint16 server_port,
+                                  const int version )
+    : QObject( 0 ),
+      M_socket( static_cast< QUdpSocket * >( 0 ) ),
+      M_server_addr( server_addr ),
+      M_server_port( server_port ),
+      M_version( version ),
+      M_relay( static_cast< MonitorRelay * >( 0 ) ),
+      M_queue( QUEUE_CAPACITY ),
+      M_notified( false ),
+      M_dropped( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorReceiver::~MonitorReceiver()
+{
+    if ( M_dropped.load() > 0 )
+    {
+        std::cerr << PACKAGE_NAME << ": dropped " << M_dropped.load()
+                  << " monitor frames." << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorReceiver::open()
+{
+    if ( ! M_socket )
+    {
+        M_socket = new QUdpSocket( this );
+    }
+
+    // INADDR_ANY, bind random created port to local
+    if ( ! M_socket->bind( 0 ) )
+    {
+        std::cerr << __FILE__ << ": failed to bind the socket."
+                  << std::endl;
+        return false;
+    }
+
+    if ( M_socket->socketDescriptor() == -1 )
+    {
+        std::cerr << __FILE__ << " failed to initialize the socket."
+                  << std::endl;
+        return false;
+    }
+
+    connect( M_socket, SIGNAL( readyRead() ), this, SLOT( handleReceive() ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorReceiver::close()
+{
+    if ( M_socket )
+    {
+        M_socket->close();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorReceiver::send( const QByteArray & data )
+{
+    if ( ! M_socket
+         || M_socket->socketDescriptor() == -1 )
+    {
+        return;
+    }
+
+    M_socket->writeDatagram( data, M_server_addr, M_server_port );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorReceiver::handleReceive()
+{
+    std::vector< char > buf( 8192 );
+
+    while ( M_socket->hasPendingDatagrams() )
+    {
+        const qint64 size = M_socket->pendingDatagramSize();
+        if ( size >= static_cast< qint64 >( buf.size() ) )
+        {
+            buf.resize( size + 1 );
+        }
+
+        quint16 from_port;
+        const qint64 n = M_socket->readDatagram( &buf[0],
+                                                 buf.size() - 1,
+                                                 0, // QHostAddress
+                                                 &from_port );
+        if ( n <= 0 )
+        {
+            continue;
+        }
+        buf[n] = '\0';
+
+        if ( M_relay )
+        {
+            // forward before decoding not to add the parse time to the downstream latency.
+            M_relay->forward( &buf[0], n );
+        }
+
+        M_builder.setReceiveTime( std::chrono::steady_clock::now() );
+
+        bool result = false;
+        if ( M_version >= 3 )
+        {
+            rcsc::rcg::ParserV4 p;
+            result = p.parseLine( 0, &buf[0], M_builder );
+        }
+        else if ( M_version == 2 )
+        {
+            if ( n >= static_cast< qint64 >( sizeof( rcsc::rcg::dispinfo_t2 ) ) )
+            {
+                result = M_builder.handleDispInfo2( *reinterpret_cast< const rcsc::rcg::dispinfo_t2 * >( &buf[0] ) );
+            }
+        }
+        else if ( M_version == 1 )
+        {
+            if ( n >= static_cast< qint64 >( sizeof( rcsc::rcg::dispinfo_t ) ) )
+            {
+                result = M_builder.handleDispInfo( *reinterpret_cast< const rcsc::rcg::dispinfo_t * >( &buf[0] ) );
+            }
+        }
+
+        if ( ! result )
+        {
+            std::cerr << PACKAGE_NAME << " recv: " << &buf[0] << std::endl;
+        }
+
+        publish();
+
+        if ( from_port != M_server_port )
+        {
+            std::cerr << PACKAGE_NAME << " updated server port number = "
+                      << from_port << std::endl;
+            M_server_port = from_port;
+        }
+    }
+
+    if ( ! M_queue.empty()
+         && ! M_notified.exchange( true, std::memory_order_acq_rel ) )
+    {
+        emit framesReady();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorReceiver::publish()
+{
+    MonitorFrame::ConstPtr frame = M_builder.take();
+    if ( ! frame )
+    {
+        return;
+    }
+
+    if ( ! M_queue.push( frame ) )
+    {
+        // the GUI thread is stalled. drop the newest frame rather than blocking the socket.
+        // the state events are not sent again by the server, so they are
+        // carried over to the next frame.
+        if ( frame->hasState() )
+        {
+            M_builder.carryState( *frame );
+        }
+        M_dropped.fetch_add( 1, std::memory_order_relaxed );
+    }
+}
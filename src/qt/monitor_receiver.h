@@ -0,0 +1,148 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_receiver.h
+  \brief monitor packet receiver running in the network thread Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_MONITOR_RECEIVER_H
+#define SOCCERWINDOW2_QT_MONITOR_RECEIVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHostAddress>
+
+#include "monitor_frame.h"
+#include "spsc_queue.h"
+
+#include <atomic>
+
+class QUdpSocket;
+
+class MonitorRelay;
+
+/*!
+  \class MonitorReceiver
+  \brief owns the monitor socket in a dedicated thread.
+
+  Datagrams are decoded into MonitorFrame instances in the network thread
+  and handed over to the GUI thread through a lock-free queue.
+  framesReady() is emitted at most once until the consumer calls acknowledge(),
+  so a busy GUI thread receives one notification for a burst of packets.
+ */
+class MonitorReceiver
+    : public QObject {
+
+    Q_OBJECT
+
+private:
+
+    QUdpSocket * M_socket;
+
+    QHostAddress M_server_addr;
+    quint16 M_server_port;
+
+    const int M_version; //!< protocol version
+
+    MonitorFrameBuilder M_builder;
+
+    //! optional relay that lives in the same thread. not owned.
+    MonitorRelay * M_relay;
+
+    SPSCQueue< MonitorFrame::ConstPtr > M_queue;
+
+    //! true if framesReady() has been emitted but not acknowledged yet
+    std::atomic< bool > M_notified;
+
+    //! number of frames dropped because the queue was full
+    std::atomic< long > M_dropped;
+
+    //! not used
+    MonitorReceiver();
+    MonitorReceiver( const MonitorReceiver & );
+    MonitorReceiver & operator=( const MonitorReceiver & );
+
+public:
+
+    MonitorReceiver( const QHostAddress & server_addr,
+                     const quint16 server_port,
+                     const int version );
+
+    ~MonitorReceiver();
+
+    //! set the relay object. must be called before the thread is started.
+    void setRelay( MonitorRelay * relay )
+      {
+          M_relay = relay;
+      }
+
+    //
+    // the following methods must be called only from the consumer thread.
+    //
+
+    //! reset the notification flag. call this before popFrame().
+    void acknowledge()
+      {
+          M_notified.store( false, std::memory_order_release );
+      }
+
+    bool popFrame( MonitorFrame::ConstPtr & frame )
+      {
+          return M_queue.pop( frame );
+      }
+
+    long droppedCount() const
+      {
+          return M_dropped.load( std::memory_order_relaxed );
+      }
+
+public slots:
+
+    //! create and bind the socket. must be invoked in the network thread.
+    bool open();
+
+    //! close the socket. must be invoked in the network thread.
+    void close();
+
+    //! send a command datagram to the server.
+    void send( const QByteArray & data );
+
+private slots:
+
+    void handleReceive();
+
+private:
+
+    void publish();
+
+signals:
+
+    void framesReady();
+
+};
+
+#endif
@@ -0,0 +1,585 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_relay.cpp
+  \brief monitor data relay Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtNetwork>
+#include <QtEndian>
+
+#include "monitor_relay.h"
+
+#include <rcsc/rcg/types.h>
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+
+namespace {
+
+//! a TCP peer is closed if it cannot consume this amount of buffered data
+const qint64 MAX_PENDING_BYTES = 4 * 1024 * 1024;
+
+//! player_type datagrams retained for late joiners
+const std::size_t MAX_PLAYER_TYPES = 64;
+
+//! a UDP peer is dropped if no datagram is received from it within this period
+const qint64 UDP_PEER_TIMEOUT_MSEC = 5 * 60 * 1000;
+
+enum DatagramType {
+    DATAGRAM_OTHER,
+    DATAGRAM_SHOW,
+    DATAGRAM_TEAM,
+    DATAGRAM_PLAYMODE,
+    DATAGRAM_PLAYER_TYPE,
+    DATAGRAM_SERVER_PARAM,
+    DATAGRAM_PLAYER_PARAM,
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief classify the upstream datagram without parsing its body.
+*/
+DatagramType
+datagram_type( const char * data,
+               const qint64 size,
+               const int version )
+{
+    if ( version >= 3 )
+    {
+        static const struct {
+            const char * prefix_;
+            DatagramType type_;
+        } s_table[] = {
+            { "(show ", DATAGRAM_SHOW },
+            { "(team ", DATAGRAM_TEAM },
+            { "(playmode ", DATAGRAM_PLAYMODE },
+            { "(player_type ", DATAGRAM_PLAYER_TYPE },
+            { "(server_param ", DATAGRAM_SERVER_PARAM },
+            { "(player_param ", DATAGRAM_PLAYER_PARAM },
+        };
+
+        for ( std::size_t i = 0; i < sizeof( s_table ) / sizeof( s_table[0] ); ++i )
+        {
+            const qint64 len = static_cast< qint64 >( std::strlen( s_table[i].prefix_ ) );
+            if ( size >= len
+                 && std::strncmp( data, s_table[i].prefix_, len ) == 0 )
+            {
+                return s_table[i].type_;
+            }
+        }
+
+        return DATAGRAM_OTHER;
+    }
+
+    if ( size < static_cast< qint64 >( sizeof( qint16 ) ) )
+    {
+        return DATAGRAM_OTHER;
+    }
+
+    // dispinfo_t and dispinfo_t2 start with the mode in network byte order.
+    switch ( qFromBigEndian< qint16 >( reinterpret_cast< const uchar * >( data ) ) ) {
+    case rcsc::rcg::SHOW_MODE:
+        return DATAGRAM_SHOW;
+    case rcsc::rcg::PM_MODE:
+        return DATAGRAM_PLAYMODE;
+    case rcsc::rcg::TEAM_MODE:
+        return DATAGRAM_TEAM;
+    case rcsc::rcg::PT_MODE:
+        return DATAGRAM_PLAYER_TYPE;
+    case rcsc::rcg::PARAM_MODE:
+        return DATAGRAM_SERVER_PARAM;
+    case rcsc::rcg::PPARAM_MODE:
+        return DATAGRAM_PLAYER_PARAM;
+    default:
+        break;
+    }
+
+    return DATAGRAM_OTHER;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorRelay::MonitorRelay( const int version,
+                            const quint16 port,
+                            const int max_clients )
+    : QObject( 0 ),
+      M_version( version ),
+      M_port( port ),
+      M_max_clients( max_clients ),
+      M_udp_socket( static_cast< QUdpSocket * >( 0 ) ),
+      M_tcp_server( static_cast< QTcpServer * >( 0 ) )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorRelay::~MonitorRelay()
+{
+    close();
+
+    if ( M_stats.joined_ > 0 )
+    {
+        std::cerr << PACKAGE_NAME << " relay:"
+                  << " datagrams=" << M_stats.datagrams_
+                  << " sent=" << M_stats.sent_bytes_ << "[byte]"
+                  << " joined=" << M_stats.joined_
+                  << " rejected=" << M_stats.rejected_
+                  << " dropped=" << M_stats.dropped_
+                  << " expired=" << M_stats.expired_
+                  << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorRelay::open()
+{
+    if ( ! M_udp_socket )
+    {
+        M_udp_socket = new QUdpSocket( this );
+    }
+
+    if ( ! M_udp_socket->bind( M_port ) )
+    {
+        std::cerr << __FILE__ << ": failed to bind the relay port "
+                  << M_port << std::endl;
+        return false;
+    }
+
+    connect( M_udp_socket, SIGNAL( readyRead() ),
+             this, SLOT( handleUdpReceive() ) );
+
+    if ( ! M_tcp_server )
+    {
+        M_tcp_server = new QTcpServer( this );
+    }
+
+    if ( ! M_tcp_server->listen( QHostAddress::Any, M_port ) )
+    {
+        std::cerr << __FILE__ << ": failed to listen the relay port "
+                  << M_port << " : "
+                  << M_tcp_server->errorString().toStdString() << std::endl;
+        return false;
+    }
+
+    connect( M_tcp_server, SIGNAL( newConnection() ),
+             this, SLOT( handleNewTcpConnection() ) );
+
+    M_clock.start();
+
+    std::cerr << PACKAGE_NAME << ": relay the monitor data on port " << M_port << std::endl;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::close()
+{
+    M_udp_peers.clear();
+
+    for ( std::vector< QTcpSocket * >::iterator it = M_tcp_peers.begin(), end = M_tcp_peers.end();
+          it != end;
+          ++it )
+    {
+        QObject::disconnect( *it, 0, this, 0 );
+        (*it)->abort();
+        (*it)->deleteLater();
+    }
+    M_tcp_peers.clear();
+
+    if ( M_udp_socket )
+    {
+        M_udp_socket->close();
+    }
+
+    if ( M_tcp_server )
+    {
+        M_tcp_server->close();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::forward( const char * data,
+                       const qint64 size )
+{
+    if ( size <= 0 )
+    {
+        return;
+    }
+
+    ++M_stats.datagrams_;
+
+    retain( data, size );
+    expireUdpPeers();
+
+    for ( std::vector< UdpPeer >::const_iterator it = M_udp_peers.begin(), end = M_udp_peers.end();
+          it != end;
+          ++it )
+    {
+        sendTo( *it, data, size );
+    }
+
+    std::vector< QTcpSocket * >::iterator it = M_tcp_peers.begin();
+    while ( it != M_tcp_peers.end() )
+    {
+        if ( sendTo( *it, data, size ) )
+        {
+            ++it;
+            continue;
+        }
+
+        // a slow viewer must not delay the others.
+        ++M_stats.dropped_;
+        QTcpSocket * socket = *it;
+        it = M_tcp_peers.erase( it );
+        QObject::disconnect( socket, 0, this, 0 );
+        socket->abort();
+        socket->deleteLater();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::expireUdpPeers()
+{
+    if ( ! M_clock.isValid() )
+    {
+        return;
+    }
+
+    const qint64 now = M_clock.elapsed();
+
+    std::vector< UdpPeer >::iterator it = M_udp_peers.begin();
+    while ( it != M_udp_peers.end() )
+    {
+        if ( now - it->last_seen_ <= UDP_PEER_TIMEOUT_MSEC )
+        {
+            ++it;
+            continue;
+        }
+
+        ++M_stats.expired_;
+        std::cerr << PACKAGE_NAME << " relay: no response from "
+                  << it->addr_.toString().toStdString() << ":" << it->port_
+                  << ". dropped" << std::endl;
+        it = M_udp_peers.erase( it );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::retain( const char * data,
+                      const qint64 size )
+{
+    switch ( datagram_type( data, size, M_version ) ) {
+    case DATAGRAM_SHOW:
+        M_show = QByteArray( data, size );
+        break;
+    case DATAGRAM_TEAM:
+        M_team = QByteArray( data, size );
+        break;
+    case DATAGRAM_PLAYMODE:
+        M_playmode = QByteArray( data, size );
+        break;
+    case DATAGRAM_PLAYER_TYPE:
+        if ( M_player_types.size() < MAX_PLAYER_TYPES )
+        {
+            M_player_types.push_back( QByteArray( data, size ) );
+        }
+        break;
+    case DATAGRAM_SERVER_PARAM:
+        // a new parameter set is followed by new player types.
+        M_server_param = QByteArray( data, size );
+        M_player_types.clear();
+        break;
+    case DATAGRAM_PLAYER_PARAM:
+        M_player_param = QByteArray( data, size );
+        break;
+    default:
+        break;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::vector< const QByteArray * >
+MonitorRelay::catchUpData() const
+{
+    std::vector< const QByteArray * > data;
+
+    if ( ! M_server_param.isEmpty() ) data.push_back( &M_server_param );
+    if ( ! M_player_param.isEmpty() ) data.push_back( &M_player_param );
+    for ( std::vector< QByteArray >::const_iterator it = M_player_types.begin(), end = M_player_types.end();
+          it != end;
+          ++it )
+    {
+        data.push_back( &(*it) );
+    }
+    if ( ! M_team.isEmpty() ) data.push_back( &M_team );
+    if ( ! M_playmode.isEmpty() ) data.push_back( &M_playmode );
+    if ( ! M_show.isEmpty() ) data.push_back( &M_show );
+
+    return data;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::sendCatchUp( const UdpPeer & peer )
+{
+    const std::vector< const QByteArray * > data = catchUpData();
+    for ( std::vector< const QByteArray * >::const_iterator it = data.begin(), end = data.end();
+          it != end;
+          ++it )
+    {
+        sendTo( peer, (*it)->constData(), (*it)->size() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::sendCatchUp( QTcpSocket * socket )
+{
+    const std::vector< const QByteArray * > data = catchUpData();
+    for ( std::vector< const QByteArray * >::const_iterator it = data.begin(), end = data.end();
+          it != end;
+          ++it )
+    {
+        sendTo( socket, (*it)->constData(), (*it)->size() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::sendTo( const UdpPeer & peer,
+                      const char * data,
+                      const qint64 size )
+{
+    const qint64 n = M_udp_socket->writeDatagram( data, size, peer.addr_, peer.port_ );
+    if ( n > 0 )
+    {
+        M_stats.sent_bytes_ += n;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorRelay::sendTo( QTcpSocket * socket,
+                      const char * data,
+                      const qint64 size )
+{
+    if ( socket->bytesToWrite() > MAX_PENDING_BYTES )
+    {
+        return false;
+    }
+
+    uchar header[4];
+    qToBigEndian< quint32 >( static_cast< quint32 >( size ), header );
+
+    socket->write( reinterpret_cast< const char * >( header ), sizeof( header ) );
+    socket->write( data, size );
+
+    M_stats.sent_bytes_ += sizeof( header ) + size;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::handleUdpReceive()
+{
+    char buf[512];
+
+    while ( M_udp_socket->hasPendingDatagrams() )
+    {
+        QHostAddress addr;
+        quint16 port = 0;
+        const qint64 n = M_udp_socket->readDatagram( buf, sizeof( buf ) - 1, &addr, &port );
+        if ( n <= 0 )
+        {
+            continue;
+        }
+        buf[n] = '\0';
+
+        std::vector< UdpPeer >::iterator it = M_udp_peers.begin();
+        for ( ; it != M_udp_peers.end(); ++it )
+        {
+            if ( it->addr_ == addr
+                 && it->port_ == port )
+            {
+                break;
+            }
+        }
+
+        const qint64 now = ( M_clock.isValid() ? M_clock.elapsed() : 0 );
+        if ( it != M_udp_peers.end() )
+        {
+            it->last_seen_ = now;
+        }
+
+        if ( ! std::strncmp( buf, "(dispinit", 9 ) )
+        {
+            if ( it != M_udp_peers.end() )
+            {
+                // retransmitted init command
+                continue;
+            }
+
+            if ( clientCount() >= M_max_clients )
+            {
+                ++M_stats.rejected_;
+                std::cerr << PACKAGE_NAME << " relay: too many clients. rejected "
+                          << addr.toString().toStdString() << ":" << port << std::endl;
+                continue;
+            }
+
+            int version = 1;
+            std::sscanf( buf, " ( dispinit version %d", &version );
+            if ( version != M_version )
+            {
+                std::cerr << PACKAGE_NAME << " relay: "
+                          << addr.toString().toStdString() << ":" << port
+                          << " requested version " << version
+                          << ", but the relay forwards version " << M_version << std::endl;
+            }
+
+            UdpPeer peer;
+            peer.addr_ = addr;
+            peer.port_ = port;
+            peer.last_seen_ = now;
+            M_udp_peers.push_back( peer );
+            ++M_stats.joined_;
+
+            sendCatchUp( peer );
+        }
+        else if ( ! std::strncmp( buf, "(dispbye", 8 ) )
+        {
+            if ( it != M_udp_peers.end() )
+            {
+                M_udp_peers.erase( it );
+            }
+        }
+        // other commands are not forwarded. downstream monitors are viewers only.
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::handleNewTcpConnection()
+{
+    while ( QTcpSocket * socket = M_tcp_server->nextPendingConnection() )
+    {
+        if ( clientCount() >= M_max_clients )
+        {
+            ++M_stats.rejected_;
+            socket->abort();
+            socket->deleteLater();
+            continue;
+        }
+
+        // downstream data is ignored. keep the read buffer small.
+        socket->setReadBufferSize( 1 );
+
+        connect( socket, SIGNAL( disconnected() ),
+                 this, SLOT( handleTcpDisconnected() ) );
+
+        M_tcp_peers.push_back( socket );
+        ++M_stats.joined_;
+
+        sendCatchUp( socket );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorRelay::handleTcpDisconnected()
+{
+    QTcpSocket * socket = qobject_cast< QTcpSocket * >( sender() );
+    if ( ! socket )
+    {
+        return;
+    }
+
+    std::vector< QTcpSocket * >::iterator it = std::find( M_tcp_peers.begin(), M_tcp_peers.end(), socket );
+    if ( it != M_tcp_peers.end() )
+    {
+        M_tcp_peers.erase( it );
+    }
+
+    socket->deleteLater();
+}
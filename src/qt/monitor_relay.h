@@ -0,0 +1,188 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_relay.h
+  \brief monitor data relay Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_MONITOR_RELAY_H
+#define SOCCERWINDOW2_QT_MONITOR_RELAY_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHostAddress>
+#include <QElapsedTimer>
+
+#include <vector>
+
+class QTcpServer;
+class QTcpSocket;
+class QUdpSocket;
+
+/*!
+  \class MonitorRelay
+  \brief re-broadcasts the datagrams received from rcssserver to downstream monitors.
+
+  Downstream monitors connect to the relay port in the same way as to rcssserver,
+  i.e., send "(dispinit ...)" by UDP. A TCP connection receives the same data
+  with a 4 byte big-endian length header for each datagram.
+
+  Datagrams are forwarded from the receive buffer without being parsed again.
+  The latest parameter, team, playmode and show datagrams are retained so that
+  a late joiner receives them at once instead of waiting for the server.
+
+  A UDP peer that has sent nothing for a while is dropped as rcssserver
+  drops a silent monitor, because a closed viewer cannot be detected
+  otherwise. Any datagram from the peer, e.g. a retransmitted "(dispinit)",
+  keeps it alive.
+
+  All methods must be called in the thread that owns this object.
+ */
+class MonitorRelay
+    : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    //! relay statistics
+    struct Stats {
+        qint64 datagrams_; //!< number of forwarded upstream datagrams
+        qint64 sent_bytes_; //!< total bytes sent to all peers
+        qint64 joined_; //!< number of accepted peers
+        qint64 rejected_; //!< number of peers rejected by the client limit
+        qint64 dropped_; //!< number of TCP peers closed because they could not keep up
+        qint64 expired_; //!< number of UDP peers dropped because they were silent
+
+        Stats()
+            : datagrams_( 0 ),
+              sent_bytes_( 0 ),
+              joined_( 0 ),
+              rejected_( 0 ),
+              dropped_( 0 ),
+              expired_( 0 )
+          { }
+    };
+
+private:
+
+    struct UdpPeer {
+        QHostAddress addr_;
+        quint16 port_;
+        qint64 last_seen_; //!< M_clock time of the last datagram from the peer
+    };
+
+    const int M_version; //!< upstream protocol version
+    const quint16 M_port;
+    const int M_max_clients;
+
+    QUdpSocket * M_udp_socket;
+    QTcpServer * M_tcp_server;
+
+    QElapsedTimer M_clock; //!< started by open()
+    std::vector< UdpPeer > M_udp_peers;
+    std::vector< QTcpSocket * > M_tcp_peers;
+
+    // catch-up data
+    QByteArray M_server_param;
+    QByteArray M_player_param;
+    std::vector< QByteArray > M_player_types;
+    QByteArray M_team;
+    QByteArray M_playmode;
+    QByteArray M_show;
+
+    Stats M_stats;
+
+    //! not used
+    MonitorRelay();
+    MonitorRelay( const MonitorRelay & );
+    MonitorRelay & operator=( const MonitorRelay & );
+
+public:
+
+    MonitorRelay( const int version,
+                  const quint16 port,
+                  const int max_clients );
+
+    ~MonitorRelay();
+
+    /*!
+      \brief send an upstream datagram to all downstream monitors.
+      \param data datagram buffer. not retained unless it is a catch-up datagram.
+      \param size datagram length
+     */
+    void forward( const char * data,
+                  const qint64 size );
+
+    const Stats & stats() const
+      {
+          return M_stats;
+      }
+
+public slots:
+
+    //! create the sockets. must be invoked in the thread that owns this object.
+    bool open();
+
+    //! close all connections.
+    void close();
+
+private:
+
+    void retain( const char * data,
+                 const qint64 size );
+
+    //! retained datagrams in the order a new monitor expects them
+    std::vector< const QByteArray * > catchUpData() const;
+
+    //! drop the UDP peers that have been silent longer than the timeout
+    void expireUdpPeers();
+
+    void sendCatchUp( const UdpPeer & peer );
+    void sendCatchUp( QTcpSocket * socket );
+
+    void sendTo( const UdpPeer & peer,
+                 const char * data,
+                 const qint64 size );
+    bool sendTo( QTcpSocket * socket,
+                 const char * data,
+                 const qint64 size );
+
+    int clientCount() const
+      {
+          return static_cast< int >( M_udp_peers.size() + M_tcp_peers.size() );
+      }
+
+private slots:
+
+    void handleUdpReceive();
+    void handleNewTcpConnection();
+    void handleTcpDisconnected();
+
+};
+
+#endif
@@ -0,0 +1,294 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_tile.cpp
+  \brief single server monitor tile Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGlobal>
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QtWidgets>
+#else
+#include <QtGui>
+#endif
+
+#include "monitor_tile.h"
+
+#include "field_canvas.h"
+#include "monitor_client.h"
+
+#include "options.h"
+
+#include <sstream>
+#include <iostream>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorTile::MonitorTile( const std::string & host,
+                          const int port,
+                          QWidget * parent )
+    : QFrame( parent ),
+      M_host( host ),
+      M_port( port ),
+      M_title_label( new QLabel() ),
+      M_field_canvas( new FieldCanvas( M_main_data ) ),
+      M_monitor_client( static_cast< MonitorClient * >( 0 ) ),
+      M_repaint_timer( new QTimer( this ) ),
+      M_focused( false ),
+      M_dirty( false )
+{
+    this->setFrameStyle( QFrame::Box | QFrame::Plain );
+    this->setLineWidth( 1 );
+
+    M_field_canvas->setMinimumSize( 160, 120 );
+    M_field_canvas->installEventFilter( this );
+
+    QVBoxLayout * layout = new QVBoxLayout();
+    layout->setContentsMargins( 1, 1, 1, 1 );
+    layout->setSpacing( 0 );
+    layout->addWidget( M_title_label );
+    layout->addWidget( M_field_canvas, 1 );
+    this->setLayout( layout );
+
+    M_repaint_timer->setInterval( 1000 / Options::instance().unfocusedFPS() );
+    connect( M_repaint_timer, SIGNAL( timeout() ),
+             this, SLOT( repaintIfDirty() ) );
+    M_repaint_timer->start();
+
+    updateTitle();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MonitorTile::~MonitorTile()
+{
+    disconnectMonitor();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+QString
+MonitorTile::title() const
+{
+    return QString( "%1:%2" )
+        .arg( QString::fromStdString( M_host ) )
+        .arg( M_port );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorTile::isConnected() const
+{
+    return ( M_monitor_client
+             && M_monitor_client->isConnected() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorTile::setFocused( const bool on )
+{
+    if ( M_focused == on )
+    {
+        return;
+    }
+
+    M_focused = on;
+    this->setLineWidth( on ? 3 : 1 );
+    updateTitle();
+
+    if ( M_focused )
+    {
+        repaintIfDirty();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorTile::eventFilter( QObject * watched,
+                          QEvent * event )
+{
+    if ( watched == M_field_canvas
+         && ( event->type() == QEvent::FocusIn
+              || event->type() == QEvent::MouseButtonPress ) )
+    {
+        emit focusRequested( this );
+    }
+
+    return QFrame::eventFilter( watched, event );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorTile::updateTitle()
+{
+    QString text = title();
+
+    if ( ! isConnected() )
+    {
+        text += tr( "  (disconnected)" );
+    }
+
+    QFont font = M_title_label->font();
+    font.setBold( M_focused );
+    M_title_label->setFont( font );
+    M_title_label->setText( text );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MonitorTile::connectMonitor()
+{
+    if ( M_monitor_client )
+    {
+        disconnectMonitor();
+    }
+
+    std::cerr << "Connect to rcssserver on [" << M_host << ":" << M_port << "]" << std::endl;
+
+    M_monitor_client = new MonitorClient( this,
+                                          M_main_data,
+                                          M_host.c_str(),
+                                          M_port,
+                                          Options::instance().clientVersion() );
+
+    if ( ! M_monitor_client->isConnected() )
+    {
+        std::cerr << __FILE__ << ": (connectMonitor) "
+                  << "Conenction failed. " << M_host << ":" << M_port << std::endl;
+        delete M_monitor_client;
+        M_monitor_client = static_cast< MonitorClient * >( 0 );
+        updateTitle();
+        return false;
+    }
+
+    M_main_data.clear();
+
+    {
+        std::ostringstream tag;
+        tag << M_host << '_' << M_port;
+        M_main_data.startAutoRecording( tag.str() );
+    }
+
+    connect( M_monitor_client, SIGNAL( received() ),
+             this, SLOT( receiveMonitorPacket() ) );
+    connect( M_monitor_client, SIGNAL( timeout() ),
+             this, SLOT( disconnectMonitor() ) );
+
+    M_main_data.setViewDataIndexLast();
+    M_monitor_client->sendDispInit();
+
+    updateTitle();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorTile::disconnectMonitor()
+{
+    if ( M_monitor_client )
+    {
+        M_monitor_client->disconnect();
+
+        disconnect( M_monitor_client, SIGNAL( received() ),
+                    this, SLOT( receiveMonitorPacket() ) );
+        disconnect( M_monitor_client, SIGNAL( timeout() ),
+                    this, SLOT( disconnectMonitor() ) );
+
+        M_monitor_client->deleteLater();
+        M_monitor_client = static_cast< MonitorClient * >( 0 );
+    }
+
+    M_main_data.stopAutoRecording();
+
+    updateTitle();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorTile::receiveMonitorPacket()
+{
+    if ( ! M_main_data.setViewDataIndexLast() )
+    {
+        return;
+    }
+
+    M_dirty = true;
+
+    if ( M_focused )
+    {
+        repaintIfDirty();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MonitorTile::repaintIfDirty()
+{
+    if ( ! M_dirty
+         || ! M_field_canvas->isVisible() )
+    {
+        return;
+    }
+
+    M_dirty = false;
+    M_field_canvas->update();
+}
@@ -0,0 +1,138 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_tile.h
+  \brief single server monitor tile Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_MONITOR_TILE_H
+#define SOCCERWINDOW2_QT_MONITOR_TILE_H
+
+#include <QFrame>
+
+#include "main_data.h"
+
+#include <string>
+
+class QEvent;
+class QLabel;
+class QTimer;
+
+class FieldCanvas;
+class MonitorClient;
+
+/*!
+  \class MonitorTile
+  \brief one rcssserver connection shown in the multi monitor window.
+
+  Each tile owns its own MainData and MonitorClient.
+  The focused tile is repainted on every received packet,
+  while unfocused tiles coalesce updates and repaint at Options::unfocusedFPS().
+*/
+class MonitorTile
+    : public QFrame {
+
+    Q_OBJECT
+
+private:
+
+    MainData M_main_data;
+
+    const std::string M_host;
+    const int M_port;
+
+    QLabel * M_title_label;
+    FieldCanvas * M_field_canvas;
+    MonitorClient * M_monitor_client;
+
+    QTimer * M_repaint_timer;
+    bool M_focused;
+    bool M_dirty; //!< true if a packet was received after the last repaint
+
+    // not used
+    MonitorTile( const MonitorTile & );
+    const MonitorTile & operator=( const MonitorTile & );
+
+public:
+
+    MonitorTile( const std::string & host,
+                 const int port,
+                 QWidget * parent = 0 );
+    ~MonitorTile();
+
+    const std::string & host() const
+      {
+          return M_host;
+      }
+
+    int port() const
+      {
+          return M_port;
+      }
+
+    QString title() const;
+
+    const MainData & mainData() const
+      {
+          return M_main_data;
+      }
+
+    bool isConnected() const;
+
+    bool isFocused() const
+      {
+          return M_focused;
+      }
+
+    void setFocused( const bool on );
+
+protected:
+
+    bool eventFilter( QObject * watched,
+                      QEvent * event );
+
+private:
+
+    void updateTitle();
+
+public slots:
+
+    bool connectMonitor();
+    void disconnectMonitor();
+
+private slots:
+
+    void receiveMonitorPacket();
+    void repaintIfDirty();
+
+signals:
+
+    void focusRequested( MonitorTile * tile );
+
+};
+
+#endif
@@ -0,0 +1,368 @@
+// -*-c++-*-
+
+/*!
+  \file multi_monitor_window.cpp
+  \brief multi server monitor window Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGlobal>
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QtWidgets>
+#else
+#include <QtGui>
+#endif
+
+#include "multi_monitor_window.h"
+
+#include "monitor_tile.h"
+
+#include "options.h"
+
+#include "xpm/soccerwindow2.xpm"
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MultiMonitorWindow::MultiMonitorWindow()
+    : M_stack( new QStackedWidget() ),
+      M_grid_page( new QWidget() ),
+      M_tab_widget( new QTabWidget() ),
+      M_focused_tile( static_cast< MonitorTile * >( 0 ) )
+{
+    M_stack->addWidget( M_grid_page );
+    M_stack->addWidget( M_tab_widget );
+    this->setCentralWidget( M_stack );
+
+    connect( M_tab_widget, SIGNAL( currentChanged( int ) ),
+             this, SLOT( changeCurrentTab( int ) ) );
+
+    createActions();
+    createMenus();
+    createTiles();
+
+    layoutTiles();
+
+    this->setWindowIcon( QIcon( QPixmap( soccerwindow2_xpm ) ) );
+    this->setWindowTitle( tr( PACKAGE_NAME " - multi monitor" ) );
+    this->resize( 1280, 800 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MultiMonitorWindow::~MultiMonitorWindow()
+{
+    //std::cerr << "delete MultiMonitorWindow" << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::init()
+{
+    if ( Options::instance().maximize() )
+    {
+        this->showMaximized();
+    }
+
+    if ( Options::instance().fullScreen() )
+    {
+        this->showFullScreen();
+    }
+
+    reconnectAll();
+
+    if ( ! M_tiles.empty() )
+    {
+        focusTile( M_tiles.front() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::createActions()
+{
+    M_layout_group = new QActionGroup( this );
+
+    M_tile_layout_act = new QAction( tr( "&Tile" ), this );
+    M_tile_layout_act->setShortcut( Qt::CTRL + Qt::Key_T );
+    M_tile_layout_act->setStatusTip( tr( "Arrange all monitors in a grid" ) );
+    M_tile_layout_act->setCheckable( true );
+    M_layout_group->addAction( M_tile_layout_act );
+
+    M_tab_layout_act = new QAction( tr( "T&ab" ), this );
+    M_tab_layout_act->setShortcut( Qt::CTRL + Qt::SHIFT + Qt::Key_T );
+    M_tab_layout_act->setStatusTip( tr( "Show each monitor in its own tab" ) );
+    M_tab_layout_act->setCheckable( true );
+    M_layout_group->addAction( M_tab_layout_act );
+
+    if ( Options::instance().multiMonitorLayout() == Options::MULTI_MONITOR_TAB )
+    {
+        M_tab_layout_act->setChecked( true );
+    }
+    else
+    {
+        M_tile_layout_act->setChecked( true );
+    }
+
+    connect( M_layout_group, SIGNAL( triggered( QAction * ) ),
+             this, SLOT( changeLayout( QAction * ) ) );
+
+    M_focus_next_act = new QAction( tr( "&Focus Next" ), this );
+    M_focus_next_act->setShortcut( Qt::Key_Tab );
+    M_focus_next_act->setStatusTip( tr( "Move the focus to the next monitor" ) );
+    connect( M_focus_next_act, SIGNAL( triggered() ),
+             this, SLOT( focusNextTile() ) );
+    this->addAction( M_focus_next_act );
+
+    M_reconnect_all_act = new QAction( tr( "&Reconnect All" ), this );
+    M_reconnect_all_act->setStatusTip( tr( "Reconnect to all rcssservers" ) );
+    connect( M_reconnect_all_act, SIGNAL( triggered() ),
+             this, SLOT( reconnectAll() ) );
+
+    M_exit_act = new QAction( tr( "&Quit" ), this );
+    M_exit_act->setShortcut( Qt::CTRL + Qt::Key_Q );
+    M_exit_act->setStatusTip( tr( "Exit the application." ) );
+    connect( M_exit_act, SIGNAL( triggered() ),
+             this, SLOT( close() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::createMenus()
+{
+    {
+        QMenu * menu = menuBar()->addMenu( tr( "&Monitor" ) );
+        menu->addAction( M_reconnect_all_act );
+        menu->addSeparator();
+        menu->addAction( M_exit_act );
+    }
+    {
+        QMenu * menu = menuBar()->addMenu( tr( "&View" ) );
+        menu->addAction( M_tile_layout_act );
+        menu->addAction( M_tab_layout_act );
+        menu->addSeparator();
+        menu->addAction( M_focus_next_act );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::createTiles()
+{
+    const std::vector< std::pair< std::string, int > > & servers = Options::instance().monitorServers();
+
+    for ( std::vector< std::pair< std::string, int > >::const_iterator it = servers.begin(), end = servers.end();
+          it != end;
+          ++it )
+    {
+        MonitorTile * tile = new MonitorTile( it->first, it->second );
+        connect( tile, SIGNAL( focusRequested( MonitorTile * ) ),
+                 this, SLOT( focusTile( MonitorTile * ) ) );
+        M_tiles.push_back( tile );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::layoutTiles()
+{
+    // adding a tile to the other container reparents it.
+
+    if ( M_tab_layout_act->isChecked() )
+    {
+        M_tab_widget->blockSignals( true );
+        for ( std::vector< MonitorTile * >::iterator it = M_tiles.begin(), end = M_tiles.end();
+              it != end;
+              ++it )
+        {
+            M_tab_widget->addTab( *it, (*it)->title() );
+        }
+        M_tab_widget->blockSignals( false );
+
+        delete M_grid_page->layout();
+
+        M_stack->setCurrentWidget( M_tab_widget );
+
+        if ( M_focused_tile )
+        {
+            M_tab_widget->setCurrentWidget( M_focused_tile );
+        }
+        changeCurrentTab( M_tab_widget->currentIndex() );
+    }
+    else
+    {
+        delete M_grid_page->layout();
+
+        const int cols = std::max( 1, static_cast< int >( std::ceil( std::sqrt( static_cast< double >( M_tiles.size() ) ) ) ) );
+
+        QGridLayout * layout = new QGridLayout();
+        layout->setContentsMargins( 0, 0, 0, 0 );
+        layout->setSpacing( 2 );
+
+        M_tab_widget->blockSignals( true );
+        for ( size_t i = 0; i < M_tiles.size(); ++i )
+        {
+            layout->addWidget( M_tiles[i], i / cols, i % cols );
+        }
+        M_tab_widget->clear();
+        M_tab_widget->blockSignals( false );
+
+        M_grid_page->setLayout( layout );
+        M_stack->setCurrentWidget( M_grid_page );
+
+        for ( std::vector< MonitorTile * >::iterator it = M_tiles.begin(), end = M_tiles.end();
+              it != end;
+              ++it )
+        {
+            (*it)->show();
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::changeLayout( QAction * )
+{
+    layoutTiles();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::focusTile( MonitorTile * tile )
+{
+    if ( M_focused_tile == tile )
+    {
+        return;
+    }
+
+    if ( M_focused_tile )
+    {
+        M_focused_tile->setFocused( false );
+    }
+
+    M_focused_tile = tile;
+
+    if ( M_focused_tile )
+    {
+        M_focused_tile->setFocused( true );
+        this->statusBar()->showMessage( M_focused_tile->title() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::focusNextTile()
+{
+    if ( M_tiles.empty() )
+    {
+        return;
+    }
+
+    size_t next = 0;
+    for ( size_t i = 0; i < M_tiles.size(); ++i )
+    {
+        if ( M_tiles[i] == M_focused_tile )
+        {
+            next = ( i + 1 ) % M_tiles.size();
+            break;
+        }
+    }
+
+    if ( M_stack->currentWidget() == M_tab_widget )
+    {
+        M_tab_widget->setCurrentWidget( M_tiles[next] );
+    }
+    else
+    {
+        focusTile( M_tiles[next] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::changeCurrentTab( int index )
+{
+    if ( index < 0 )
+    {
+        return;
+    }
+
+    focusTile( qobject_cast< MonitorTile * >( M_tab_widget->widget( index ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+MultiMonitorWindow::reconnectAll()
+{
+    for ( std::vector< MonitorTile * >::iterator it = M_tiles.begin(), end = M_tiles.end();
+          it != end;
+          ++it )
+    {
+        (*it)->connectMonitor();
+    }
+}
@@ -0,0 +1,108 @@
+// -*-c++-*-
+
+/*!
+  \file multi_monitor_window.h
+  \brief multi server monitor window Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_MULTI_MONITOR_WINDOW_H
+#define SOCCERWINDOW2_QT_MULTI_MONITOR_WINDOW_H
+
+#include <QMainWindow>
+
+#include <vector>
+
+class QAction;
+class QActionGroup;
+class QStackedWidget;
+class QTabWidget;
+class QWidget;
+
+class MonitorTile;
+
+/*!
+  \class MultiMonitorWindow
+  \brief top level window that watches several rcssservers at once.
+
+  Tiles are arranged in a grid or in tabs.
+  DrawConfig, fonts and the field painter are shared by all tiles.
+*/
+class MultiMonitorWindow
+    : public QMainWindow {
+
+    Q_OBJECT
+
+private:
+
+    std::vector< MonitorTile * > M_tiles;
+
+    QStackedWidget * M_stack;
+    QWidget * M_grid_page;
+    QTabWidget * M_tab_widget;
+
+    MonitorTile * M_focused_tile;
+
+    QActionGroup * M_layout_group;
+    QAction * M_tile_layout_act;
+    QAction * M_tab_layout_act;
+    QAction * M_focus_next_act;
+    QAction * M_reconnect_all_act;
+    QAction * M_exit_act;
+
+    // not used
+    MultiMonitorWindow( const MultiMonitorWindow & );
+    const MultiMonitorWindow & operator=( const MultiMonitorWindow & );
+
+public:
+
+    MultiMonitorWindow();
+    ~MultiMonitorWindow();
+
+    /*!
+      \brief connect all tiles. this method should be called just after show().
+    */
+    void init();
+
+private:
+
+    void createActions();
+    void createMenus();
+    void createTiles();
+
+    void layoutTiles();
+
+private slots:
+
+    void changeLayout( QAction * act );
+    void focusTile( MonitorTile * tile );
+    void focusNextTile();
+    void changeCurrentTab( int index );
+    void reconnectAll();
+
+};
+
+#endif
@@ -0,0 +1,310 @@
+// -*-c++-*-
+
+/*!
+  \file player_area_cache.cpp
+  \brief player area geometry cache class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "player_area_cache.h"
+
+#include "options.h"
+
+#include <rcsc/common/player_type.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/geom/angle_deg.h>
+#include <rcsc/geom/line_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief add the catchable sector and its edge lines.
+  \param path output path
+  \param catch_length catchable length of the player type
+*/
+void
+add_catch_sector( QPainterPath & path,
+                  const double catch_length )
+{
+    const Options & opt = Options::instance();
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    const double catch_dist = std::sqrt( std::pow( catch_length, 2 )
+                                         + std::pow( SP.catchAreaWidth() * 0.5, 2 ) );
+    const double diagonal_angle = rcsc::AngleDeg::atan2_deg( SP.catchAreaWidth() * 0.5,
+                                                             catch_length );
+    const double r = opt.scale( catch_dist );
+    const QRectF rect( -r, -r, r * 2.0, r * 2.0 );
+
+    const double start_angle = std::rint( SP.minCatchAngle() - diagonal_angle );
+    const double span_angle = std::rint( SP.maxCatchAngle() - SP.minCatchAngle() + diagonal_angle * 2.0 );
+
+    path.arcMoveTo( rect, start_angle );
+    path.arcTo( rect, start_angle, span_angle );
+
+    const rcsc::Vector2D start_pos = rcsc::Vector2D::polar2vector( catch_dist,
+                                                                   SP.maxCatchAngle() + diagonal_angle );
+    const rcsc::Vector2D end_pos = rcsc::Vector2D::polar2vector( catch_dist,
+                                                                 SP.minCatchAngle() - diagonal_angle );
+    const rcsc::Line2D body_line( rcsc::Vector2D( 0.0, 0.0 ), rcsc::AngleDeg( 0.0 ) );
+    const rcsc::Line2D start_line( start_pos, rcsc::AngleDeg( SP.minCatchAngle() ) );
+
+    rcsc::Vector2D mid = body_line.intersection( start_line );
+    if ( ! mid.isValid() )
+    {
+        mid = ( start_pos + end_pos ) * 0.5;
+    }
+
+    path.moveTo( opt.scale( start_pos.x ), opt.scale( start_pos.y ) );
+    path.lineTo( opt.scale( mid.x ), opt.scale( mid.y ) );
+    path.lineTo( opt.scale( end_pos.x ), opt.scale( end_pos.y ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+add_catch_circle( QPainterPath & path,
+                  const double catch_length )
+{
+    const Options & opt = Options::instance();
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    const double r = opt.scale( std::sqrt( std::pow( catch_length, 2 )
+                                           + std::pow( SP.catchAreaWidth() * 0.5, 2 ) ) );
+    path.addEllipse( QRectF( -r, -r, r * 2.0, r * 2.0 ) );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerAreaCache::PlayerAreaCache()
+    : M_field_scale( 0.0 ),
+      M_catch_area_width( 0.0 ),
+      M_min_catch_angle( 0.0 ),
+      M_max_catch_angle( 0.0 ),
+      M_tackle_dist( 0.0 ),
+      M_tackle_back_dist( 0.0 ),
+      M_tackle_width( 0.0 ),
+      M_visible_distance( 0.0 ),
+      M_max_dash_power( 0.0 ),
+      M_min_dash_power( 0.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerAreaCache::clear()
+{
+    M_catch_areas.clear();
+    M_dash_areas.clear();
+    M_view_cones.clear();
+    M_tackle_area.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerAreaCache::update()
+{
+    const Options & opt = Options::instance();
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    if ( M_field_scale == opt.fieldScale()
+         && M_catch_area_width == SP.catchAreaWidth()
+         && M_min_catch_angle == SP.minCatchAngle()
+         && M_max_catch_angle == SP.maxCatchAngle()
+         && M_tackle_dist == SP.tackleDist()
+         && M_tackle_back_dist == SP.tackleBackDist()
+         && M_tackle_width == SP.tackleWidth()
+         && M_visible_distance == SP.visibleDistance()
+         && M_max_dash_power == SP.maxDashPower()
+         && M_min_dash_power == SP.minDashPower() )
+    {
+        return;
+    }
+
+    clear();
+
+    M_field_scale = opt.fieldScale();
+    M_catch_area_width = SP.catchAreaWidth();
+    M_min_catch_angle = SP.minCatchAngle();
+    M_max_catch_angle = SP.maxCatchAngle();
+    M_tackle_dist = SP.tackleDist();
+    M_tackle_back_dist = SP.tackleBackDist();
+    M_tackle_width = SP.tackleWidth();
+    M_visible_distance = SP.visibleDistance();
+    M_max_dash_power = SP.maxDashPower();
+    M_min_dash_power = SP.minDashPower();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const PlayerAreaCache::CatchArea &
+PlayerAreaCache::catchArea( const int type,
+                            const rcsc::PlayerType & ptype )
+{
+    CatchArea & area = M_catch_areas[type];
+
+    if ( ! area.reliable_.isEmpty()
+         && area.reliable_length_ == ptype.reliableCatchLength()
+         && area.max_length_ == ptype.maxCatchLength() )
+    {
+        return area;
+    }
+
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    area.reliable_length_ = ptype.reliableCatchLength();
+    area.max_length_ = ptype.maxCatchLength();
+    area.reliable_ = QPainterPath();
+    area.unreliable_ = QPainterPath();
+
+    const double reliable_diagonal_angle = rcsc::AngleDeg::atan2_deg( SP.catchAreaWidth() * 0.5,
+                                                                      ptype.reliableCatchLength() );
+    if ( SP.minCatchAngle() - reliable_diagonal_angle > -180.0 )
+    {
+        add_catch_sector( area.unreliable_, ptype.maxCatchLength() );
+        add_catch_sector( area.reliable_, ptype.reliableCatchLength() );
+    }
+    else
+    {
+        if ( ptype.maxCatchLength() > ptype.reliableCatchLength() )
+        {
+            add_catch_circle( area.unreliable_, ptype.maxCatchLength() );
+        }
+        add_catch_circle( area.reliable_, ptype.reliableCatchLength() );
+    }
+
+    return area;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const PlayerAreaCache::DashArea &
+PlayerAreaCache::dashArea( const int type,
+                           const rcsc::PlayerType & ptype )
+{
+    const Options & opt = Options::instance();
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+    const double max_accel = ptype.dashPowerRate() * ptype.effortMax();
+
+    DashArea & area = M_dash_areas[type];
+
+    if ( ! area.polygon_.isEmpty()
+         && area.max_accel_ == max_accel )
+    {
+        return area;
+    }
+
+    area.max_accel_ = max_accel;
+    area.polygon_.clear();
+
+    for ( double dir = -180.0; dir < 180.0; dir += 45.0 )
+    {
+        const double front_max_accel = SP.maxDashPower() * max_accel * SP.dashDirRate( dir );
+        const double back_max_accel = SP.minDashPower() * max_accel
+            * SP.dashDirRate( rcsc::AngleDeg::normalize_angle( dir + 180.0 ) );
+        const rcsc::Vector2D pos = rcsc::Vector2D::from_polar( std::max( front_max_accel,
+                                                                         std::fabs( back_max_accel ) ),
+                                                               dir );
+        area.polygon_.push_back( QPointF( opt.scale( pos.x ), opt.scale( pos.y ) ) );
+    }
+
+    return area;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const QPainterPath &
+PlayerAreaCache::viewCone( const double view_width )
+{
+    QPainterPath & path = M_view_cones[view_width];
+
+    if ( path.isEmpty() )
+    {
+        const double r = Options::instance().scale( rcsc::ServerParam::i().visibleDistance() );
+
+        path.moveTo( 0.0, 0.0 );
+        path.arcTo( -r, -r, r * 2.0, r * 2.0,
+                    -view_width * 0.5, view_width );
+        path.closeSubpath();
+    }
+
+    return path;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const QPolygonF &
+PlayerAreaCache::tackleArea()
+{
+    if ( M_tackle_area.isEmpty() )
+    {
+        const Options & opt = Options::instance();
+        const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+
+        const double forward = opt.scale( SP.tackleDist() );
+        const double back = opt.scale( SP.tackleBackDist() );
+        const double width = opt.scale( SP.tackleWidth() );
+
+        M_tackle_area.push_back( QPointF( forward, width ) );
+        M_tackle_area.push_back( QPointF( forward, -width ) );
+        M_tackle_area.push_back( QPointF( -back, -width ) );
+        M_tackle_area.push_back( QPointF( -back, width ) );
+        M_tackle_area.push_back( QPointF( forward, width ) );
+    }
+
+    return M_tackle_area;
+}
@@ -0,0 +1,121 @@
+// -*-c++-*-
+
+/*!
+  \file player_area_cache.h
+  \brief player area geometry cache class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_PLAYER_AREA_CACHE_H
+#define SOCCERWINDOW2_QT_PLAYER_AREA_CACHE_H
+
+#include <QPainterPath>
+#include <QPolygonF>
+
+#include <map>
+
+namespace rcsc {
+class PlayerType;
+}
+
+/*!
+  \class PlayerAreaCache
+  \brief area templates of the player painter in the player's local screen frame.
+
+  Each template is built in pixels around the origin, with the body (or the
+  face) direction along the +x axis, so it is only translated and rotated
+  for each player. All templates are discarded when the field scale or the
+  related server parameters are changed. The templates that depend on the
+  player type are rebuilt when the type's parameters are changed.
+*/
+class PlayerAreaCache {
+public:
+
+    //! goalie's catchable area
+    struct CatchArea {
+        double reliable_length_;
+        double max_length_;
+        QPainterPath reliable_; //!< drawn with the goalie pen
+        QPainterPath unreliable_; //!< drawn with the goalie stretch pen. may be empty.
+    };
+
+    //! the reachable area by one dash (with omni-directional dash)
+    struct DashArea {
+        double max_accel_;
+        QPolygonF polygon_;
+    };
+
+private:
+
+    double M_field_scale;
+
+    // the server parameters used by the templates
+    double M_catch_area_width;
+    double M_min_catch_angle;
+    double M_max_catch_angle;
+    double M_tackle_dist;
+    double M_tackle_back_dist;
+    double M_tackle_width;
+    double M_visible_distance;
+    double M_max_dash_power;
+    double M_min_dash_power;
+
+    std::map< int, CatchArea > M_catch_areas; //!< key: player type id
+    std::map< int, DashArea > M_dash_areas; //!< key: player type id
+    std::map< double, QPainterPath > M_view_cones; //!< key: view width
+    QPolygonF M_tackle_area;
+
+    // not used
+    PlayerAreaCache( const PlayerAreaCache & ) = delete;
+    PlayerAreaCache & operator=( const PlayerAreaCache & ) = delete;
+
+public:
+
+    PlayerAreaCache();
+
+    /*!
+      \brief discard all templates if the field scale or the server parameters are changed.
+     */
+    void update();
+
+    const CatchArea & catchArea( const int type,
+                                 const rcsc::PlayerType & ptype );
+
+    const DashArea & dashArea( const int type,
+                               const rcsc::PlayerType & ptype );
+
+    //! the normal view cone. the face direction is +x axis.
+    const QPainterPath & viewCone( const double view_width );
+
+    //! the closed tackle area polyline
+    const QPolygonF & tackleArea();
+
+private:
+
+    void clear();
+};
+
+#endif
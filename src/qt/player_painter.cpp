@@ -46,6 +46,7 @@
 #include "draw_config.h"
 // model
 #include "options.h"
+#include "viewport.h"
 #include "main_data.h"
 
 #include <rcsc/common/player_type.h>
@@ -59,6 +60,92 @@
 #include <cstdio>
 #include <cmath>
 
+namespace {
+
+//! screen length around the player circle in which the labels may be visible
+const double LABEL_MARGIN = 128.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the transform from the player's local frame to the screen.
+*/
+inline
+QTransform
+local_transform( const double x,
+                 const double y,
+                 const double angle )
+{
+    QTransform t;
+    t.translate( x, y );
+    t.rotate( angle );
+    return t;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief quantized stamina level used for the shadow brush.
+*/
+inline
+int
+shadow_level( const rcsc::rcg::PlayerT & player )
+{
+    double stamina_rate = ( player.hasStamina()
+                            ? ( player.stamina()
+                                / rcsc::ServerParam::i().staminaMax() )
+                            : 1.0 );
+    //int level = 255 - (int)rint( 255 * rint( stamina_rate * 16.0 ) / 16.0 );
+    return 255 - (int)rint( 255 * rint( stamina_rate * 8.0 ) / 8.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief paths of several players grouped by the pen and the brush.
+*/
+class StyledPaths {
+private:
+    struct Item {
+        const QPen * pen_;
+        const QBrush * brush_;
+        QPainterPath path_;
+    };
+
+    std::vector< Item > M_items;
+
+public:
+
+    QPainterPath & path( const QPen & pen,
+                         const QBrush & brush )
+      {
+          for ( Item & i : M_items )
+          {
+              if ( i.pen_ == &pen
+                   && i.brush_ == &brush )
+              {
+                  return i.path_;
+              }
+          }
+
+          M_items.push_back( Item() );
+          M_items.back().pen_ = &pen;
+          M_items.back().brush_ = &brush;
+          // overlapped circles must not cancel each other's fill
+          M_items.back().path_.setFillRule( Qt::WindingFill );
+          return M_items.back().path_;
+      }
+
+    void draw( QPainter & painter ) const
+      {
+          for ( const Item & i : M_items )
+          {
+              painter.setPen( *i.pen_ );
+              painter.setBrush( *i.brush_ );
+              painter.drawPath( i.path_ );
+          }
+      }
+};
+
+}
+
 /*-------------------------------------------------------------------*/
 /*
 
@@ -144,6 +231,15 @@ PlayerPainter::draw( QPainter & painter )
         return;
     }
 
+    M_area_cache.update();
+
+    if ( ! opt.renderGradient() )
+    {
+        drawBatched( painter, *view );
+        return;
+    }
+
+    // the gradient brush depends on each player's position.
     const rcsc::rcg::BallT & ball = view->ball();
 
     if ( opt.playerReverseDraw() )
@@ -177,7 +273,6 @@ PlayerPainter::drawAll( QPainter & painter,
 {
     const Options & opt = Options::instance();
 
-    const bool selected = opt.isSelectedAgent( player.side(), player.unum() );
     const Param param( player,
                        ball,
                        M_main_data.viewHolder().playerType( player.type() ) );
@@ -189,6 +284,37 @@ PlayerPainter::drawAll( QPainter & painter,
     }
     drawEdge( painter, param );
 
+    if ( player.hasView()
+         && ! opt.showViewArea() )
+    {
+        drawViewDir( painter, param );
+    }
+
+    drawOverlays( painter, param );
+
+    drawText( painter, param );
+}
+
+/*-------------------------------------------------------------------*/
+/*
+
+ */
+void
+PlayerPainter::drawOverlays( QPainter & painter,
+                             const PlayerPainter::Param & param ) const
+{
+    const Options & opt = Options::instance();
+
+    const rcsc::rcg::PlayerT & player = param.player_;
+    const bool selected = opt.isSelectedAgent( player.side(), player.unum() );
+
+    // the reduced render quality keeps only the selected player's overlays.
+    if ( ! selected
+         && ! opt.renderOverlays() )
+    {
+        return;
+    }
+
     if ( selected
          && opt.playerFutureCycle() > 0
          && player.hasVelocity() )
@@ -207,10 +333,6 @@ PlayerPainter::drawAll( QPainter & painter,
         {
             drawViewArea( painter, param );
         }
-        else
-        {
-            drawViewDir( painter, param );
-        }
 
         if ( selected
              && player.focusDist() > 1.0e-5
@@ -246,8 +368,265 @@ PlayerPainter::drawAll( QPainter & painter,
     {
         drawAttentionto( painter, param );
     }
+}
 
-    drawText( painter, param );
+/*-------------------------------------------------------------------*/
+/*
+
+ */
+void
+PlayerPainter::drawBatched( QPainter & painter,
+                            const MonitorViewData & view ) const
+{
+    const Options & opt = Options::instance();
+    const DrawConfig & dconf = DrawConfig::instance();
+
+    const rcsc::rcg::BallT & ball = view.ball();
+
+    const Viewport viewport( opt.screenTransform(), opt.canvasWidth(), opt.canvasHeight() );
+
+    // the players outside the viewport are used only for the overlays.
+    std::vector< Param > params;
+    std::vector< Param > hidden;
+    params.reserve( view.players().size() );
+
+    const std::size_t size = view.players().size();
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const rcsc::rcg::PlayerT & p = view.players()[opt.playerReverseDraw() ? size - 1 - i : i];
+        const Param param( p, ball, M_main_data.viewHolder().playerType( p.type() ) );
+        const double r = param.draw_radius_ + LABEL_MARGIN;
+        if ( viewport.intersectsScreen( param.x_ - r, param.y_ - r,
+                                        param.x_ + r, param.y_ + r ) )
+        {
+            params.push_back( param );
+        }
+        else
+        {
+            hidden.push_back( param );
+        }
+    }
+
+    //
+    // bodies
+    //
+    {
+        StyledPaths bodies;
+        for ( const Param & param : params )
+        {
+            const QPen * pen = &dconf.playerPen();
+            const QBrush * brush = &dconf.shadowBrush();
+            selectBodyStyle( param, &pen, &brush );
+
+            bodies.path( *pen, *brush ).addEllipse( QRectF( param.x_ - param.draw_radius_,
+                                                            param.y_ - param.draw_radius_,
+                                                            param.draw_radius_ * 2,
+                                                            param.draw_radius_ * 2 ) );
+        }
+        bodies.draw( painter );
+    }
+
+    //
+    // shadows
+    //
+    if ( opt.showBodyShadow() )
+    {
+        StyledPaths shadows;
+        for ( const Param & param : params )
+        {
+            const double shadow_radius = param.draw_radius_ * 0.9;
+            const QRectF rect( param.x_ - shadow_radius,
+                               param.y_ - shadow_radius,
+                               shadow_radius * 2,
+                               shadow_radius * 2 );
+
+            QPainterPath & path = shadows.path( dconf.transparentPen(),
+                                                dconf.shadowBrush( shadow_level( param.player_ ) ) );
+            path.moveTo( param.x_, param.y_ );
+            path.arcTo( rect, - param.body_ + 90.0, 180.0 );
+            path.closeSubpath();
+        }
+        shadows.draw( painter );
+    }
+
+    //
+    // edges, body direction lines, stamina status and view direction lines
+    //
+    {
+        StyledPaths edges;
+        QPainterPath view_dir_path;
+        for ( const Param & param : params )
+        {
+            const double edge_radius = edgeRadius( param );
+            QPainterPath & path = edges.path( edgePen( param ), dconf.transparentBrush() );
+            path.addEllipse( QRectF( param.x_ - edge_radius,
+                                     param.y_ - edge_radius,
+                                     edge_radius * 2,
+                                     edge_radius * 2 ) );
+
+            if ( ! opt.showBodyShadow() )
+            {
+                const double r = opt.scale( param.player_type_.kickableArea() );
+                path.moveTo( param.x_, param.y_ );
+                path.lineTo( param.x_ + r * std::cos( param.body_ * rcsc::AngleDeg::DEG2RAD ),
+                             param.y_ + r * std::sin( param.body_ * rcsc::AngleDeg::DEG2RAD ) );
+            }
+
+            if ( param.player_.hasStamina()
+                 && ( ! param.have_full_effort_
+                      || ! param.player_.hasFullRecovery() ) )
+            {
+                const double radius = param.draw_radius_ + 2;
+                edges.path( ! param.have_full_effort_
+                            ? dconf.effortDecayedPen()
+                            : dconf.recoveryDecayedPen(),
+                            dconf.transparentBrush() ).addEllipse( QRectF( param.x_ - radius,
+                                                                           param.y_ - radius,
+                                                                           radius * 2,
+                                                                           radius * 2 ) );
+            }
+
+            if ( param.player_.hasView()
+                 && ! opt.showViewArea() )
+            {
+                const double r = opt.scale( opt.enlargeMode()
+                                            ? param.player_type_.kickableArea()
+                                            : param.player_type_.playerSize() );
+                view_dir_path.moveTo( param.x_, param.y_ );
+                view_dir_path.lineTo( param.x_ + r * std::cos( param.head_ * rcsc::AngleDeg::DEG2RAD ),
+                                      param.y_ + r * std::sin( param.head_ * rcsc::AngleDeg::DEG2RAD ) );
+            }
+        }
+        edges.draw( painter );
+
+        if ( ! view_dir_path.isEmpty() )
+        {
+            painter.setPen( Qt::black );
+            painter.setBrush( dconf.transparentBrush() );
+            painter.drawPath( view_dir_path );
+        }
+    }
+
+    //
+    // overlays
+    //
+    for ( const Param & param : params )
+    {
+        drawOverlays( painter, param );
+    }
+    for ( const Param & param : hidden )
+    {
+        drawOverlays( painter, param );
+    }
+
+    //
+    // texts
+    //
+    painter.setFont( dconf.playerFont() );
+
+    const QFontMetrics fm = painter.fontMetrics();
+
+    bool has_card = false;
+    bool has_illegal_label = false;
+    for ( const Param & param : params )
+    {
+        if ( opt.showCard()
+             && ( param.player_.hasRedCard()
+                  || param.player_.hasYellowCard() ) )
+        {
+            has_card = true;
+        }
+
+        if ( opt.showIllegalDefenseState()
+             && param.player_.isIllegalDefenseState() )
+        {
+            has_illegal_label = true;
+        }
+    }
+
+    if ( has_card )
+    {
+        // rare case. draw cards and labels player by player
+        for ( const Param & param : params )
+        {
+            drawText( painter, param );
+        }
+        return;
+    }
+
+    for ( int pass = 0; pass < ( has_illegal_label ? 2 : 1 ); ++pass )
+    {
+        painter.setPen( pass == 0
+                        ? dconf.playerNumberFontPen()
+                        : dconf.illegalDefensePen() );
+        for ( const Param & param : params )
+        {
+            const bool illegal = ( opt.showIllegalDefenseState()
+                                   && param.player_.isIllegalDefenseState() );
+            if ( illegal != ( pass == 1 ) )
+            {
+                continue;
+            }
+
+            if ( const QStaticText * text = label( param ) )
+            {
+                const double text_radius = std::min( 40.0, param.draw_radius_ );
+                painter.drawStaticText( QPointF( param.x_ + text_radius,
+                                                 param.y_ + 4 - fm.ascent() ),
+                                        *text );
+            }
+        }
+    }
+
+    if ( ! opt.showStamina()
+         && ! opt.showStaminaCapacity() )
+    {
+        return;
+    }
+
+    painter.setPen( dconf.playerStaminaFontPen() );
+    const Param * selected = static_cast< const Param * >( 0 );
+    for ( const Param & param : params )
+    {
+        if ( ! param.player_.hasStamina() )
+        {
+            continue;
+        }
+
+        if ( opt.isSelectedAgent( param.player_.side(),
+                                  param.player_.unum() ) )
+        {
+            selected = &param;
+            continue;
+        }
+
+        QString str;
+        if ( opt.showStamina() )
+        {
+            str += QString::number( static_cast< int >( rint( param.player_.stamina() ) ) );
+        }
+
+        if ( opt.showStaminaCapacity()
+             && param.player_.hasStaminaCapacity() )
+        {
+            if ( ! str.isEmpty() ) str += '/';
+            str += QString::number( static_cast< int >( rint( param.player_.staminaCapacity() ) ) );
+        }
+
+        if ( ! str.isEmpty() )
+        {
+            const double text_radius = std::min( 40.0, param.draw_radius_ );
+            painter.drawText( QPointF( param.x_ - text_radius,
+                                       param.y_ - text_radius - 3 ),
+                              str );
+        }
+    }
+
+    if ( selected )
+    {
+        // the selected player's stamina is drawn with the effort and the recovery
+        drawStaminaText( painter, *selected );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -255,13 +634,14 @@ PlayerPainter::drawAll( QPainter & painter,
 
  */
 void
-PlayerPainter::drawBody( QPainter & painter,
-                         const PlayerPainter::Param & param ) const
+PlayerPainter::selectBodyStyle( const PlayerPainter::Param & param,
+                                const QPen ** pen,
+                                const QBrush ** brush ) const
 {
     const DrawConfig & dconf = DrawConfig::instance();
 
     // decide base color
-    painter.setPen( dconf.playerPen() );
+    *pen = &dconf.playerPen();
 
     rcsc::SideID side = param.player_.side();
     if ( Options::instance().reverseSide() )
@@ -273,28 +653,28 @@ PlayerPainter::drawBody( QPainter & painter,
     case rcsc::LEFT:
         if ( param.player_.isGoalie() )
         {
-            painter.setBrush( dconf.leftGoalieBrush() );
+            *brush = &dconf.leftGoalieBrush();
         }
         else
         {
-            painter.setBrush( dconf.leftTeamBrush() );
+            *brush = &dconf.leftTeamBrush();
         }
         break;
     case rcsc::RIGHT:
         if ( param.player_.isGoalie() )
         {
-            painter.setBrush( dconf.rightGoalieBrush() );
+            *brush = &dconf.rightGoalieBrush();
         }
         else
         {
-            painter.setBrush( dconf.rightTeamBrush() );
+            *brush = &dconf.rightTeamBrush();
         }
         break;
     case rcsc::NEUTRAL:
-        painter.setBrush( dconf.shadowBrush() );
+        *brush = &dconf.shadowBrush();
         break;
     default:
-        painter.setBrush( dconf.shadowBrush() );
+        *brush = &dconf.shadowBrush();
         break;
     }
 
@@ -302,61 +682,79 @@ PlayerPainter::drawBody( QPainter & painter,
     // decide status color
     if ( ! param.player_.isAlive() )
     {
-        painter.setBrush( dconf.shadowBrush() );
+        *brush = &dconf.shadowBrush();
     }
 
     if ( param.player_.isIllegalDefenseState()
          && Options::instance().showIllegalDefenseState() )
     {
-        painter.setPen( dconf.illegalDefensePen() );
+        *pen = &dconf.illegalDefensePen();
     }
 
     if ( param.player_.isKickingFault() )
     {
-        painter.setPen( dconf.kickFaultPen() );
-        painter.setBrush( dconf.kickFaultBrush() );
+        *pen = &dconf.kickFaultPen();
+        *brush = &dconf.kickFaultBrush();
     }
     else if ( param.player_.isKicking() )
     {
-        painter.setPen( dconf.kickPen() );
+        *pen = &dconf.kickPen();
     }
 
     if ( param.player_.isCatchingFault() )
     {
-        painter.setBrush( dconf.catchFaultBrush() );
+        *brush = &dconf.catchFaultBrush();
     }
     else if ( param.player_.isCatching() )
     {
-        painter.setBrush( dconf.catchBrush() );
+        *brush = &dconf.catchBrush();
     }
 
     if ( param.player_.isTacklingFault() )
     {
-        painter.setPen( dconf.tacklePen() );
-        painter.setBrush( dconf.tackleFaultBrush() );
+        *pen = &dconf.tacklePen();
+        *brush = &dconf.tackleFaultBrush();
     }
     else if ( param.player_.isTackling() )
     {
-        painter.setPen( dconf.tacklePen() );
-        painter.setBrush( dconf.tackleBrush() );
+        *pen = &dconf.tacklePen();
+        *brush = &dconf.tackleBrush();
     }
 
     if ( param.player_.isFoulCharged() )
     {
-        painter.setBrush( dconf.foulChargedBrush() );
+        *brush = &dconf.foulChargedBrush();
     }
 
     if ( param.player_.isCollidedBall() )
     {
-        painter.setBrush( dconf.ballCollisionBrush() );
+        *brush = &dconf.ballCollisionBrush();
     }
 
     if ( param.player_.isCollidedPlayer() )
     {
-        painter.setBrush( dconf.playerCollisionBrush() );
+        *brush = &dconf.playerCollisionBrush();
     }
+}
 
-    if ( Options::instance().gradient() )
+/*-------------------------------------------------------------------*/
+/*
+
+ */
+void
+PlayerPainter::drawBody( QPainter & painter,
+                         const PlayerPainter::Param & param ) const
+{
+    const DrawConfig & dconf = DrawConfig::instance();
+
+    const QPen * pen = &dconf.playerPen();
+    const QBrush * brush = &dconf.shadowBrush();
+    selectBodyStyle( param, &pen, &brush );
+
+    painter.setPen( *pen );
+    painter.setBrush( *brush );
+
+    if ( Options::instance().renderGradient() )
     {
         QRadialGradient gradient( param.x_,
                                   param.y_,
@@ -417,16 +815,10 @@ PlayerPainter::drawShadow( QPainter & painter,
     painter.setBrush( dconf.shadowBrush( col ) );
 #else
     painter.setPen( dconf.transparentPen() );
-    double stamina_rate = ( param.player_.hasStamina()
-                            ? ( param.player_.stamina()
-                                / rcsc::ServerParam::i().staminaMax() )
-                            : 1.0 );
-    //int level = 255 - (int)rint( 255 * rint( stamina_rate * 16.0 ) / 16.0 );
-    int level = 255 - (int)rint( 255 * rint( stamina_rate * 8.0 ) / 8.0 );
-    painter.setBrush( dconf.shadowBrush( level ) );
+    painter.setBrush( dconf.shadowBrush( shadow_level( param.player_ ) ) );
 #endif
 
-    if ( Options::instance().gradient() )
+    if ( Options::instance().renderGradient() )
     {
         QRadialGradient gradient( param.x_,
                                   param.y_,
@@ -468,48 +860,57 @@ PlayerPainter::drawShadow( QPainter & painter,
 /*!
 
  */
-void
-PlayerPainter::drawEdge( QPainter & painter,
-                         const PlayerPainter::Param & param ) const
+const QPen &
+PlayerPainter::edgePen( const PlayerPainter::Param & param ) const
 {
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    double edge_radius = 1;
     if ( opt.enlargeMode() )
     {
-        if ( opt.showBodyShadow() )
-        {
-            painter.setPen( dconf.realBodyPen() );
-        }
-        else
-        {
-            painter.setPen( dconf.playerPen() );
-        }
-
-        edge_radius = param.body_radius_;
+        return ( opt.showBodyShadow()
+                 ? dconf.realBodyPen()
+                 : dconf.playerPen() );
     }
-    else
+
+    // kickable area edge
+    rcsc::SideID side = param.player_.side();
+    if ( opt.reverseSide() )
     {
-        // draw kickable area edge
-        rcsc::SideID side = param.player_.side();
-        if ( opt.reverseSide() )
-        {
-            side = static_cast< rcsc::SideID >( -1 * side );
-        }
+        side = static_cast< rcsc::SideID >( -1 * side );
+    }
 
-        if ( side == rcsc::LEFT )
-        {
-            painter.setPen( dconf.leftTeamPen() );
-        }
-        else
-        {
-            painter.setPen( dconf.rightTeamPen() );
-        }
+    return ( side == rcsc::LEFT
+             ? dconf.leftTeamPen()
+             : dconf.rightTeamPen() );
+}
 
-        edge_radius = param.kick_radius_;
-    }
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+PlayerPainter::edgeRadius( const PlayerPainter::Param & param ) const
+{
+    return ( Options::instance().enlargeMode()
+             ? param.body_radius_
+             : param.kick_radius_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerPainter::drawEdge( QPainter & painter,
+                         const PlayerPainter::Param & param ) const
+{
+    const Options & opt = Options::instance();
+    const DrawConfig & dconf = DrawConfig::instance();
 
+    const double edge_radius = edgeRadius( param );
+
+    painter.setPen( edgePen( param ) );
     painter.setBrush( dconf.transparentBrush() );
     painter.drawEllipse( QRectF( param.x_ - edge_radius,
                                  param.y_ - edge_radius,
@@ -566,7 +967,7 @@ PlayerPainter::drawFuture( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -642,7 +1043,7 @@ PlayerPainter::drawFuture( QPainter & painter,
     painter.setPen( dconf.debugTargetPen() );
     painter.drawLine( QLineF( first_point, last_point ) );
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -665,7 +1066,7 @@ PlayerPainter::drawMovableArea( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -702,25 +1103,11 @@ PlayerPainter::drawMovableArea( QPainter & painter,
     // 1 dash (with omnidir dash )
     {
         const rcsc::Vector2D inertia_pos = first_pos + first_vel;
-        int num = 0;
-        for ( double dir = -180.0; dir < 180.0; dir += 45.0, ++num )
-        {
-            double front_max_accel = rcsc::ServerParam::i().maxDashPower()
-                * param.player_type_.dashPowerRate()
-                * param.player_type_.effortMax()
-                * rcsc::ServerParam::i().dashDirRate( dir );
-            double back_max_accel = rcsc::ServerParam::i().minDashPower()
-                * param.player_type_.dashPowerRate()
-                * param.player_type_.effortMax()
-                * rcsc::ServerParam::i().dashDirRate( rcsc::AngleDeg::normalize_angle( dir + 180.0 ) );
-            rcsc::Vector2D pos = inertia_pos
-                + rcsc::Vector2D::from_polar( std::max( front_max_accel, std::fabs( back_max_accel ) ),
-                                              param.body_ + dir );
-            points[num].setX( opt.screenX( pos.x ) );
-            points[num].setY( opt.screenY( pos.y ) );
-        }
-
-        painter.drawPolygon( points, num );
+        const PlayerAreaCache::DashArea & area = M_area_cache.dashArea( param.player_.type(),
+                                                                        param.player_type_ );
+        painter.drawPolygon( local_transform( opt.screenX( inertia_pos.x ),
+                                              opt.screenY( inertia_pos.y ),
+                                              param.body_ ).map( area.polygon_ ) );
     }
 
     // 2 or more dashes (no omnidir dash)
@@ -775,7 +1162,7 @@ PlayerPainter::drawMovableArea( QPainter & painter,
 
     //
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -878,17 +1265,8 @@ PlayerPainter::drawViewArea( QPainter & painter,
         painter.setPen( dconf.viewConePen() );
         painter.setBrush( dconf.transparentBrush() );
 
-        QPainterPath view_cone_path;
-        view_cone_path.moveTo( param.x_, param.y_ );
-        view_cone_path.arcTo( param.x_ - visible_radius,
-                              param.y_ - visible_radius,
-                              visible_radius * 2,
-                              visible_radius * 2,
-                              view_start_angle,
-                              view_width );
-        view_cone_path.closeSubpath();
-
-        painter.drawPath( view_cone_path );
+        painter.drawPath( local_transform( param.x_, param.y_, param.head_ )
+                          .map( M_area_cache.viewCone( view_width ) ) );
     }
 }
 
@@ -951,7 +1329,6 @@ PlayerPainter::drawCatchableArea( QPainter & painter,
 {
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
-    const rcsc::ServerParam & SP = rcsc::ServerParam::instance();
 
     rcsc::SideID side = param.player_.side();
     if ( opt.reverseSide() )
@@ -959,111 +1336,25 @@ PlayerPainter::drawCatchableArea( QPainter & painter,
         side = static_cast< rcsc::SideID >( -1 * side );
     }
 
-    const double reliable_catch_dist = std::sqrt( std::pow( param.player_type_.reliableCatchLength(), 2 )
-                                                  + std::pow( SP.catchAreaWidth() * 0.5, 2 ) );
-    const double reliable_diagonal_angle = rcsc::AngleDeg::atan2_deg( SP.catchAreaWidth() * 0.5,
-                                                                      param.player_type_.reliableCatchLength() );
+    const PlayerAreaCache::CatchArea & area = M_area_cache.catchArea( param.player_.type(),
+                                                                      param.player_type_ );
+    const QTransform transform = local_transform( param.x_, param.y_, param.body_ );
 
-    const double unreliable_catch_dist = std::sqrt( std::pow( param.player_type_.maxCatchLength(), 2 )
-                                                  + std::pow( SP.catchAreaWidth() * 0.5, 2 ) );
-    const double unreliable_diagonal_angle = rcsc::AngleDeg::atan2_deg( SP.catchAreaWidth() * 0.5,
-                                                                        param.player_type_.maxCatchLength() );
-
-    const double draw_reliable_r = opt.scale( reliable_catch_dist );
-    const double draw_unreliable_r = opt.scale( unreliable_catch_dist );
+    painter.setBrush( dconf.transparentBrush() );
 
-    if ( SP.minCatchAngle() - reliable_diagonal_angle > -180.0 )
+    if ( ! area.unreliable_.isEmpty() )
     {
-        const rcsc::Line2D body_line( rcsc::Vector2D( param.player_.x(), param.player_.y() ),
-                                      param.player_.body() );
-        {
-            // draw unreliable ark
-            const int unreliable_start_angle = qRound( std::rint( -param.body_ + SP.minCatchAngle() - unreliable_diagonal_angle ) * 16 );
-            const int unreliable_span_angle = qRound( std::rint( SP.maxCatchAngle() - SP.minCatchAngle() + unreliable_diagonal_angle*2 ) * 16 );
-            const double unreliable_start_x = param.player_.x() + unreliable_catch_dist * rcsc::AngleDeg::cos_deg( param.body_ + SP.maxCatchAngle() + unreliable_diagonal_angle );
-            const double unreliable_start_y = param.player_.y() + unreliable_catch_dist * rcsc::AngleDeg::sin_deg( param.body_ + SP.maxCatchAngle() + unreliable_diagonal_angle );
-            const rcsc::Line2D start_line( rcsc::Vector2D( unreliable_start_x, unreliable_start_y ),
-                                           param.player_.body() + SP.minCatchAngle() );
-            const rcsc::Vector2D mid = body_line.intersection( start_line );
-            const double unreliable_end_x = param.player_.x() + unreliable_catch_dist * rcsc::AngleDeg::cos_deg( param.body_ + SP.minCatchAngle() - unreliable_diagonal_angle );
-            const double unreliable_end_y = param.player_.y() + unreliable_catch_dist * rcsc::AngleDeg::sin_deg( param.body_ + SP.minCatchAngle() - unreliable_diagonal_angle );
-            painter.setPen( ( side == rcsc::LEFT )
-                            ? dconf.leftGoalieStretchPen()
-                            : dconf.rightGoalieStretchPen() );
-            painter.drawArc( QRectF( param.x_ - draw_unreliable_r,
-                                     param.y_ - draw_unreliable_r,
-                                     draw_unreliable_r * 2,
-                                     draw_unreliable_r * 2 ),
-                             unreliable_start_angle, unreliable_span_angle );
-            const double draw_mid_x = ( mid.isValid()
-                                        ? opt.screenX( mid.x )
-                                        : opt.screenX( ( unreliable_start_x + unreliable_end_x ) * 0.5 ) );
-            const double draw_mid_y = ( mid.isValid()
-                                        ? opt.screenY( mid.y )
-                                        : opt.screenY( ( unreliable_start_y + unreliable_end_y ) * 0.5 ) );
-            painter.drawLine( QLineF( opt.screenX( unreliable_start_x ), opt.screenY( unreliable_start_y ),
-                                      draw_mid_x, draw_mid_y ) );
-            painter.drawLine( QLineF( draw_mid_x, draw_mid_y,
-                                      opt.screenX( unreliable_end_x ), opt.screenY( unreliable_end_y ) ) );
-        }
-        {
-            // draw reliable arc
-            const int reliable_start_angle = qRound( std::rint( -param.body_ + SP.minCatchAngle() - reliable_diagonal_angle ) * 16 );
-            const int reliable_span_angle = qRound( std::rint( SP.maxCatchAngle() - SP.minCatchAngle() + reliable_diagonal_angle*2 ) * 16 );
-            const double reliable_start_x = param.player_.x() + reliable_catch_dist * rcsc::AngleDeg::cos_deg( param.body_ + SP.maxCatchAngle() + reliable_diagonal_angle );
-            const double reliable_start_y = param.player_.y() + reliable_catch_dist * rcsc::AngleDeg::sin_deg( param.body_ + SP.maxCatchAngle() + reliable_diagonal_angle );
-            const rcsc::Line2D start_line( rcsc::Vector2D( reliable_start_x, reliable_start_y ),
-                                           param.player_.body() + SP.minCatchAngle() );
-            const rcsc::Vector2D mid = body_line.intersection( start_line );
-            const double reliable_end_x = param.player_.x() + reliable_catch_dist * rcsc::AngleDeg::cos_deg( param.body_ + SP.minCatchAngle() - reliable_diagonal_angle );
-            const double reliable_end_y = param.player_.y() + reliable_catch_dist * rcsc::AngleDeg::sin_deg( param.body_ + SP.minCatchAngle() - reliable_diagonal_angle );
-            painter.setPen( ( side == rcsc::LEFT )
-                            ? dconf.leftGoaliePen()
-                            : dconf.rightGoaliePen() );
-            painter.drawArc( QRectF( param.x_ - draw_reliable_r,
-                                     param.y_ - draw_reliable_r,
-                                     draw_reliable_r * 2,
-                                     draw_reliable_r * 2 ),
-                             reliable_start_angle, reliable_span_angle );
-            const double draw_mid_x = ( mid.isValid()
-                                        ? opt.screenX( mid.x )
-                                        : opt.screenX( ( reliable_start_x + reliable_end_x ) * 0.5 ) );
-            const double draw_mid_y = ( mid.isValid()
-                                        ? opt.screenY( mid.y )
-                                        : opt.screenY( ( reliable_start_y + reliable_end_y ) * 0.5 ) );
-            painter.drawLine( QLineF( opt.screenX( reliable_start_x ), opt.screenY( reliable_start_y ),
-                                      draw_mid_x, draw_mid_y ) );
-            painter.drawLine( QLineF( draw_mid_x, draw_mid_y,
-                                      opt.screenX( reliable_end_x ), opt.screenY( reliable_end_y ) ) );
-
-            // painter.drawLine( QLineF( opt.screenX( body_line.getX( -30.0 ) ), opt.screenY( -30.0 ),
-            //                           opt.screenX( body_line.getX( +30.0 ) ), opt.screenY( +30.0 ) ) );
-        }
-    }
-    else
-    {
-        painter.setBrush( dconf.transparentBrush() );
-
-        if ( draw_unreliable_r > draw_reliable_r )
-        {
-            painter.setPen( ( side == rcsc::LEFT )
-                            ? dconf.leftGoalieStretchPen()
-                            : dconf.rightGoalieStretchPen() );
-            painter.drawEllipse( QRectF( param.x_ - draw_unreliable_r,
-                                         param.y_ - draw_unreliable_r,
-                                         draw_unreliable_r * 2,
-                                         draw_unreliable_r * 2 ) );
-        }
-
         painter.setPen( ( side == rcsc::LEFT )
-                        ? dconf.leftGoaliePen()
-                        : dconf.rightGoaliePen() );
-        painter.drawEllipse( QRectF( param.x_ - draw_reliable_r,
-                                     param.y_ - draw_reliable_r,
-                                     draw_reliable_r * 2,
-                                     draw_reliable_r * 2 ) );
+                        ? dconf.leftGoalieStretchPen()
+                        : dconf.rightGoalieStretchPen() );
+        painter.drawPath( transform.map( area.unreliable_ ) );
     }
 
+    painter.setPen( ( side == rcsc::LEFT )
+                    ? dconf.leftGoaliePen()
+                    : dconf.rightGoaliePen() );
+    painter.drawPath( transform.map( area.reliable_ ) );
+
     //
     // catch probability
     //
@@ -1146,33 +1437,11 @@ PlayerPainter::drawTackleArea( QPainter & painter,
     if ( tackle_prob < 1.0
          || foul_prob < 1.0 )
     {
-        rcsc::AngleDeg body_angle = param.body_;
-        rcsc::AngleDeg body_angle_side = body_angle + 90.0;
-        double body_x = body_angle.cos();
-        double body_y = body_angle.sin();
-        double forward_x = SP.tackleDist() * body_x;
-        double forward_y = SP.tackleDist() * body_y;
-        double back_x = SP.tackleBackDist() * -body_x;
-        double back_y = SP.tackleBackDist() * -body_y;
-        double right_x = SP.tackleWidth() * body_angle_side.cos();
-        double right_y = SP.tackleWidth() * body_angle_side.sin();
-
-        QPointF pts[5];
-        pts[0].setX( opt.absScreenX( ppos.x + forward_x + right_x ) );
-        pts[0].setY( opt.absScreenY( ppos.y + forward_y + right_y ) );
-        pts[1].setX( opt.absScreenX( ppos.x + forward_x - right_x ) );
-        pts[1].setY( opt.absScreenY( ppos.y + forward_y - right_y ) );
-        pts[2].setX( opt.absScreenX( ppos.x + back_x - right_x ) );
-        pts[2].setY( opt.absScreenY( ppos.y + back_y - right_y ) );
-        pts[3].setX( opt.absScreenX( ppos.x + back_x + right_x ) );
-        pts[3].setY( opt.absScreenY( ppos.y + back_y + right_y ) );
-        pts[4] = pts[0];
-
         painter.setPen( dconf.tackleAreaPen() );
         painter.setBrush( dconf.transparentBrush() );
 
-        //painter.drawConvexPolygon( pts, 4 );
-        painter.drawPolyline( pts, 5 );
+        painter.drawPolyline( local_transform( param.x_, param.y_, param.body_ )
+                              .map( M_area_cache.tackleArea() ) );
 
         double text_radius = std::min( 40.0, param.draw_radius_ );
 
@@ -1504,7 +1773,7 @@ PlayerPainter::drawText( QPainter & painter,
 
         card_offset = x_size + 2;
 
-        if ( opt.antiAliasing() )
+        if ( opt.renderAntiAliasing() )
         {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
             painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -1521,7 +1790,7 @@ PlayerPainter::drawText( QPainter & painter,
         painter.drawRect( QRectF( param.x_ + text_radius,
                                   param.y_ + 4 - y_size,
                                   x_size, y_size ) );
-        if ( opt.antiAliasing() )
+        if ( opt.renderAntiAliasing() )
         {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
             painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -1561,6 +1830,22 @@ PlayerPainter::drawText( QPainter & painter,
                           QString( "t%1" ).arg( param.player_.type() ) );
     }
 
+    drawStaminaText( painter, param );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerPainter::drawStaminaText( QPainter & painter,
+                                const PlayerPainter::Param & param ) const
+{
+    const Options & opt = Options::instance();
+    const DrawConfig & dconf = DrawConfig::instance();
+
+    const double text_radius = std::min( 40.0, param.draw_radius_ );
+
     if ( param.player_.hasStamina() )
     {
         QString str;
@@ -1598,3 +1883,50 @@ PlayerPainter::drawText( QPainter & painter,
         }
     }
 }
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const QStaticText *
+PlayerPainter::label( const PlayerPainter::Param & param ) const
+{
+    const Options & opt = Options::instance();
+
+    const int mode = ( opt.showPlayerNumber()
+                       ? ( opt.showPlayerType() ? 1 : 2 )
+                       : ( opt.showPlayerType() ? 3 : 0 ) );
+    if ( mode == 0 )
+    {
+        return static_cast< const QStaticText * >( 0 );
+    }
+
+    const QFont & font = DrawConfig::instance().playerFont();
+    if ( M_label_font != font )
+    {
+        M_label_font = font;
+        M_labels.clear();
+    }
+
+    const int key = ( mode << 16 ) | ( ( param.player_.unum() & 0xff ) << 8 ) | ( param.player_.type() & 0xff );
+
+    std::map< int, QStaticText >::iterator it = M_labels.find( key );
+    if ( it != M_labels.end() )
+    {
+        return &it->second;
+    }
+
+    const QString str = ( mode == 1
+                          ? QString( "%1,t%2" ).arg( param.player_.unum() ).arg( param.player_.type() )
+                          : mode == 2
+                          ? QString::number( param.player_.unum() )
+                          : QString( "t%1" ).arg( param.player_.type() ) );
+
+    QStaticText & text = M_labels[key];
+    text.setText( str );
+    text.setTextFormat( Qt::PlainText );
+    text.setPerformanceHint( QStaticText::AggressiveCaching );
+    text.prepare( QTransform(), font );
+
+    return &text;
+}
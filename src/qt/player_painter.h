@@ -33,15 +33,25 @@
 #define SOCCERWINDOW2_QT_PLAYER_PAINTER_H
 
 #include "painter_interface.h"
+#include "player_area_cache.h"
+
+#include <QFont>
+#include <QStaticText>
 
 #include <rcsc/rcg/types.h>
 #include <rcsc/types.h>
 
+#include <map>
+
 namespace rcsc {
 class PlayerType;
 }
 
+class QBrush;
 class QPainter;
+class QPen;
+
+class MonitorViewData;
 
 class MainData;
 
@@ -83,6 +93,15 @@ private:
 
     const MainData & M_main_data;
 
+    //! area templates shared by all players
+    mutable PlayerAreaCache M_area_cache;
+
+    //! the font used to lay out the cached labels
+    mutable QFont M_label_font;
+
+    //! number and type labels. key: (label mode, unum, type)
+    mutable std::map< int, QStaticText > M_labels;
+
     // not used
     PlayerPainter();
     PlayerPainter( const PlayerPainter & );
@@ -100,6 +119,44 @@ private:
                   const rcsc::rcg::PlayerT & player,
                   const rcsc::rcg::BallT & ball ) const;
 
+    /*!
+      \brief draw all players layer by layer.
+      The bodies, the shadows and the edges of all players are merged into
+      one path for each pen and brush, and the labels are drawn from the
+      cached static texts.
+      \param painter reference to painter instance
+      \param view current view data
+     */
+    void drawBatched( QPainter & painter,
+                      const MonitorViewData & view ) const;
+
+    /*!
+      \brief draw the overlays that are not batched
+      \param painter reference to painter instance
+      \param param parameter set that defeines this players draw settings
+     */
+    void drawOverlays( QPainter & painter,
+                       const PlayerPainter::Param & param ) const;
+
+    /*!
+      \brief decide the pen and the brush of the body circle
+      \param param parameter set that defeines this players draw settings
+      \param pen result pen
+      \param brush result brush
+     */
+    void selectBodyStyle( const PlayerPainter::Param & param,
+                          const QPen ** pen,
+                          const QBrush ** brush ) const;
+
+    //! pen of the body edge circle
+    const QPen & edgePen( const PlayerPainter::Param & param ) const;
+
+    //! radius of the body edge circle
+    double edgeRadius( const PlayerPainter::Param & param ) const;
+
+    //! get the cached number and type label. null if no label is shown.
+    const QStaticText * label( const PlayerPainter::Param & param ) const;
+
     /*!
       \brief draw body circle
       \param painter reference to painter instance
@@ -167,6 +224,14 @@ private:
     void drawText( QPainter & painter,
                    const PlayerPainter::Param & param ) const;
 
+    /*!
+      \brief draw stamina text
+      \param painter reference to painter instance
+      \param param parameter set that defeines this players draw settings
+    */
+    void drawStaminaText( QPainter & painter,
+                          const PlayerPainter::Param & param ) const;
+
 };
 
 #endif
@@ -217,6 +217,8 @@ PlayerPainterRCSS::drawAll( QPainter & painter,
     const Options & opt = Options::instance();
 
     const bool selected = opt.isSelectedAgent( player.side(), player.unum() );
+    // the reduced render quality keeps only the selected player's overlays.
+    const bool overlays = ( selected || opt.renderOverlays() );
     const Param param( player,
                        ball,
                        M_main_data.viewHolder().playerType( player.type() ) );
@@ -234,7 +236,8 @@ PlayerPainterRCSS::drawAll( QPainter & painter,
 
     if ( player.hasView() )
     {
-        if ( opt.showViewArea() )
+        if ( overlays
+             && opt.showViewArea() )
         {
             drawViewArea( painter, param );
         }
@@ -247,13 +250,15 @@ PlayerPainterRCSS::drawAll( QPainter & painter,
         }
     }
 
-    if ( player.isGoalie()
+    if ( overlays
+         && player.isGoalie()
          && opt.showCatchableArea() )
     {
         drawCatchableArea( painter, param );
     }
 
-    if ( opt.showTackleArea() )
+    if ( overlays
+         && opt.showTackleArea() )
     {
         drawTackleArea( painter, param );
     }
@@ -442,7 +447,7 @@ PlayerPainterRCSS::drawFuture( QPainter & painter,
     const Options & opt = Options::instance();
     const DrawConfig & dconf = DrawConfig::instance();
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -515,7 +520,7 @@ PlayerPainterRCSS::drawFuture( QPainter & painter,
     painter.setPen( dconf.debugTargetPen() );
     painter.drawLine( QLineF( first_point, last_point ) );
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -949,7 +954,7 @@ PlayerPainterRCSS::drawText( QPainter & painter,
 
         card_offset = x_size + 2;
 
-        if ( opt.antiAliasing() )
+        if ( opt.renderAntiAliasing() )
         {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
             painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -967,7 +972,7 @@ PlayerPainterRCSS::drawText( QPainter & painter,
                                   param.y_ - y_size,
                                   x_size,
                                   y_size ) );
-        if ( opt.antiAliasing() )
+        if ( opt.renderAntiAliasing() )
         {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
             painter.setRenderHints( QPainter::HighQualityAntialiasing |
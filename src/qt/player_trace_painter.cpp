@@ -46,9 +46,85 @@
 #include "draw_config.h"
 // model
 #include "options.h"
+#include "viewport.h"
 #include "main_data.h"
 #include "monitor_view_data.h"
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TraceCache::Style
+player_trace_style( const rcsc::PlayMode pmode )
+{
+    switch ( pmode ) {
+    case rcsc::PM_BeforeKickOff:
+    case rcsc::PM_TimeOver:
+    case rcsc::PM_AfterGoal_Left:
+    case rcsc::PM_AfterGoal_Right:
+        return TraceCache::SKIP;
+    case rcsc::PM_PlayOn:
+        return TraceCache::PLAYON;
+    default:
+        break;
+    }
+
+    return TraceCache::SETPLAY;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+QPixmap
+create_marker( const QPen & pen )
+{
+    QPixmap pixmap( 6, 6 );
+    pixmap.fill( Qt::transparent );
+
+    QPainter painter( &pixmap );
+    painter.setPen( pen );
+    painter.setBrush( Qt::gray );
+    painter.drawEllipse( QRectF( 1.0, 1.0, 4.0, 4.0 ) );
+    painter.end();
+
+    return pixmap;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+PlayerTracePainter::PlayerTracePainter( const MainData & main_data )
+    : M_main_data( main_data ),
+      M_trace_cache( &player_trace_style )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerTracePainter::updateMarkers( const QPen & playon_pen,
+                                   const QPen & setplay_pen )
+{
+    if ( ! M_setplay_marker.isNull()
+         && M_marker_color == playon_pen.color() )
+    {
+        return;
+    }
+
+    M_marker_color = playon_pen.color();
+    M_playon_marker = create_marker( playon_pen );
+    M_setplay_marker = create_marker( setplay_pen );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -104,7 +180,7 @@ PlayerTracePainter::draw( QPainter & painter )
         return;
     }
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -130,73 +206,24 @@ PlayerTracePainter::draw( QPainter & painter )
     QPen black_dot_pen( Qt::black );
     black_dot_pen.setStyle( Qt::DotLine );
 
-    const bool line_trace = opt.lineTrace();
+    M_trace_cache.update( vc, static_cast< int >( idx ) );
 
-    if ( line_trace )
-    {
-        painter.setBrush( DrawConfig::instance().transparentBrush() );
-    }
-    else
-    {
-        painter.setBrush( Qt::gray );
-    }
+    const Viewport viewport( opt.screenTransform(), opt.canvasWidth(), opt.canvasHeight() );
 
-    //QPainterPath playon_path;
-    //QPainterPath setplay_path;
+    painter.setBrush( DrawConfig::instance().transparentBrush() );
 
-    std::size_t i = first;
-    QPointF prev( opt.screenX( vc[i]->players()[idx].x() ),
-                  opt.screenY( vc[i]->players()[idx].y() ) );
-    ++i;
-    for ( ; i <= last; ++i )
-    {
-        //QPainterPath * path;
-        switch ( vc[i]->playmode() ) {
-        case rcsc::PM_BeforeKickOff:
-        case rcsc::PM_TimeOver:
-        case rcsc::PM_AfterGoal_Left:
-        case rcsc::PM_AfterGoal_Right:
-            continue;
-        case rcsc::PM_PlayOn:
-            painter.setPen( my_pen );
-            //path = &playon_path;
-            break;
-        default:
-            painter.setPen( black_dot_pen );
-            //path = &setplay_path;
-            break;
-        }
+    M_trace_cache.drawLines( painter, viewport, first, last, my_pen, black_dot_pen );
 
-        const rcsc::rcg::PlayerT & p = vc[i]->players()[idx];
-        QPointF next( opt.screenX( p.x() ),
-                      opt.screenY( p.y() ) );
-        if ( line_trace )
-        {
-            painter.drawLine( QLineF( prev, next ) );
-            //path->moveTo( prev_x, prev_y );
-            //path->lineTo( ix, iy );
-        }
-        else
-        {
-            painter.drawLine( QLineF(  prev, next ) );
-            painter.drawEllipse( QRectF( next.x() - 2.0,
-                                         next.y() - 2.0,
-                                         4.0,
-                                         4.0 ) );
-            //path->moveTo( prev_x, prev_y );
-            //path->lineTo( ix, iy );
-            //path->addEllipse( ix, iy, 4, 4 );
-        }
-        prev = next;
+    if ( ! opt.lineTrace()
+         && opt.renderOverlays() )
+    {
+        updateMarkers( my_pen, black_dot_pen );
+        M_trace_cache.drawMarkers( painter, viewport, first, last,
+                                   M_playon_marker,
+                                   M_setplay_marker );
     }
 
-//     painter.setPen( my_pen );
-//     painter.drawPath( playon_path );
-
-//     painter.setPen( black_dot_pen );
-//     painter.drawPath( setplay_path );
-
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -33,6 +33,10 @@
 #define SOCCERWINDOW2_QT_PLAYER_TRACE_PAINTER_H
 
 #include "painter_interface.h"
+#include "trace_cache.h"
+
+#include <QColor>
+#include <QPixmap>
 
 class MainData;
 
@@ -42,18 +46,28 @@ private:
     //! const reference to the main data
     const MainData & M_main_data;
 
+    TraceCache M_trace_cache;
+
+    //! the pen color used to create the play_on marker
+    QColor M_marker_color;
+    QPixmap M_playon_marker;
+    QPixmap M_setplay_marker;
+
     // not used
     PlayerTracePainter();
 public:
     //! constructor with data referance
     explicit
-    PlayerTracePainter( const MainData & main_data )
-        : M_main_data( main_data )
-      { }
+    PlayerTracePainter( const MainData & main_data );
 
     //! paint ball object to the canvas
     void draw( QPainter & painter );
 
+private:
+
+    void updateMarkers( const QPen & playon_pen,
+                        const QPen & setplay_pen );
+
 };
 
 #endif
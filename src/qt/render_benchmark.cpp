@@ -0,0 +1,506 @@
+// -*-c++-*-
+
+/*!
+  \file render_benchmark.cpp
+  \brief painter benchmark class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+#include <QtGlobal>
+#include <QImage>
+#include <QPainter>
+
+#include "render_benchmark.h"
+
+#include "batch_renderer.h"
+#include "field_canvas.h"
+#include "field_painter.h"
+#include "team_graphic_painter.h"
+#include "painter_interface.h"
+
+#include "options.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+
+namespace {
+
+/*!
+  \brief drawing option that is switched by the benchmark presets.
+*/
+struct OptionSwitch {
+    bool ( Options::*get_ )() const;
+    void ( Options::*toggle_ )();
+};
+
+const OptionSwitch OPTION_SWITCHES[] = {
+    { &Options::antiAliasing, &Options::toggleAntiAliasing },
+    { &Options::gradient, &Options::toggleGradient },
+    { &Options::showFlags, &Options::toggleShowFlags },
+    { &Options::showGridCoord, &Options::toggleShowGridCoord },
+    { &Options::showPlayerNumber, &Options::toggleShowPlayerNumber },
+    { &Options::showPlayerType, &Options::toggleShowPlayerType },
+    { &Options::showViewArea, &Options::toggleShowViewArea },
+    { &Options::showFocusPoint, &Options::toggleShowFocusPoint },
+    { &Options::showPointto, &Options::toggleShowPointto },
+    { &Options::showAttentionto, &Options::toggleShowAttentionto },
+    { &Options::showStamina, &Options::toggleShowStamina },
+    { &Options::showStaminaCapacity, &Options::toggleShowStaminaCapacity },
+    { &Options::showCard, &Options::toggleShowCard },
+    { &Options::showBodyShadow, &Options::toggleShowBodyShadow },
+    { &Options::showCatchableArea, &Options::toggleShowCatchableArea },
+    { &Options::showTackleArea, &Options::toggleShowTackleArea },
+    { &Options::showKickAccelArea, &Options::toggleShowKickAccelArea },
+    { &Options::showOffsideLine, &Options::toggleShowOffsideLine },
+    { &Options::showDrawData, &Options::toggleShowDrawData },
+    { &Options::showVoronoiDiagram, &Options::toggleShowVoronoiDiagram },
+    { &Options::showDelaunayTriangulation, &Options::toggleShowDelaunayTriangulation },
+    { &Options::ballAutoTrace, &Options::toggleBallAutoTrace },
+    { &Options::playerAutoTrace, &Options::togglePlayerAutoTrace },
+    { &Options::showDebugView, &Options::toggleShowDebugView },
+    { &Options::showDebugLogObjects, &Options::toggleShowDebugLogObjects },
+};
+
+/*-------------------------------------------------------------------*/
+void
+set_switch( Options & opt,
+            const OptionSwitch & sw,
+            const bool value )
+{
+    if ( ( opt.*sw.get_ )() != value )
+    {
+        ( opt.*sw.toggle_ )();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+std::vector< QSize >
+parse_sizes( const std::string & text )
+{
+    std::vector< QSize > sizes;
+
+    std::istringstream is( text );
+    std::string token;
+    while ( std::getline( is, token, ',' ) )
+    {
+        int w = 0;
+        int h = 0;
+        if ( std::sscanf( token.c_str(), " %d x %d", &w, &h ) != 2
+             || w <= 0 || h <= 0 )
+        {
+            std::cerr << "(RenderBenchmark) Illegal canvas size [" << token << "]" << std::endl;
+            continue;
+        }
+        sizes.push_back( QSize( w, h ) );
+    }
+
+    return sizes;
+}
+
+/*-------------------------------------------------------------------*/
+std::vector< std::string >
+split( const std::string & text )
+{
+    std::vector< std::string > tokens;
+
+    std::istringstream is( text );
+    std::string token;
+    while ( std::getline( is, token, ',' ) )
+    {
+        token.erase( 0, token.find_first_not_of( " \t" ) );
+        token.erase( token.find_last_not_of( " \t" ) + 1 );
+        if ( ! token.empty() )
+        {
+            tokens.push_back( token );
+        }
+    }
+
+    return tokens;
+}
+
+/*-------------------------------------------------------------------*/
+std::string
+json_string( const std::string & str )
+{
+    std::string result( 1, '"' );
+    for ( const char c : str )
+    {
+        switch ( c ) {
+        case '"': result += "\\\""; break;
+        case '\\': result += "\\\\"; break;
+        case '\n': result += "\\n"; break;
+        case '\t': result += "\\t"; break;
+        default:
+            if ( static_cast< unsigned char >( c ) < 0x20 )
+            {
+                char buf[8];
+                std::snprintf( buf, sizeof( buf ), "\\u%04x", c );
+                result += buf;
+            }
+            else
+            {
+                result += c;
+            }
+            break;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+double
+to_msec( const std::int64_t ns )
+{
+    return ns * 1.0e-6;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+std::int64_t
+elapsed_ns( const std::chrono::steady_clock::time_point & start )
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start ).count();
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RenderBenchmark::RenderBenchmark()
+    : M_debug_log_unum( 0 )
+{
+    M_painters.push_back( std::shared_ptr< PainterInterface >( new FieldPainter() ) );
+    M_painters.push_back( std::shared_ptr< PainterInterface >( new TeamGraphicPainter( M_main_data ) ) );
+
+    std::vector< std::shared_ptr< PainterInterface > > painters;
+    FieldCanvas::create_painters( M_main_data,
+                                  static_cast< int >( Options::instance().paintStyle() ),
+                                  painters );
+    M_painters.insert( M_painters.end(), painters.begin(), painters.end() );
+
+    for ( const OptionSwitch & sw : OPTION_SWITCHES )
+    {
+        M_default_switches.push_back( ( Options::instance().*sw.get_ )() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RenderBenchmark::~RenderBenchmark()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+RenderBenchmark::run()
+{
+    const Options & opt = Options::instance();
+
+    if ( ! BatchRenderer::open_files( M_main_data, M_debug_log_unum ) )
+    {
+        return 1;
+    }
+
+    const StringPool & pool = M_main_data.viewHolder().debugStringPool();
+    if ( pool.stats().lookups_ > 0 )
+    {
+        pool.printStats( std::cerr << "(RenderBenchmark) " ) << std::endl;
+    }
+
+    std::vector< std::size_t > indices = BatchRenderer::parse_cycles( opt.batchCycles(),
+                                                                      M_main_data.viewHolder(),
+                                                                      opt.batchStep() );
+    if ( indices.size() > static_cast< std::size_t >( opt.benchmarkFrames() ) )
+    {
+        indices.resize( opt.benchmarkFrames() );
+    }
+
+    if ( indices.empty() )
+    {
+        std::cerr << "(RenderBenchmark) No cycle to be drawn." << std::endl;
+        return 1;
+    }
+
+    const std::vector< QSize > sizes = parse_sizes( opt.benchmarkSizes() );
+    const std::vector< std::string > presets = split( opt.benchmarkPresets() );
+
+    if ( sizes.empty()
+         || presets.empty() )
+    {
+        std::cerr << "(RenderBenchmark) No canvas size or preset." << std::endl;
+        return 1;
+    }
+
+    for ( const std::string & preset : presets )
+    {
+        if ( ! applyPreset( preset ) )
+        {
+            std::cerr << "(RenderBenchmark) Unknown preset [" << preset << "]" << std::endl;
+            continue;
+        }
+
+        for ( const QSize & size : sizes )
+        {
+            std::cerr << "(RenderBenchmark) preset = " << preset
+                      << " size = " << size.width() << " x " << size.height()
+                      << " frames = " << indices.size() << std::endl;
+            runOnce( preset, size, indices );
+        }
+    }
+
+    applyPreset( "default" );
+
+    if ( opt.benchmarkOutput() == "-" )
+    {
+        print( std::cout );
+        return 0;
+    }
+
+    std::ofstream fout( opt.benchmarkOutput().c_str() );
+    if ( ! fout )
+    {
+        std::cerr << "(RenderBenchmark) Failed to open the output file ["
+                  << opt.benchmarkOutput() << "]" << std::endl;
+        return 1;
+    }
+
+    print( fout );
+    fout.flush();
+
+    if ( ! fout )
+    {
+        std::cerr << "(RenderBenchmark) Failed to write the output file ["
+                  << opt.benchmarkOutput() << "]" << std::endl;
+        return 1;
+    }
+
+    std::cerr << "(RenderBenchmark) saved " << opt.benchmarkOutput() << std::endl;
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  "default" uses the options given by the command line,
+  "plain" disables all optional drawings and "full" enables them.
+*/
+bool
+RenderBenchmark::applyPreset( const std::string & preset )
+{
+    Options & opt = Options::instance();
+
+    const std::size_t n = sizeof( OPTION_SWITCHES ) / sizeof( OPTION_SWITCHES[0] );
+
+    if ( preset == "default" )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            set_switch( opt, OPTION_SWITCHES[i], M_default_switches[i] );
+        }
+        return true;
+    }
+
+    if ( preset == "plain"
+         || preset == "full" )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            set_switch( opt, OPTION_SWITCHES[i], ( preset == "full" ) );
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RenderBenchmark::runOnce( const std::string & preset,
+                          const QSize & size,
+                          const std::vector< std::size_t > & indices )
+{
+    Run result;
+    result.preset_ = preset;
+    result.size_ = size;
+    result.frames_ = indices.size();
+    result.frame_ns_.reserve( indices.size() );
+    result.painters_.push_back( PainterTime( "MainData::update" ) );
+    for ( const std::shared_ptr< PainterInterface > & p : M_painters )
+    {
+        result.painters_.push_back( PainterTime( FieldCanvas::painter_name( *p ) ) );
+    }
+
+    QImage image( size, QImage::Format_RGB32 );
+
+    // warm up the caches of the painters and the font engine
+    {
+        Run dummy = result;
+        drawFrame( indices.front(), image, dummy );
+    }
+
+    for ( const std::size_t index : indices )
+    {
+        drawFrame( index, image, result );
+    }
+
+    M_runs.push_back( result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  same drawing sequence as FieldCanvas::draw()
+*/
+void
+RenderBenchmark::drawFrame( const std::size_t index,
+                            QImage & image,
+                            Run & result )
+{
+    const std::chrono::steady_clock::time_point frame_start = std::chrono::steady_clock::now();
+
+    M_main_data.setViewDataIndex( static_cast< int >( index ) );
+    M_main_data.update( image.width(), image.height() );
+
+    if ( M_debug_log_unum != 0 )
+    {
+        if ( MonitorViewData::ConstPtr view = M_main_data.getCurrentViewData() )
+        {
+            M_main_data.seekDebugLogData( M_debug_log_unum, view->time() );
+        }
+    }
+
+    result.painters_[0].add( elapsed_ns( frame_start ) );
+
+    QPainter painter( &image );
+
+    if ( Options::instance().antiAliasing() )
+    {
+        painter.setRenderHint( QPainter::Antialiasing, true );
+    }
+    painter.setRenderHint( QPainter::TextAntialiasing, false );
+
+    for ( std::size_t i = 0; i < M_painters.size(); ++i )
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        M_painters[i]->draw( painter );
+        result.painters_[i + 1].add( elapsed_ns( start ) );
+    }
+
+    painter.end();
+
+    result.frame_ns_.push_back( elapsed_ns( frame_start ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+RenderBenchmark::print( std::ostream & os ) const
+{
+    const Options & opt = Options::instance();
+
+    os << "{\n"
+#ifdef VERSION
+       << "  \"version\": " << json_string( VERSION ) << ",\n"
+#endif
+       << "  \"qt_version\": " << json_string( qVersion() ) << ",\n"
+       << "  \"game_log\": " << json_string( opt.gameLogFilePath() ) << ",\n"
+       << "  \"draw_data\": " << json_string( opt.drawDataFile() ) << ",\n"
+       << "  \"debug_log_dir\": " << json_string( opt.debugLogDir() ) << ",\n"
+       << "  \"debug_log_player\": " << json_string( opt.batchDebugLogPlayer() ) << ",\n"
+       << "  \"paint_style\": " << static_cast< int >( opt.paintStyle() ) << ",\n"
+       << "  \"runs\": [";
+
+    for ( std::size_t r = 0; r < M_runs.size(); ++r )
+    {
+        const Run & run = M_runs[r];
+
+        std::vector< std::int64_t > sorted = run.frame_ns_;
+        std::sort( sorted.begin(), sorted.end() );
+
+        std::int64_t total_ns = 0;
+        for ( const std::int64_t ns : sorted ) total_ns += ns;
+
+        const std::size_t n = std::max( std::size_t( 1 ), sorted.size() );
+        const std::int64_t median_ns = ( sorted.empty() ? 0 : sorted[sorted.size() / 2] );
+        const std::int64_t p95_ns = ( sorted.empty() ? 0 : sorted[std::min( sorted.size() - 1, sorted.size() * 95 / 100 )] );
+        const std::int64_t max_ns = ( sorted.empty() ? 0 : sorted.back() );
+
+        os << ( r == 0 ? "\n" : ",\n" )
+           << "    {\n"
+           << "      \"preset\": " << json_string( run.preset_ ) << ",\n"
+           << "      \"width\": " << run.size_.width() << ",\n"
+           << "      \"height\": " << run.size_.height() << ",\n"
+           << "      \"frames\": " << run.frames_ << ",\n"
+           << "      \"total_ms\": " << to_msec( total_ns ) << ",\n"
+           << "      \"frame_mean_ms\": " << to_msec( total_ns ) / n << ",\n"
+           << "      \"frame_median_ms\": " << to_msec( median_ns ) << ",\n"
+           << "      \"frame_p95_ms\": " << to_msec( p95_ns ) << ",\n"
+           << "      \"frame_max_ms\": " << to_msec( max_ns ) << ",\n"
+           << "      \"painters\": [";
+
+        for ( std::size_t i = 0; i < run.painters_.size(); ++i )
+        {
+            const PainterTime & p = run.painters_[i];
+            os << ( i == 0 ? "\n" : ",\n" )
+               << "        { \"name\": " << json_string( p.name_ )
+               << ", \"total_ms\": " << to_msec( p.total_ns_ )
+               << ", \"mean_ms\": " << to_msec( p.total_ns_ ) / n
+               << ", \"max_ms\": " << to_msec( p.max_ns_ )
+               << ", \"share\": " << ( total_ns > 0 ? static_cast< double >( p.total_ns_ ) / total_ns : 0.0 )
+               << " }";
+        }
+
+        os << "\n      ]\n"
+           << "    }";
+    }
+
+    os << "\n  ]\n"
+       << "}" << std::endl;
+
+    return os;
+}
@@ -0,0 +1,132 @@
+// -*-c++-*-
+
+/*!
+  \file render_benchmark.h
+  \brief painter benchmark class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_RENDER_BENCHMARK_H
+#define SOCCERWINDOW2_QT_RENDER_BENCHMARK_H
+
+#include "main_data.h"
+
+#include <QSize>
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+class QImage;
+class PainterInterface;
+
+/*!
+  \class RenderBenchmark
+  \brief measures the drawing time of each painter without any window.
+
+  The game log is replayed into an offscreen image for every combination
+  of the canvas sizes and the option presets, and the elapsed time of
+  each painter is written as JSON.
+*/
+class RenderBenchmark {
+private:
+
+    //! timing record of one painter
+    struct PainterTime {
+        std::string name_;
+        std::int64_t total_ns_;
+        std::int64_t max_ns_;
+
+        explicit
+        PainterTime( const std::string & name )
+            : name_( name ),
+              total_ns_( 0 ),
+              max_ns_( 0 )
+          { }
+
+        void add( const std::int64_t ns )
+          {
+              total_ns_ += ns;
+              if ( ns > max_ns_ ) max_ns_ = ns;
+          }
+    };
+
+    //! result of one size and preset combination
+    struct Run {
+        std::string preset_;
+        QSize size_;
+        std::size_t frames_;
+        std::vector< std::int64_t > frame_ns_;
+        std::vector< PainterTime > painters_;
+    };
+
+    MainData M_main_data;
+
+    //! the field painter and the team graphic painter followed by the others in the drawing order
+    std::vector< std::shared_ptr< PainterInterface > > M_painters;
+
+    //! player whose debug log is drawn. 0 means none.
+    int M_debug_log_unum;
+
+    //! the option switches given by the command line, restored by the "default" preset
+    std::vector< bool > M_default_switches;
+
+    std::vector< Run > M_runs;
+
+    // not used
+    RenderBenchmark( const RenderBenchmark & ) = delete;
+    RenderBenchmark & operator=( const RenderBenchmark & ) = delete;
+
+public:
+
+    RenderBenchmark();
+    ~RenderBenchmark();
+
+    /*!
+      \brief load the files given by the options, run all benchmarks and write the result.
+      \return exit status of the application
+     */
+    int run();
+
+private:
+
+    bool applyPreset( const std::string & preset );
+
+    void runOnce( const std::string & preset,
+                  const QSize & size,
+                  const std::vector< std::size_t > & indices );
+
+    void drawFrame( const std::size_t index,
+                    QImage & image,
+                    Run & result );
+
+    std::ostream & print( std::ostream & os ) const;
+};
+
+#endif
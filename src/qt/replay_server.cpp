@@ -0,0 +1,380 @@
+// -*-c++-*-
+
+/*!
+  \file replay_server.cpp
+  \brief built-in game log replay server Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtNetwork>
+#include <QTimer>
+
+#include "replay_server.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+
+namespace {
+
+//! real time length of one simulation step [ms]
+const double STEP_MSEC = 100.0;
+
+//! upper bound of the steps sent in one timer event
+const std::size_t MAX_STEPS_PER_TICK = 1000;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ReplayServer::ReplayServer( QObject * parent,
+                            const std::string & file_path,
+                            const int port,
+                            const double & rate,
+                            const double & loss,
+                            const double & reorder,
+                            const int seed )
+    : QObject( parent ),
+      M_file_path( file_path ),
+      M_port( static_cast< quint16 >( port ) ),
+      M_rate( rate ),
+      M_loss( loss ),
+      M_reorder( reorder ),
+      M_socket( new QUdpSocket( this ) ),
+      M_timer( new QTimer( this ) ),
+      M_step( 0 ),
+      M_random( static_cast< std::mt19937::result_type >( seed ) )
+{
+    M_timer->setInterval( std::max( 1, static_cast< int >( STEP_MSEC / M_rate ) ) );
+#if QT_VERSION >= 0x050000
+    M_timer->setTimerType( Qt::PreciseTimer );
+#endif
+
+    connect( M_timer, SIGNAL( timeout() ),
+             this, SLOT( handleTimer() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ReplayServer::~ReplayServer()
+{
+    if ( M_timer->isActive() )
+    {
+        printStats();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayServer::open()
+{
+    if ( ! M_log.open( M_file_path ) )
+    {
+        std::cerr << __FILE__ << ": (open) no show data in [" << M_file_path << "]" << std::endl;
+        return false;
+    }
+
+    if ( ! M_socket->bind( QHostAddress::LocalHost, M_port ) )
+    {
+        std::cerr << __FILE__ << ": (open) failed to bind the port " << M_port << std::endl;
+        return false;
+    }
+
+    connect( M_socket, SIGNAL( readyRead() ),
+             this, SLOT( handleReceive() ) );
+
+    std::cerr << PACKAGE_NAME << ": replay server [" << M_file_path << "]"
+              << " steps=" << M_log.size()
+              << " port=" << M_port
+              << " rate=" << M_rate
+              << " loss=" << M_loss
+              << " reorder=" << M_reorder
+              << std::endl;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const ReplayLog::Stream *
+ReplayServer::stream( const int version )
+{
+    std::map< int, ReplayLog::Stream >::iterator it = M_streams.find( version );
+    if ( it != M_streams.end() )
+    {
+        return &it->second;
+    }
+
+    ReplayLog::Stream & s = M_streams[version];
+    if ( ! M_log.createStream( version, s ) )
+    {
+        M_streams.erase( version );
+        return static_cast< const ReplayLog::Stream * >( 0 );
+    }
+
+    return &s;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReplayServer::sendStep( const std::size_t step )
+{
+    for ( Client & c : M_clients )
+    {
+        const ReplayLog::Stream * s = stream( c.version_ );
+        if ( ! s
+             || step >= s->steps_.size() )
+        {
+            continue;
+        }
+
+        for ( const std::string & d : s->steps_[step] )
+        {
+            send( c, d );
+        }
+    }
+
+    ++M_stats.steps_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReplayServer::send( Client & client,
+                    const std::string & datagram )
+{
+    std::uniform_real_distribution< double > dst( 0.0, 1.0 );
+
+    if ( M_loss > 0.0
+         && dst( M_random ) < M_loss )
+    {
+        ++M_stats.lost_;
+        return;
+    }
+
+    if ( client.holding_ )
+    {
+        // the held datagram goes after the current one.
+        write( client, datagram );
+        write( client, client.held_ );
+        client.held_.clear();
+        client.holding_ = false;
+        ++M_stats.reordered_;
+        return;
+    }
+
+    if ( M_reorder > 0.0
+         && dst( M_random ) < M_reorder )
+    {
+        client.held_ = datagram;
+        client.holding_ = true;
+        return;
+    }
+
+    write( client, datagram );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReplayServer::write( const Client & client,
+                     const std::string & datagram )
+{
+    // rcssserver sends the text datagrams with the terminating null character.
+    // the legacy monitor client parses the received buffer as a C string.
+    const qint64 size = ( client.version_ >= 3
+                          ? datagram.size() + 1
+                          : datagram.size() );
+
+    if ( M_socket->writeDatagram( datagram.c_str(), size,
+                                  client.addr_, client.port_ ) > 0 )
+    {
+        ++M_stats.sent_;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReplayServer::printStats() const
+{
+    std::cerr << PACKAGE_NAME << ": replay server"
+              << " steps=" << M_stats.steps_
+              << " sent=" << M_stats.sent_
+              << " lost=" << M_stats.lost_
+              << " reordered=" << M_stats.reordered_
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReplayServer::handleReceive()
+{
+    char buf[512];
+
+    while ( M_socket->hasPendingDatagrams() )
+    {
+        QHostAddress addr;
+        quint16 port = 0;
+        const qint64 n = M_socket->readDatagram( buf, sizeof( buf ) - 1, &addr, &port );
+        if ( n <= 0 )
+        {
+            continue;
+        }
+        buf[n] = '\0';
+
+        std::vector< Client >::iterator it = M_clients.begin();
+        for ( ; it != M_clients.end(); ++it )
+        {
+            if ( it->addr_ == addr
+                 && it->port_ == port )
+            {
+                break;
+            }
+        }
+
+        if ( ! std::strncmp( buf, "(dispinit", 9 ) )
+        {
+            if ( it != M_clients.end() )
+            {
+                continue;
+            }
+
+            Client c;
+            c.addr_ = addr;
+            c.port_ = port;
+            c.version_ = 1;
+            c.holding_ = false;
+            std::sscanf( buf, " ( dispinit version %d", &c.version_ );
+
+            const ReplayLog::Stream * s = stream( c.version_ );
+            if ( ! s )
+            {
+                continue;
+            }
+
+            // parameters are not subject to the loss injection.
+            for ( const std::string & d : s->header_ )
+            {
+                write( c, d );
+            }
+
+            // the current playmode and team names for a client joining late.
+            ReplayLog::Datagrams state;
+            if ( M_log.createStateDatagrams( c.version_, M_step, state ) )
+            {
+                for ( const std::string & d : state )
+                {
+                    write( c, d );
+                }
+            }
+
+            M_clients.push_back( c );
+
+            std::cerr << PACKAGE_NAME << ": replay server accepted "
+                      << addr.toString().toStdString() << ":" << port
+                      << " version " << c.version_ << std::endl;
+
+            // the timeline starts when the first client joins.
+            if ( ! M_timer->isActive()
+                 && M_step < M_log.size() )
+            {
+                M_clock.start();
+                M_timer->start();
+            }
+        }
+        else if ( ! std::strncmp( buf, "(dispbye", 8 ) )
+        {
+            if ( it != M_clients.end() )
+            {
+                M_clients.erase( it );
+            }
+        }
+        // other commands are ignored. the replayed game cannot be controlled.
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ReplayServer::handleTimer()
+{
+    const std::size_t target = static_cast< std::size_t >( M_clock.elapsed() * M_rate / STEP_MSEC );
+
+    std::size_t count = 0;
+    while ( M_step < target
+            && M_step < M_log.size()
+            && count < MAX_STEPS_PER_TICK )
+    {
+        sendStep( M_step );
+        ++M_step;
+        ++count;
+    }
+
+    if ( M_step >= M_log.size() )
+    {
+        // flush the datagrams held by the reorder injection.
+        for ( Client & c : M_clients )
+        {
+            if ( c.holding_ )
+            {
+                write( c, c.held_ );
+                c.held_.clear();
+                c.holding_ = false;
+            }
+        }
+
+        M_timer->stop();
+        printStats();
+    }
+}
@@ -0,0 +1,161 @@
+// -*-c++-*-
+
+/*!
+  \file replay_server.h
+  \brief built-in game log replay server Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_REPLAY_SERVER_H
+#define SOCCERWINDOW2_QT_REPLAY_SERVER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHostAddress>
+
+#include "replay_log.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+class QTimer;
+class QUdpSocket;
+
+/*!
+  \class ReplayServer
+  \brief stand-in rcssserver that streams a game log to monitor clients.
+
+  Clients connect by sending "(dispinit [version N])" as they do to rcssserver.
+  All clients share one timeline driven by the elapsed time, so the
+  replay does not drift even if the event loop is busy.
+  Datagrams can be dropped or reordered at random to test the client under
+  lossy network conditions.
+*/
+class ReplayServer
+    : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    //! sending statistics
+    struct Stats {
+        long steps_; //!< number of replayed steps
+        long sent_; //!< number of sent datagrams
+        long lost_; //!< number of dropped datagrams
+        long reordered_; //!< number of swapped datagrams
+
+        Stats()
+            : steps_( 0 ),
+              sent_( 0 ),
+              lost_( 0 ),
+              reordered_( 0 )
+          { }
+    };
+
+private:
+
+    struct Client {
+        QHostAddress addr_;
+        quint16 port_;
+        int version_;
+        std::string held_; //!< datagram delayed by the reorder injection
+        bool holding_;
+    };
+
+    const std::string M_file_path;
+    const quint16 M_port;
+    const double M_rate;
+    const double M_loss;
+    const double M_reorder;
+
+    ReplayLog M_log;
+
+    //! converted datagrams for each protocol version
+    std::map< int, ReplayLog::Stream > M_streams;
+
+    std::vector< Client > M_clients;
+
+    QUdpSocket * M_socket;
+    QTimer * M_timer;
+    QElapsedTimer M_clock;
+
+    std::size_t M_step; //!< next step to be sent
+
+    std::mt19937 M_random;
+
+    Stats M_stats;
+
+    //! not used
+    ReplayServer();
+    ReplayServer( const ReplayServer & );
+    ReplayServer & operator=( const ReplayServer & );
+
+public:
+
+    ReplayServer( QObject * parent,
+                  const std::string & file_path,
+                  const int port,
+                  const double & rate,
+                  const double & loss,
+                  const double & reorder,
+                  const int seed );
+
+    ~ReplayServer();
+
+    /*!
+      \brief load the game log and bind the server port.
+      \return true if the server is ready.
+     */
+    bool open();
+
+    const Stats & stats() const
+      {
+          return M_stats;
+      }
+
+private:
+
+    const ReplayLog::Stream * stream( const int version );
+
+    void sendStep( const std::size_t step );
+    void send( Client & client,
+               const std::string & datagram );
+    void write( const Client & client,
+               const std::string & datagram );
+
+    void printStats() const;
+
+private slots:
+
+    void handleReceive();
+    void handleTimer();
+
+};
+
+#endif
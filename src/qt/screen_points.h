@@ -0,0 +1,128 @@
+// -*-c++-*-
+
+/*!
+  \file screen_points.h
+  \brief screen point conversion and drawing helpers for the painters.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_SCREEN_POINTS_H
+#define SOCCERWINDOW2_QT_SCREEN_POINTS_H
+
+#include "screen_transform.h"
+
+#include <QLineF>
+#include <QPainter>
+#include <QPointF>
+
+#include <type_traits>
+#include <cstddef>
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the field points to the screen points in place.
+  \param transform transform snapshot of the current frame
+  \param points array of the field points
+  \param n the number of points
+
+  QPointF is a pair of qreal. If qreal is double, the array is passed to the
+  vectorized ScreenTransform::map() directly.
+*/
+inline
+void
+map_to_screen( const ScreenTransform & transform,
+               QPointF * points,
+               const std::size_t n )
+{
+    if ( std::is_same< qreal, double >::value
+         && sizeof( QPointF ) == sizeof( double ) * 2 )
+    {
+        transform.map( reinterpret_cast< double * >( points ), n );
+        return;
+    }
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        points[i].setX( transform.screenX( points[i].x() ) );
+        points[i].setY( transform.screenY( points[i].y() ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the field lines to the screen lines in place.
+  \param transform transform snapshot of the current frame
+  \param lines array of the field lines
+  \param n the number of lines
+*/
+inline
+void
+map_to_screen( const ScreenTransform & transform,
+               QLineF * lines,
+               const std::size_t n )
+{
+    if ( std::is_same< qreal, double >::value
+         && sizeof( QLineF ) == sizeof( double ) * 4 )
+    {
+        transform.map( reinterpret_cast< double * >( lines ), n * 2 );
+        return;
+    }
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        lines[i].setLine( transform.screenX( lines[i].x1() ),
+                          transform.screenY( lines[i].y1() ),
+                          transform.screenX( lines[i].x2() ),
+                          transform.screenY( lines[i].y2() ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief draw the shape smaller than a pixel as a point.
+  \param painter painter object
+  \param point the screen point
+
+  The current pen is used if it is visible. Otherwise, the point is filled
+  with the current brush, so the filled shape without outline remains visible.
+*/
+inline
+void
+draw_dot( QPainter & painter,
+          const QPointF & point )
+{
+    if ( painter.pen().style() != Qt::NoPen )
+    {
+        painter.drawPoint( point );
+    }
+    else
+    {
+        painter.fillRect( QRectF( point.x() - 0.5, point.y() - 0.5, 1.0, 1.0 ),
+                          painter.brush() );
+    }
+}
+
+#endif
@@ -0,0 +1,327 @@
+// -*-c++-*-
+
+/*!
+  \file trace_cache.cpp
+  \brief cached trace geometry class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGlobal>
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QtWidgets>
+#else
+#include <QtGui>
+#endif
+
+#include "trace_cache.h"
+
+#include "screen_points.h"
+#include "options.h"
+#include "viewport.h"
+
+#include <algorithm>
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TraceCache::TraceCache( StyleFunc style_func )
+    : M_style_func( style_func ),
+      M_target( BALL ),
+      M_transform( 0.0, 0.0, 0.0, false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TraceCache::clear()
+{
+    M_front.reset();
+    M_points.clear();
+    M_styles.clear();
+    M_run_starts.clear();
+    M_run_bounds.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TraceCache::update( const MonitorViewData::Cont & vc,
+                    const int target )
+{
+    const ScreenTransform transform = Options::instance().screenTransform();
+
+    if ( vc.empty() )
+    {
+        clear();
+        return;
+    }
+
+    if ( M_target != target
+         || M_front != vc.front()
+         || M_points.size() > vc.size()
+         || M_transform != transform )
+    {
+        clear();
+
+        M_target = target;
+        M_front = vc.front();
+        M_transform = transform;
+
+        M_points.reserve( vc.size() );
+        M_styles.reserve( vc.size() );
+    }
+    else if ( ! M_points.empty() )
+    {
+        // the last view data may have been replaced in live mode.
+        if ( M_run_starts.back() == M_styles.size() - 1 )
+        {
+            M_run_starts.pop_back();
+            M_run_bounds.pop_back();
+        }
+        M_points.pop_back();
+        M_styles.pop_back();
+    }
+
+    const std::size_t first = M_points.size();
+    for ( std::size_t i = first; i < vc.size(); ++i )
+    {
+        append( *vc[i] );
+    }
+
+    // the field points are converted at once.
+    map_to_screen( M_transform, M_points.data() + first, M_points.size() - first );
+
+    updateBounds( first );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  The bounds of the last run may be larger than the run if its last point
+  has been replaced. They are used only to skip the invisible runs.
+*/
+void
+TraceCache::updateBounds( const std::size_t first )
+{
+    for ( std::size_t i = first; i < M_points.size(); ++i )
+    {
+        const QPointF & p = M_points[i];
+
+        if ( M_run_bounds.size() < M_run_starts.size()
+             && M_run_starts[M_run_bounds.size()] == i )
+        {
+            // the line to the first point of the run starts from the previous point.
+            const QPointF & prev = M_points[i > 0 ? i - 1 : i];
+            M_run_bounds.push_back( QRectF( QPointF( std::min( prev.x(), p.x() ),
+                                                     std::min( prev.y(), p.y() ) ),
+                                            QPointF( std::max( prev.x(), p.x() ),
+                                                     std::max( prev.y(), p.y() ) ) ) );
+            continue;
+        }
+
+        QRectF & b = M_run_bounds.back();
+        if ( p.x() < b.left() ) b.setLeft( p.x() );
+        if ( b.right() < p.x() ) b.setRight( p.x() );
+        if ( p.y() < b.top() ) b.setTop( p.y() );
+        if ( b.bottom() < p.y() ) b.setBottom( p.y() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TraceCache::append( const MonitorViewData & view )
+{
+    if ( M_target == BALL )
+    {
+        M_points.push_back( QPointF( view.ball().x(), view.ball().y() ) );
+    }
+    else
+    {
+        const rcsc::rcg::PlayerT & p = view.players()[M_target];
+        M_points.push_back( QPointF( p.x(), p.y() ) );
+    }
+
+    const unsigned char style = static_cast< unsigned char >( M_style_func( view.playmode() ) );
+    if ( M_styles.empty()
+         || M_styles.back() != style )
+    {
+        M_run_starts.push_back( M_styles.size() );
+    }
+    M_styles.push_back( style );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+TraceCache::drawLines( QPainter & painter,
+                       const Viewport & viewport,
+                       const std::size_t first,
+                       const std::size_t last,
+                       const QPen & playon_pen,
+                       const QPen & setplay_pen ) const
+{
+    if ( first >= last
+         || last >= M_points.size() )
+    {
+        return 0;
+    }
+
+    std::size_t count = 0;
+
+    QPointF prev = M_points[first];
+    bool prev_is_adjacent = true; // true if prev is the point just before i
+
+    std::size_t i = first + 1;
+    std::vector< std::size_t >::const_iterator next_run = std::upper_bound( M_run_starts.begin(),
+                                                                            M_run_starts.end(),
+                                                                            i );
+    while ( i <= last )
+    {
+        const std::size_t run_end = ( next_run == M_run_starts.end()
+                                      ? M_points.size()
+                                      : *next_run );
+        const std::size_t run_last = std::min( run_end - 1, last );
+
+        switch ( M_styles[i] ) {
+        case SKIP:
+            prev_is_adjacent = false;
+            break;
+        case RESET:
+            prev.setX( M_transform.screenX( 0.0 ) );
+            prev.setY( M_transform.screenY( 0.0 ) );
+            prev_is_adjacent = false;
+            break;
+        default:
+            {
+                const QRectF & b = M_run_bounds[( next_run - M_run_starts.begin() ) - 1];
+                const bool visible = ( viewport.intersectsScreen( b.left(), b.top(), b.right(), b.bottom() )
+                                       || ( ! prev_is_adjacent
+                                            && viewport.intersectsScreen( prev.x(), prev.y(),
+                                                                          M_points[i].x(), M_points[i].y() ) ) );
+                if ( visible )
+                {
+                    painter.setPen( M_styles[i] == PLAYON ? playon_pen : setplay_pen );
+                    if ( prev_is_adjacent )
+                    {
+                        painter.drawPolyline( &M_points[i - 1], static_cast< int >( run_last - i + 2 ) );
+                    }
+                    else
+                    {
+                        painter.drawLine( QLineF( prev, M_points[i] ) );
+                        if ( run_last > i )
+                        {
+                            painter.drawPolyline( &M_points[i], static_cast< int >( run_last - i + 1 ) );
+                        }
+                    }
+                    ++count;
+                }
+                prev = M_points[run_last];
+                prev_is_adjacent = true;
+            }
+            break;
+        }
+
+        i = run_last + 1;
+        ++next_run;
+    }
+
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TraceCache::drawMarkers( QPainter & painter,
+                         const Viewport & viewport,
+                         const std::size_t first,
+                         const std::size_t last,
+                         const QPixmap & playon_marker,
+                         const QPixmap & setplay_marker ) const
+{
+    if ( first >= last
+         || last >= M_points.size() )
+    {
+        return;
+    }
+
+    const QRectF playon_rect( playon_marker.rect() );
+    const QRectF setplay_rect( setplay_marker.rect() );
+
+    QVector< QPainter::PixmapFragment > playon;
+    QVector< QPainter::PixmapFragment > setplay;
+
+    const double half_width = std::max( playon_rect.width(), setplay_rect.width() ) * 0.5;
+    const double half_height = std::max( playon_rect.height(), setplay_rect.height() ) * 0.5;
+
+    for ( std::size_t i = first + 1; i <= last; ++i )
+    {
+        const QPointF & p = M_points[i];
+        if ( ! viewport.intersectsScreen( p.x() - half_width, p.y() - half_height,
+                                          p.x() + half_width, p.y() + half_height ) )
+        {
+            continue;
+        }
+
+        switch ( M_styles[i] ) {
+        case PLAYON:
+            playon.push_back( QPainter::PixmapFragment::create( M_points[i], playon_rect ) );
+            break;
+        case SETPLAY:
+            setplay.push_back( QPainter::PixmapFragment::create( M_points[i], setplay_rect ) );
+            break;
+        default:
+            break;
+        }
+    }
+
+    if ( ! playon.isEmpty() )
+    {
+        painter.drawPixmapFragments( playon.constData(), playon.size(), playon_marker );
+    }
+
+    if ( ! setplay.isEmpty() )
+    {
+        painter.drawPixmapFragments( setplay.constData(), setplay.size(), setplay_marker );
+    }
+}
@@ -0,0 +1,137 @@
+// -*-c++-*-
+
+/*!
+  \file trace_cache.h
+  \brief cached trace geometry class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_TRACE_CACHE_H
+#define SOCCERWINDOW2_QT_TRACE_CACHE_H
+
+#include <QPointF>
+#include <QRectF>
+
+#include "monitor_view_data.h"
+#include "screen_transform.h"
+
+#include <vector>
+#include <cstddef>
+
+class QPainter;
+class QPen;
+class QPixmap;
+class Viewport;
+
+/*!
+  \class TraceCache
+  \brief screen positions of one object in all view data, split into runs by the playmode.
+
+  The positions are converted only when the view data are appended or
+  the field scale, the field center or the reverse mode is changed.
+  A trace of any range is drawn with one polyline per playmode run.
+  The runs and the markers outside the viewport are skipped.
+*/
+class TraceCache {
+public:
+
+    //! how the segment that ends at the view data is drawn
+    enum Style {
+        SKIP, //!< not drawn. the previous point is kept.
+        RESET, //!< not drawn. the previous point is moved to the field center.
+        PLAYON, //!< drawn with the play on pen
+        SETPLAY, //!< drawn with the set play pen
+    };
+
+    typedef Style ( *StyleFunc )( const rcsc::PlayMode pmode );
+
+    //! target index for the ball
+    static constexpr int BALL = -1;
+
+private:
+
+    StyleFunc M_style_func;
+
+    //! the object. BALL or the player index.
+    int M_target;
+
+    //! the first view data when the cache was built. used to detect the data replacement.
+    MonitorViewData::ConstPtr M_front;
+
+    //! the transform used to convert M_points
+    ScreenTransform M_transform;
+
+    std::vector< QPointF > M_points; //!< screen point of each view data
+    std::vector< unsigned char > M_styles; //!< Style of each view data
+    std::vector< std::size_t > M_run_starts; //!< the first index of each run of the same style
+    std::vector< QRectF > M_run_bounds; //!< screen bounds of each run including the point before it
+
+    // not used
+    TraceCache( const TraceCache & ) = delete;
+    TraceCache & operator=( const TraceCache & ) = delete;
+
+public:
+
+    explicit
+    TraceCache( StyleFunc style_func );
+
+    /*!
+      \brief rebuild or extend the cache for the current view data and options.
+      \param vc view data container
+      \param target BALL or the player index
+     */
+    void update( const MonitorViewData::Cont & vc,
+                 const int target );
+
+    /*!
+      \brief draw the trace lines in [first, last].
+      \return the number of drawn runs.
+     */
+    std::size_t drawLines( QPainter & painter,
+                           const Viewport & viewport,
+                           const std::size_t first,
+                           const std::size_t last,
+                           const QPen & playon_pen,
+                           const QPen & setplay_pen ) const;
+
+    /*!
+      \brief draw the marker at each point of the drawn segments in [first, last].
+     */
+    void drawMarkers( QPainter & painter,
+                      const Viewport & viewport,
+                      const std::size_t first,
+                      const std::size_t last,
+                      const QPixmap & playon_marker,
+                      const QPixmap & setplay_marker ) const;
+
+private:
+
+    void clear();
+    void append( const MonitorViewData & view );
+    void updateBounds( const std::size_t first );
+};
+
+#endif
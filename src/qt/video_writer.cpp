@@ -0,0 +1,522 @@
+// -*-c++-*-
+
+/*!
+  \file video_writer.cpp
+  \brief video stream writer classes Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QtGlobal>
+#include <QBuffer>
+#include <QImage>
+
+#include "video_writer.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+//! AVI 1.0 files larger than this are not read by many players.
+const qint64 AVI_SIZE_LIMIT = Q_INT64_C( 0x7FFFFFFF );
+
+const quint32 AVIF_HASINDEX = 0x00000010;
+const quint32 AVIIF_KEYFRAME = 0x00000010;
+
+const int JPEG_QUALITY = 90;
+
+void
+put_u16( QByteArray & buf,
+         const quint16 val )
+{
+    buf.append( static_cast< char >( val & 0xff ) );
+    buf.append( static_cast< char >( ( val >> 8 ) & 0xff ) );
+}
+
+void
+put_u32( QByteArray & buf,
+         const quint32 val )
+{
+    put_u16( buf, static_cast< quint16 >( val & 0xffff ) );
+    put_u16( buf, static_cast< quint16 >( ( val >> 16 ) & 0xffff ) );
+}
+
+void
+put_fourcc( QByteArray & buf,
+            const char * fourcc )
+{
+    buf.append( fourcc, 4 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief overwrite a 32 bit little endian value at the file position.
+*/
+bool
+patch_u32( QFile & file,
+           const qint64 pos,
+           const quint32 val )
+{
+    QByteArray buf;
+    put_u32( buf, val );
+    return ( file.seek( pos )
+             && file.write( buf ) == buf.size() );
+}
+
+inline
+unsigned char
+clamp_byte( const int val )
+{
+    return static_cast< unsigned char >( val < 0 ? 0 : val > 255 ? 255 : val );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+VideoWriter::VideoWriter()
+    : M_fps( 10 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+VideoWriter::~VideoWriter()
+{
+    if ( M_file.isOpen() )
+    {
+        M_file.close();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::unique_ptr< VideoWriter >
+VideoWriter::create( const QString & format )
+{
+    const QString fmt = format.toLower();
+
+    if ( fmt == "y4m" )
+    {
+        return std::unique_ptr< VideoWriter >( new Y4MWriter() );
+    }
+
+    if ( fmt == "avi" )
+    {
+        return std::unique_ptr< VideoWriter >( new MJPEGAVIWriter() );
+    }
+
+    return std::unique_ptr< VideoWriter >();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+VideoWriter::is_video_format( const QString & format )
+{
+    const QString fmt = format.toLower();
+    return ( fmt == "y4m"
+             || fmt == "avi" );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+VideoWriter::open( const QString & file_path,
+                   const QSize & size,
+                   const int fps )
+{
+    M_size = adjustSize( size );
+    M_fps = std::max( 1, fps );
+
+    bool opened = false;
+    if ( file_path == "-"
+         && acceptStdout() )
+    {
+        opened = M_file.open( 1, QIODevice::WriteOnly | QIODevice::Unbuffered );
+    }
+    else
+    {
+        M_file.setFileName( file_path );
+        opened = M_file.open( QIODevice::WriteOnly | QIODevice::Truncate );
+    }
+
+    if ( ! opened )
+    {
+        std::cerr << __FILE__ << ": (open) Failed to open the video output ["
+                  << file_path.toStdString() << "] "
+                  << M_file.errorString().toStdString()
+                  << std::endl;
+        return false;
+    }
+
+    return writeHeader();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+VideoWriter::close()
+{
+    if ( ! M_file.isOpen() )
+    {
+        return false;
+    }
+
+    const bool result = M_file.flush();
+    M_file.close();
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  4:2:0 chroma subsampling requires even dimensions.
+*/
+QSize
+Y4MWriter::adjustSize( const QSize & size ) const
+{
+    return QSize( size.width() & ~1, size.height() & ~1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Y4MWriter::writeHeader()
+{
+    const QByteArray header = QString( "YUV4MPEG2 W%1 H%2 F%3:1 Ip A1:1 C420jpeg\n" )
+        .arg( M_size.width() )
+        .arg( M_size.height() )
+        .arg( M_fps )
+        .toLatin1();
+
+    return M_file.write( header ) == header.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  full range BT.601 conversion, as specified by C420jpeg.
+*/
+QByteArray
+Y4MWriter::encode( const QImage & image ) const
+{
+    const QImage rgb = ( image.size() == M_size
+                         ? image
+                         : image.copy( 0, 0, M_size.width(), M_size.height() ) )
+        .convertToFormat( QImage::Format_RGB32 );
+
+    const int width = M_size.width();
+    const int height = M_size.height();
+    const int chroma_width = width / 2;
+    const int chroma_height = height / 2;
+
+    static const char frame_header[] = "FRAME\n";
+    const int header_size = static_cast< int >( sizeof( frame_header ) ) - 1;
+
+    QByteArray frame( header_size + width * height + 2 * chroma_width * chroma_height,
+                      Qt::Uninitialized );
+    std::copy( frame_header, frame_header + header_size, frame.data() );
+
+    unsigned char * y_plane = reinterpret_cast< unsigned char * >( frame.data() + header_size );
+    unsigned char * u_plane = y_plane + width * height;
+    unsigned char * v_plane = u_plane + chroma_width * chroma_height;
+
+    for ( int y = 0; y < height; ++y )
+    {
+        const QRgb * line = reinterpret_cast< const QRgb * >( rgb.constScanLine( y ) );
+        unsigned char * dst = y_plane + y * width;
+        for ( int x = 0; x < width; ++x )
+        {
+            const int r = qRed( line[x] );
+            const int g = qGreen( line[x] );
+            const int b = qBlue( line[x] );
+            dst[x] = clamp_byte( ( 77 * r + 150 * g + 29 * b + 128 ) >> 8 );
+        }
+    }
+
+    for ( int cy = 0; cy < chroma_height; ++cy )
+    {
+        const QRgb * line0 = reinterpret_cast< const QRgb * >( rgb.constScanLine( cy * 2 ) );
+        const QRgb * line1 = reinterpret_cast< const QRgb * >( rgb.constScanLine( cy * 2 + 1 ) );
+        for ( int cx = 0; cx < chroma_width; ++cx )
+        {
+            const QRgb p[4] = { line0[cx * 2], line0[cx * 2 + 1],
+                                line1[cx * 2], line1[cx * 2 + 1] };
+            const int r = ( qRed( p[0] ) + qRed( p[1] ) + qRed( p[2] ) + qRed( p[3] ) + 2 ) / 4;
+            const int g = ( qGreen( p[0] ) + qGreen( p[1] ) + qGreen( p[2] ) + qGreen( p[3] ) + 2 ) / 4;
+            const int b = ( qBlue( p[0] ) + qBlue( p[1] ) + qBlue( p[2] ) + qBlue( p[3] ) + 2 ) / 4;
+
+            u_plane[cy * chroma_width + cx] = clamp_byte( ( ( -43 * r - 85 * g + 128 * b + 128 ) >> 8 ) + 128 );
+            v_plane[cy * chroma_width + cx] = clamp_byte( ( ( 128 * r - 107 * g - 21 * b + 128 ) >> 8 ) + 128 );
+        }
+    }
+
+    return frame;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Y4MWriter::write( const QByteArray & frame )
+{
+    return M_file.write( frame ) == frame.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MJPEGAVIWriter::MJPEGAVIWriter()
+    : VideoWriter(),
+      M_riff_size_pos( 0 ),
+      M_total_frames_pos( 0 ),
+      M_stream_length_pos( 0 ),
+      M_movi_size_pos( 0 ),
+      M_max_frame_size_pos( 0 ),
+      M_max_frame_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  RIFF 'AVI '
+    LIST 'hdrl'
+      'avih'
+      LIST 'strl'
+        'strh'
+        'strf'
+    LIST 'movi'
+      '00dc' ...
+    'idx1'
+*/
+bool
+MJPEGAVIWriter::writeHeader()
+{
+    const quint32 width = static_cast< quint32 >( M_size.width() );
+    const quint32 height = static_cast< quint32 >( M_size.height() );
+
+    M_index.clear();
+    M_max_frame_size = 0;
+
+    QByteArray buf;
+
+    put_fourcc( buf, "RIFF" );
+    M_riff_size_pos = buf.size();
+    put_u32( buf, 0 ); // patched by close()
+    put_fourcc( buf, "AVI " );
+
+    put_fourcc( buf, "LIST" );
+    put_u32( buf, 4 + ( 8 + 56 ) + ( 8 + 4 + ( 8 + 56 ) + ( 8 + 40 ) ) );
+    put_fourcc( buf, "hdrl" );
+
+    // main header
+    put_fourcc( buf, "avih" );
+    put_u32( buf, 56 );
+    put_u32( buf, 1000000 / M_fps ); // micro sec per frame
+    put_u32( buf, 0 ); // max bytes per sec
+    put_u32( buf, 0 ); // padding granularity
+    put_u32( buf, AVIF_HASINDEX );
+    M_total_frames_pos = buf.size();
+    put_u32( buf, 0 ); // total frames. patched by close()
+    put_u32( buf, 0 ); // initial frames
+    put_u32( buf, 1 ); // streams
+    M_max_frame_size_pos = buf.size();
+    put_u32( buf, 0 ); // suggested buffer size. patched by close()
+    put_u32( buf, width );
+    put_u32( buf, height );
+    for ( int i = 0; i < 4; ++i ) put_u32( buf, 0 ); // reserved
+
+    put_fourcc( buf, "LIST" );
+    put_u32( buf, 4 + ( 8 + 56 ) + ( 8 + 40 ) );
+    put_fourcc( buf, "strl" );
+
+    // stream header
+    put_fourcc( buf, "strh" );
+    put_u32( buf, 56 );
+    put_fourcc( buf, "vids" );
+    put_fourcc( buf, "MJPG" );
+    put_u32( buf, 0 ); // flags
+    put_u16( buf, 0 ); // priority
+    put_u16( buf, 0 ); // language
+    put_u32( buf, 0 ); // initial frames
+    put_u32( buf, 1 ); // scale
+    put_u32( buf, static_cast< quint32 >( M_fps ) ); // rate
+    put_u32( buf, 0 ); // start
+    M_stream_length_pos = buf.size();
+    put_u32( buf, 0 ); // length. patched by close()
+    put_u32( buf, 0 ); // suggested buffer size
+    put_u32( buf, 0xffffffff ); // quality
+    put_u32( buf, 0 ); // sample size
+    put_u16( buf, 0 ); // frame rect
+    put_u16( buf, 0 );
+    put_u16( buf, static_cast< quint16 >( width ) );
+    put_u16( buf, static_cast< quint16 >( height ) );
+
+    // stream format (BITMAPINFOHEADER)
+    put_fourcc( buf, "strf" );
+    put_u32( buf, 40 );
+    put_u32( buf, 40 );
+    put_u32( buf, width );
+    put_u32( buf, height );
+    put_u16( buf, 1 ); // planes
+    put_u16( buf, 24 ); // bit count
+    put_fourcc( buf, "MJPG" );
+    put_u32( buf, width * height * 3 );
+    put_u32( buf, 0 );
+    put_u32( buf, 0 );
+    put_u32( buf, 0 );
+    put_u32( buf, 0 );
+
+    put_fourcc( buf, "LIST" );
+    M_movi_size_pos = buf.size();
+    put_u32( buf, 0 ); // patched by close()
+    put_fourcc( buf, "movi" );
+
+    return M_file.write( buf ) == buf.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+QByteArray
+MJPEGAVIWriter::encode( const QImage & image ) const
+{
+    QByteArray data;
+    QBuffer buffer( &data );
+    buffer.open( QIODevice::WriteOnly );
+
+    if ( ! image.save( &buffer, "JPG", JPEG_QUALITY ) )
+    {
+        return QByteArray();
+    }
+
+    return data;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MJPEGAVIWriter::write( const QByteArray & frame )
+{
+    if ( frame.isEmpty() )
+    {
+        std::cerr << __FILE__ << ": (write) Failed to encode the frame." << std::endl;
+        return false;
+    }
+
+    const quint32 size = static_cast< quint32 >( frame.size() );
+    const qint64 chunk_pos = M_file.pos();
+
+    if ( chunk_pos + 8 + size + 1 + 16 * ( M_index.size() + 1 ) > AVI_SIZE_LIMIT )
+    {
+        std::cerr << __FILE__ << ": (write) The AVI file exceeds the size limit." << std::endl;
+        return false;
+    }
+
+    QByteArray buf;
+    put_fourcc( buf, "00dc" );
+    put_u32( buf, size );
+    buf.append( frame );
+    if ( size % 2 != 0 )
+    {
+        buf.append( '\0' ); // chunks are word aligned
+    }
+
+    if ( M_file.write( buf ) != buf.size() )
+    {
+        return false;
+    }
+
+    // the index offset is relative to the 'movi' fourcc.
+    M_index.push_back( std::make_pair( static_cast< quint32 >( chunk_pos - ( M_movi_size_pos + 4 ) ),
+                                       size ) );
+    M_max_frame_size = std::max( M_max_frame_size, size );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+MJPEGAVIWriter::close()
+{
+    if ( ! M_file.isOpen() )
+    {
+        return false;
+    }
+
+    const qint64 movi_end = M_file.pos();
+
+    QByteArray buf;
+    put_fourcc( buf, "idx1" );
+    put_u32( buf, static_cast< quint32 >( M_index.size() * 16 ) );
+    for ( const std::pair< quint32, quint32 > & i : M_index )
+    {
+        put_fourcc( buf, "00dc" );
+        put_u32( buf, AVIIF_KEYFRAME );
+        put_u32( buf, i.first );
+        put_u32( buf, i.second );
+    }
+
+    bool result = ( M_file.write( buf ) == buf.size() );
+
+    const qint64 file_end = M_file.pos();
+    const quint32 frames = static_cast< quint32 >( M_index.size() );
+
+    result = result
+        && patch_u32( M_file, M_riff_size_pos, static_cast< quint32 >( file_end - 8 ) )
+        && patch_u32( M_file, M_total_frames_pos, frames )
+        && patch_u32( M_file, M_max_frame_size_pos, M_max_frame_size )
+        && patch_u32( M_file, M_stream_length_pos, frames )
+        && patch_u32( M_file, M_movi_size_pos, static_cast< quint32 >( movi_end - M_movi_size_pos - 4 ) );
+
+    return VideoWriter::close() && result;
+}
@@ -0,0 +1,196 @@
+// -*-c++-*-
+
+/*!
+  \file video_writer.h
+  \brief video stream writer classes Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_VIDEO_WRITER_H
+#define SOCCERWINDOW2_QT_VIDEO_WRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QSize>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+class QImage;
+
+/*!
+  \class VideoWriter
+  \brief abstract video stream writer.
+
+  encode() is thread safe and is called from the encoder threads.
+  open(), write() and close() must be called from one thread in frame order.
+*/
+class VideoWriter {
+protected:
+
+    QFile M_file;
+    QSize M_size;
+    int M_fps;
+
+    VideoWriter();
+
+public:
+
+    virtual
+    ~VideoWriter();
+
+    /*!
+      \brief create the writer for the format name.
+      \param format "y4m" or "avi"
+      \return writer instance. null if the format is not supported.
+     */
+    static
+    std::unique_ptr< VideoWriter > create( const QString & format );
+
+    //! true if the format name is a video format supported by create().
+    static
+    bool is_video_format( const QString & format );
+
+    /*!
+      \brief open the output.
+      \param file_path output file path. "-" means the standard output if supported.
+      \param size frame size
+      \param fps frame rate
+      \return true if the output is opened.
+     */
+    bool open( const QString & file_path,
+               const QSize & size,
+               const int fps );
+
+    /*!
+      \brief convert the rendered image to the frame data. thread safe.
+     */
+    virtual
+    QByteArray encode( const QImage & image ) const = 0;
+
+    /*!
+      \brief append the encoded frame to the stream.
+     */
+    virtual
+    bool write( const QByteArray & frame ) = 0;
+
+    /*!
+      \brief finish the stream and close the output.
+     */
+    virtual
+    bool close();
+
+    const QSize & size() const
+      {
+          return M_size;
+      }
+
+    QString errorString() const
+      {
+          return M_file.errorString();
+      }
+
+protected:
+
+    //! adjust the frame size for the format
+    virtual
+    QSize adjustSize( const QSize & size ) const
+      {
+          return size;
+      }
+
+    virtual
+    bool acceptStdout() const
+      {
+          return false;
+      }
+
+    virtual
+    bool writeHeader() = 0;
+};
+
+/*!
+  \class Y4MWriter
+  \brief YUV4MPEG2 (4:2:0) raw stream writer. can be piped to an external encoder.
+*/
+class Y4MWriter
+    : public VideoWriter {
+public:
+
+    QByteArray encode( const QImage & image ) const override;
+
+    bool write( const QByteArray & frame ) override;
+
+protected:
+
+    QSize adjustSize( const QSize & size ) const override;
+
+    bool acceptStdout() const override
+      {
+          return true;
+      }
+
+    bool writeHeader() override;
+};
+
+/*!
+  \class MJPEGAVIWriter
+  \brief self-contained Motion JPEG AVI file writer.
+
+  The chunk sizes and the index are written by close(),
+  so the output must be a seekable file.
+*/
+class MJPEGAVIWriter
+    : public VideoWriter {
+private:
+
+    //! (offset from the movi list, size) of each frame chunk
+    std::vector< std::pair< quint32, quint32 > > M_index;
+
+    qint64 M_riff_size_pos;
+    qint64 M_total_frames_pos;
+    qint64 M_stream_length_pos;
+    qint64 M_movi_size_pos;
+    qint64 M_max_frame_size_pos;
+    quint32 M_max_frame_size;
+
+public:
+
+    MJPEGAVIWriter();
+
+    QByteArray encode( const QImage & image ) const override;
+
+    bool write( const QByteArray & frame ) override;
+
+    bool close() override;
+
+protected:
+
+    bool writeHeader() override;
+};
+
+#endif
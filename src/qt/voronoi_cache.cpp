@@ -0,0 +1,336 @@
+// -*-c++-*-
+
+/*!
+  \file voronoi_cache.cpp
+  \brief Voronoi diagram and Delaunay triangulation cache Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <QRunnable>
+#include <QThread>
+
+#include "voronoi_cache.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/geom/voronoi_diagram.h>
+#include <rcsc/geom/triangulation.h>
+
+#include <algorithm>
+
+/*!
+  \class VoronoiCache::Task
+  \brief computes one result in the worker thread.
+*/
+class VoronoiCache::Task
+    : public QRunnable {
+private:
+    VoronoiCache & M_cache;
+    const Key M_key;
+    const MonitorViewData::ConstPtr M_view;
+    const rcsc::Rect2D M_pitch_rect;
+
+public:
+    Task( VoronoiCache & cache,
+          const Key & key,
+          const MonitorViewData::ConstPtr & view,
+          const rcsc::Rect2D & pitch_rect )
+        : M_cache( cache ),
+          M_key( key ),
+          M_view( view ),
+          M_pitch_rect( pitch_rect )
+      {
+          setAutoDelete( true );
+      }
+
+    void run() override
+      {
+          M_cache.finish( M_key, M_view,
+                          VoronoiCache::compute( *M_view,
+                                                 M_key.target_,
+                                                 M_key.reverse_,
+                                                 M_key.parts_,
+                                                 M_pitch_rect ) );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+VoronoiCache::VoronoiCache( const std::size_t capacity )
+    : M_capacity( std::max( std::size_t( 1 ), capacity ) )
+{
+    // leave one core for the GUI thread
+    M_pool.setMaxThreadCount( std::max( 1, QThread::idealThreadCount() - 1 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+VoronoiCache::~VoronoiCache()
+{
+    M_pool.clear();
+    M_pool.waitForDone();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+rcsc::Rect2D
+VoronoiCache::pitch_rect()
+{
+    const rcsc::ServerParam & SP = rcsc::ServerParam::i();
+    return rcsc::Rect2D( rcsc::Vector2D( - SP.pitchHalfLength(),
+                                         - SP.pitchHalfWidth() ),
+                         rcsc::Size2D( SP.pitchLength(),
+                                       SP.pitchWidth() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+VoronoiCache::ResultPtr
+VoronoiCache::get( const MonitorViewData::ConstPtr & view,
+                   const rcsc::SideID target,
+                   const bool reverse,
+                   const int parts )
+{
+    if ( ! view )
+    {
+        return ResultPtr();
+    }
+
+    const Key key = { view.get(), target, reverse, parts };
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        if ( ResultPtr result = find( key ) )
+        {
+            return result;
+        }
+    }
+
+    ResultPtr result = compute( *view, target, reverse, parts, pitch_rect() );
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+    insert( key, view, result );
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+VoronoiCache::prefetch( const std::vector< MonitorViewData::ConstPtr > & views,
+                        const rcsc::SideID target,
+                        const bool reverse,
+                        const int parts )
+{
+    const rcsc::Rect2D rect = pitch_rect();
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    for ( const MonitorViewData::ConstPtr & view : views )
+    {
+        if ( ! view )
+        {
+            continue;
+        }
+
+        const Key key = { view.get(), target, reverse, parts };
+        if ( M_index.find( key ) != M_index.end()
+             || ! M_pending.insert( key ).second )
+        {
+            continue;
+        }
+
+        M_pool.start( new Task( *this, key, view, rect ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+VoronoiCache::ResultPtr
+VoronoiCache::find( const Key & key )
+{
+    std::map< Key, EntryList::iterator >::iterator it = M_index.find( key );
+    if ( it == M_index.end() )
+    {
+        return ResultPtr();
+    }
+
+    M_entries.splice( M_entries.begin(), M_entries, it->second );
+    return it->second->result_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+VoronoiCache::insert( const Key & key,
+                      const MonitorViewData::ConstPtr & view,
+                      const ResultPtr & result )
+{
+    std::map< Key, EntryList::iterator >::iterator it = M_index.find( key );
+    if ( it != M_index.end() )
+    {
+        it->second->result_ = result;
+        M_entries.splice( M_entries.begin(), M_entries, it->second );
+        return;
+    }
+
+    Entry entry;
+    entry.key_ = key;
+    entry.view_ = view;
+    entry.result_ = result;
+
+    M_entries.push_front( entry );
+    M_index.insert( std::make_pair( key, M_entries.begin() ) );
+
+    while ( M_entries.size() > M_capacity )
+    {
+        M_index.erase( M_entries.back().key_ );
+        M_entries.pop_back();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+VoronoiCache::finish( const Key & key,
+                      const MonitorViewData::ConstPtr & view,
+                      const ResultPtr & result )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    M_pending.erase( key );
+    if ( M_index.find( key ) == M_index.end() )
+    {
+        insert( key, view, result );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+VoronoiCache::ResultPtr
+VoronoiCache::compute( const MonitorViewData & view,
+                       const rcsc::SideID target,
+                       const bool reverse,
+                       const int parts,
+                       const rcsc::Rect2D & pitch_rect )
+{
+    std::shared_ptr< Result > result( new Result() );
+
+    const double reverse_value = ( reverse ? -1.0 : 1.0 );
+
+    std::vector< rcsc::Vector2D > players;
+    players.reserve( 22 );
+
+    for ( const rcsc::rcg::PlayerT & p : view.players() )
+    {
+        if ( target != rcsc::NEUTRAL
+             && p.side() != target )
+        {
+            continue;
+        }
+
+        if ( p.isAlive() )
+        {
+            players.emplace_back( p.x() * reverse_value,
+                                  p.y() * reverse_value );
+        }
+    }
+
+    //
+    // Voronoi diagram clipped by the pitch
+    //
+    if ( parts & VORONOI )
+    {
+        rcsc::VoronoiDiagram voronoi( players );
+        voronoi.setBoundingRect( pitch_rect );
+        voronoi.compute();
+
+        result->voronoi_edges_.reserve( voronoi.resultSegments().size() );
+
+        for ( rcsc::VoronoiDiagram::Segment2DCont::const_reference s : voronoi.resultSegments() )
+        {
+            rcsc::Vector2D pos1, pos2;
+            int n = pitch_rect.intersection( s, &pos1, &pos2 );
+            if ( n == 2 )
+            {
+                result->voronoi_edges_.emplace_back( pos1, pos2 );
+            }
+            else if ( n == 1 )
+            {
+                result->voronoi_edges_.emplace_back( pitch_rect.contains( s.origin() )
+                                                     ? s.origin()
+                                                     : s.terminal(),
+                                                     pos1 );
+            }
+            else if ( pitch_rect.contains( s.origin() ) )
+            {
+                result->voronoi_edges_.push_back( s );
+            }
+        }
+    }
+
+    //
+    // Delaunay triangulation
+    //
+    if ( parts & DELAUNAY )
+    {
+        rcsc::Triangulation triangulation;
+        triangulation.setUseTriangles( false );
+        triangulation.addPoints( players );
+        triangulation.compute();
+
+        const rcsc::Triangulation::PointCont & points = triangulation.points();
+
+        result->delaunay_edges_.reserve( triangulation.edges().size() );
+
+        for ( rcsc::Triangulation::SegmentCont::const_reference e : triangulation.edges() )
+        {
+            result->delaunay_edges_.emplace_back( points[e.first], points[e.second] );
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,189 @@
+// -*-c++-*-
+
+/*!
+  \file voronoi_cache.h
+  \brief Voronoi diagram and Delaunay triangulation cache Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3, or (at your option)
+ any later version.
+
+ This code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this code; see the file COPYING.  If not, write to
+ the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef SOCCERWINDOW2_QT_VORONOI_CACHE_H
+#define SOCCERWINDOW2_QT_VORONOI_CACHE_H
+
+#include "monitor_view_data.h"
+
+#include <QThreadPool>
+
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/segment_2d.h>
+#include <rcsc/types.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
+#include <cstddef>
+
+/*!
+  \class VoronoiCache
+  \brief LRU cache of the Voronoi diagram and the Delaunay triangulation of each view data.
+
+  The result is identified by (view data, target side, reverse flag, parts).
+  Only the requested parts are computed, so showing only one of the Voronoi
+  diagram and the Delaunay triangulation does not pay for the other.
+  The view data instance is used instead of its index, because the index
+  is shifted when the live log is trimmed. The entry holds the view data
+  so that the address is never reused while the entry exists.
+
+  The results of the view data ahead of the playback cursor are computed
+  by the worker threads, so that get() usually returns the cached result
+  while the log is played forward.
+*/
+class VoronoiCache {
+public:
+
+    //! the edges in the field coordinates. the reverse flag is already applied.
+    struct Result {
+        std::vector< rcsc::Segment2D > voronoi_edges_; //!< clipped by the pitch
+        std::vector< rcsc::Segment2D > delaunay_edges_;
+    };
+
+    typedef std::shared_ptr< const Result > ResultPtr;
+
+    //! the parts of the result. combined as a bit mask.
+    enum Part {
+        VORONOI = 1,
+        DELAUNAY = 2,
+    };
+
+private:
+
+    struct Key {
+        const MonitorViewData * view_;
+        rcsc::SideID target_;
+        bool reverse_;
+        int parts_;
+
+        bool operator<( const Key & rhs ) const
+          {
+              return std::tie( view_, target_, reverse_, parts_ )
+                  < std::tie( rhs.view_, rhs.target_, rhs.reverse_, rhs.parts_ );
+          }
+    };
+
+    struct Entry {
+        Key key_;
+        MonitorViewData::ConstPtr view_; //!< keeps the key address valid
+        ResultPtr result_;
+    };
+
+    class Task;
+    friend class Task;
+
+    typedef std::list< Entry > EntryList;
+
+    const std::size_t M_capacity;
+
+    std::mutex M_mutex;
+    EntryList M_entries; //!< most recently used first. guarded by M_mutex
+    std::map< Key, EntryList::iterator > M_index; //!< guarded by M_mutex
+    std::set< Key > M_pending; //!< keys being computed. guarded by M_mutex
+
+    QThreadPool M_pool;
+
+    // not used
+    VoronoiCache( const VoronoiCache & ) = delete;
+    VoronoiCache & operator=( const VoronoiCache & ) = delete;
+
+public:
+
+    /*!
+      \brief create the cache and its worker pool.
+      \param capacity the maximum number of cached results
+     */
+    explicit
+    VoronoiCache( const std::size_t capacity );
+
+    /*!
+      \brief cancel the queued tasks and wait for the running tasks.
+     */
+    ~VoronoiCache();
+
+    /*!
+      \brief get the result for the view data.
+      \return cached result, or the result computed in the caller's thread.
+     */
+    ResultPtr get( const MonitorViewData::ConstPtr & view,
+                   const rcsc::SideID target,
+                   const bool reverse,
+                   const int parts );
+
+    /*!
+      \brief queue the computation of the view data that are not cached yet.
+      \param views view data to be computed in the worker threads
+     */
+    void prefetch( const std::vector< MonitorViewData::ConstPtr > & views,
+                   const rcsc::SideID target,
+                   const bool reverse,
+                   const int parts );
+
+    /*!
+      \brief compute the result. thread safe.
+      \param view view data
+      \param target players of this side are used. NEUTRAL means both sides.
+      \param reverse if true, the positions are reversed.
+      \param parts bit mask of Part to be computed
+      \param pitch_rect the bounding rectangle of the Voronoi diagram
+     */
+    static
+    ResultPtr compute( const MonitorViewData & view,
+                       const rcsc::SideID target,
+                       const bool reverse,
+                       const int parts,
+                       const rcsc::Rect2D & pitch_rect );
+
+private:
+
+    //! find the result and mark it as recently used. M_mutex must be locked.
+    ResultPtr find( const Key & key );
+
+    //! register the result and evict the least recently used one. M_mutex must be locked.
+    void insert( const Key & key,
+                 const MonitorViewData::ConstPtr & view,
+                 const ResultPtr & result );
+
+    //! called by the worker thread
+    void finish( const Key & key,
+                 const MonitorViewData::ConstPtr & view,
+                 const ResultPtr & result );
+
+    static
+    rcsc::Rect2D pitch_rect();
+};
+
+#endif
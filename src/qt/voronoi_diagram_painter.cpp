@@ -51,9 +51,6 @@
 #include <rcsc/common/server_param.h>
 #include <rcsc/geom/line_2d.h>
 #include <rcsc/geom/rect_2d.h>
-#include <rcsc/geom/voronoi_diagram.h>
-#include <rcsc/geom/delaunay_triangulation.h>
-#include <rcsc/geom/triangulation.h>
 #ifndef NO_TIMER
 #include <rcsc/timer.h>
 #endif
@@ -89,6 +86,27 @@ struct VoronoiEdge {
 }
 
 
+namespace {
+
+//! the maximum number of cached frames
+const std::size_t CACHE_SIZE = 1000;
+
+//! the number of frames computed ahead of the current frame
+const std::size_t PREFETCH_SIZE = 50;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+VoronoiDiagramPainter::VoronoiDiagramPainter( const MainData & main_data )
+    : M_main_data( main_data ),
+      M_cache( CACHE_SIZE )
+{
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -98,8 +116,9 @@ VoronoiDiagramPainter::draw( QPainter & painter )
 {
     const Options & opt = Options::instance();
 
-    if ( ! opt.showVoronoiDiagram()
-         && ! opt.showDelaunayTriangulation() )
+    if ( ( ! opt.showVoronoiDiagram()
+           && ! opt.showDelaunayTriangulation() )
+         || ! opt.renderOverlays() )
     {
         return;
     }
@@ -110,41 +129,40 @@ VoronoiDiagramPainter::draw( QPainter & painter )
         return;
     }
 
-    //
-    // create player positions
-    //
-    std::vector< rcsc::Vector2D > players;
-    players.reserve( 22 );
+    // compute only the shown parts
+    const int parts = ( ( opt.showVoronoiDiagram() ? VoronoiCache::VORONOI : 0 )
+                        | ( opt.showDelaunayTriangulation() ? VoronoiCache::DELAUNAY : 0 ) );
 
-    for ( const rcsc::rcg::PlayerT & p : view->players() )
-    {
-        if ( opt.voronoiTarget() != rcsc::NEUTRAL
-             && p.side() != opt.voronoiTarget() )
-        {
-            continue;
-        }
+    VoronoiCache::ResultPtr result = M_cache.get( view,
+                                                  opt.voronoiTarget(),
+                                                  opt.reverseSide(),
+                                                  parts );
 
-        if ( p.isAlive() )
-        {
-            players.emplace_back( p.x() * opt.reverseValue(),
-                                  p.y() * opt.reverseValue() );
-        }
+    // the benchmark measures the computation in the drawing thread
+    // without the worker threads competing with the other painters.
+    if ( ! opt.benchmarkRender() )
+    {
+        prefetch( parts );
     }
 
     //
-    // create and draw voronoi diagram
+    // draw voronoi diagram
     //
     if ( opt.showVoronoiDiagram() )
     {
-        drawVoronoiDiagram( painter, players );
+        painter.setPen( DrawConfig::instance().measurePen() );
+        painter.setBrush( DrawConfig::instance().transparentBrush() );
+        drawEdges( painter, result->voronoi_edges_ );
     }
 
     //
-    // create and draw delaunay triangulation
+    // draw delaunay triangulation
     //
     if ( opt.showDelaunayTriangulation() )
     {
-        drawDelaunayTriangulation( painter, players );
+        painter.setPen( DrawConfig::instance().linePen() );
+        painter.setBrush( DrawConfig::instance().transparentBrush() );
+        drawEdges( painter, result->delaunay_edges_ );
     }
 }
 
@@ -153,79 +171,25 @@ VoronoiDiagramPainter::draw( QPainter & painter )
 
  */
 void
-VoronoiDiagramPainter::drawVoronoiDiagram( QPainter & painter,
-                                           const std::vector< rcsc::Vector2D > & players )
+VoronoiDiagramPainter::prefetch( const int parts )
 {
     const Options & opt = Options::instance();
 
-    const rcsc::Rect2D PITCH_RECT( rcsc::Vector2D( - rcsc::ServerParam::i().pitchHalfLength(),
-                                                   - rcsc::ServerParam::i().pitchHalfWidth() ),
-                                   rcsc::Size2D( rcsc::ServerParam::i().pitchLength(),
-                                                 rcsc::ServerParam::i().pitchWidth() ) );
-    //rcsc::Timer timer;
-    rcsc::VoronoiDiagram voronoi( players );
-    voronoi.setBoundingRect( PITCH_RECT );
-    voronoi.compute();
-    //std::cerr << "voronoi elapsed " << timer.elapsedReal() << " [ms]." << std::endl;
-
-
-    QPainterPath path;
-
-    painter.setPen( DrawConfig::instance().measurePen() );
-    painter.setBrush( DrawConfig::instance().transparentBrush() );
+    std::vector< MonitorViewData::ConstPtr > views;
+    views.reserve( PREFETCH_SIZE );
 
-    for ( rcsc::VoronoiDiagram::Segment2DCont::const_reference s : voronoi.resultSegments() )
+    const std::size_t index = M_main_data.viewIndex();
+    for ( std::size_t i = 1; i <= PREFETCH_SIZE; ++i )
     {
-        rcsc::Vector2D pos1, pos2;
-        int n = PITCH_RECT.intersection( s, &pos1, &pos2 );
-        if ( n == 2 )
-        {
-            path.moveTo( opt.absScreenX( pos1.x ),
-                         opt.absScreenY( pos1.y ) );
-            path.lineTo( opt.absScreenX( pos2.x ),
-                         opt.absScreenY( pos2.y ) );
-        }
-        else if ( n == 1 )
-        {
-            if ( PITCH_RECT.contains( s.origin() ) )
-            {
-                path.moveTo( opt.absScreenX( s.origin().x ),
-                             opt.absScreenY( s.origin().y ) );
-                path.lineTo( opt.absScreenX( pos1.x ),
-                             opt.absScreenY( pos1.y ) );
-            }
-            else
-            {
-                path.moveTo( opt.absScreenX( s.terminal().x ),
-                             opt.absScreenY( s.terminal().y ) );
-                path.lineTo( opt.absScreenX( pos1.x ),
-                             opt.absScreenY( pos1.y ) );
-            }
-        }
-        else if ( PITCH_RECT.contains( s.origin() ) )
+        MonitorViewData::ConstPtr v = M_main_data.getViewData( index + i );
+        if ( ! v )
         {
-            path.moveTo( opt.absScreenX( s.origin().x ),
-                         opt.absScreenY( s.origin().y ) );
-            path.lineTo( opt.absScreenX( s.terminal().x ),
-                         opt.absScreenY( s.terminal().y ) );
+            break;
         }
+        views.push_back( v );
     }
 
-#if 0
-    for ( rcsc::VoronoiDiagram::Ray2DCont::const_reference : r = voronoi.resultRays() )
-    {
-        rcsc::Vector2D pos;
-        if ( PITCH_RECT.intersection( r, &pos, static_cast< rcsc::Vector2D * >( 0 ) ) == 1 )
-        {
-            path.moveTo( opt.absScreenX( r.origin().x ),
-                         opt.absScreenY( r.origin().y ) );
-            path.lineTo( opt.absScreenX( pos.x ),
-                         opt.absScreenY( pos.y ) );
-        }
-    }
-#endif
-    painter.drawPath( path );
-
+    M_cache.prefetch( views, opt.voronoiTarget(), opt.reverseSide(), parts );
 }
 
 /*-------------------------------------------------------------------*/
@@ -233,60 +197,22 @@ VoronoiDiagramPainter::drawVoronoiDiagram( QPainter & painter,
 
  */
 void
-VoronoiDiagramPainter::drawDelaunayTriangulation( QPainter & painter,
-                                                  const std::vector< rcsc::Vector2D > & players )
+VoronoiDiagramPainter::drawEdges( QPainter & painter,
+                                  const std::vector< rcsc::Segment2D > & edges )
 {
     const Options & opt = Options::instance();
 
-#if 0
-    //rcsc::Timer timer;
-    rcsc::DelaunayTriangulation triangulation;
-    triangulation.init( rcsc::Rect2D( rcsc::Vector2D( - rcsc::ServerParam::i().pitchHalfLength(),
-                                                      - rcsc::ServerParam::i().pitchHalfWidth() ),
-                                      rcsc::Size2D( rcsc::ServerParam::i().pitchLength(),
-                                                    rcsc::ServerParam::i().pitchWidth() ) ) );
-    triangulation.addVertices( players );
-    triangulation.compute();
-    //std::cerr << "delaunay elapsed " << timer.elapsedReal() << " [ms]." << std::endl;
-
     QPainterPath path;
 
-    painter.setPen( DrawConfig::instance().linePen() );
-    painter.setBrush( DrawConfig::instance().transparentBrush() );
-
-    for ( rcsc::DelaunayTriangulation::EdgeCont::const_refrence e = triangulation.edges() )
+    for ( const rcsc::Segment2D & s : edges )
     {
-        path.moveTo( opt.absScreenX( e.second->vertex( 0 )->pos().x ),
-                     opt.absScreenY( e.second->vertex( 0 )->pos().y ) );
-        path.lineTo( opt.absScreenX( e.second->vertex( 1 )->pos().x ),
-                     opt.absScreenY( e.second->vertex( 1 )->pos().y ) );
+        path.moveTo( opt.absScreenX( s.origin().x ),
+                     opt.absScreenY( s.origin().y ) );
+        path.lineTo( opt.absScreenX( s.terminal().x ),
+                     opt.absScreenY( s.terminal().y ) );
     }
 
     painter.drawPath( path );
-#else
-    //rcsc::Timer timer;
-    rcsc::Triangulation triangulation;
-    triangulation.setUseTriangles( false );
-    triangulation.addPoints( players );
-    triangulation.compute();
-    //std::cerr << "delaunay elapsed " << timer.elapsedReal() << " [ms]." << std::endl;
-
-    QPainterPath path;
-
-    painter.setPen( DrawConfig::instance().linePen() );
-    painter.setBrush( DrawConfig::instance().transparentBrush() );
-
-    const rcsc::Triangulation::PointCont & points = triangulation.points();
-    for ( rcsc::Triangulation::SegmentCont::const_reference e : triangulation.edges() )
-    {
-        path.moveTo( opt.absScreenX( points[e.first].x ),
-                     opt.absScreenY( points[e.first].y ) );
-        path.lineTo( opt.absScreenX( points[e.second].x ),
-                     opt.absScreenY( points[e.second].y ) );
-    }
-
-    painter.drawPath( path );
-#endif
 }
 
 /*-------------------------------------------------------------------*/
@@ -350,7 +276,7 @@ VoronoiDiagramPainter::drawOld( QPainter & painter )
         return;
     }
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -529,7 +455,7 @@ VoronoiDiagramPainter::drawOld( QPainter & painter )
     }
 
 
-    if ( opt.antiAliasing() )
+    if ( opt.renderAntiAliasing() )
     {
 #ifdef USE_HIGH_QUALITY_ANTIALIASING
         painter.setRenderHints( QPainter::HighQualityAntialiasing |
@@ -33,8 +33,9 @@
 #define SOCCERWINDOW2_QT_VORONOI_DIAGRAM_PAINTER_H
 
 #include "painter_interface.h"
+#include "voronoi_cache.h"
 
-#include <rcsc/geom/vector_2d.h>
+#include <rcsc/geom/segment_2d.h>
 
 class MainData;
 
@@ -44,6 +45,8 @@ private:
 
     const MainData & M_main_data;
 
+    VoronoiCache M_cache;
+
     VoronoiDiagramPainter();
     VoronoiDiagramPainter( const VoronoiDiagramPainter & );
     const VoronoiDiagramPainter & operator=( const VoronoiDiagramPainter & );
@@ -51,19 +54,17 @@ private:
 public:
 
     explicit
-    VoronoiDiagramPainter( const MainData & main_data )
-        : M_main_data( main_data )
-      { }
+    VoronoiDiagramPainter( const MainData & main_data );
 
     void draw( QPainter & painter );
 
 
 private:
 
-    void drawVoronoiDiagram( QPainter & painter,
-                             const std::vector< rcsc::Vector2D > & players );
-    void drawDelaunayTriangulation( QPainter & painter,
-                                    const std::vector< rcsc::Vector2D > & players );
+    void prefetch( const int parts );
+
+    void drawEdges( QPainter & painter,
+                    const std::vector< rcsc::Segment2D > & edges );
 
     void drawOld( QPainter & painter );
 };